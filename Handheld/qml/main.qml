@@ -38,7 +38,7 @@ Handheld {
     signal clearDialogAccepted();
     signal closeDialogAccepted();
     signal inputDialogAccepted(var input, var index);
-    signal markupLayerReceived(var path, var overlayVisible);
+    signal markupLayerReceived(var markupLayer, var overlayVisible);
 
     LocationController {
         id: locationController
@@ -608,10 +608,10 @@ Handheld {
 
     DsaYesNoDialog {
         id: markupDialog
-        property string path
+        property var markupLayer
 
-        onAccepted: markupLayerReceived(path, true);
-        onRejected: markupLayerReceived(path, false);
+        onAccepted: markupLayerReceived(markupLayer, true);
+        onRejected: markupLayerReceived(markupLayer, false);
     }
 
     DsaYesNoDialog {
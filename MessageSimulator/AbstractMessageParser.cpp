@@ -17,6 +17,7 @@
 #include "AbstractMessageParser.h"
 #include "CoTMessageParser.h"
 #include "GeoMessageParser.h"
+#include "ScenarioMessageParser.h"
 #include "SimulatedMessage.h"
 
 #include <QFile>
@@ -34,6 +35,10 @@ AbstractMessageParser::~AbstractMessageParser()
 
 AbstractMessageParser* AbstractMessageParser::createMessageParser(const QString& filePath, QObject* parent)
 {
+  // JSON scenario files generate their messages rather than replaying them
+  if (ScenarioMessageParser::isScenarioFile(filePath))
+    return new ScenarioMessageParser(filePath, parent);
+
   QFile file(filePath);
   if (!file.open(QFile::ReadOnly | QFile::Text))
   {
@@ -62,6 +67,32 @@ AbstractMessageParser* AbstractMessageParser::createMessageParser(const QString&
   return nullptr;
 }
 
+int AbstractMessageParser::messageCount() const
+{
+  // unknown unless the parser indexes its input
+  return -1;
+}
+
+bool AbstractMessageParser::seek(int)
+{
+  return false;
+}
+
+qint64 AbstractMessageParser::messageTime(const QByteArray&) const
+{
+  return -1;
+}
+
+QByteArray AbstractMessageParser::retimeMessage(const QByteArray& message, const QDateTime&) const
+{
+  return message;
+}
+
+void AbstractMessageParser::setSeed(quint32)
+{
+  // recorded messages are the same on every run
+}
+
 QString AbstractMessageParser::filePath() const
 {
   return m_filePath;
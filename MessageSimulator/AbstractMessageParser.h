@@ -19,6 +19,8 @@
 
 #include <QObject>
 
+class QDateTime;
+
 class AbstractMessageParser : public QObject
 {
   Q_OBJECT
@@ -34,6 +36,19 @@ public:
 
   virtual bool atEnd() const = 0;
 
+  virtual int messageCount() const;
+
+  virtual bool seek(int index);
+
+  // the time a message was originally sent in milliseconds since the epoch, or -1 if it has none
+  virtual qint64 messageTime(const QByteArray& message) const;
+
+  // a copy of the message with its time stamps moved to the given time
+  virtual QByteArray retimeMessage(const QByteArray& message, const QDateTime& time) const;
+
+  // makes any generated content depend only on the seed
+  virtual void setSeed(quint32 seed);
+
   QString filePath() const;
 
 signals:
@@ -17,112 +17,167 @@
 #include "CoTMessageParser.h"
 #include "SimulatedMessage.h"
 
-CoTMessageParser::CoTMessageParser(const QString& filePath, QObject* parent) :
-  AbstractMessageParser(filePath, parent)
+#include <QDateTime>
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace
 {
-}
 
-CoTMessageParser::~CoTMessageParser()
+struct AttributeRange
 {
-  // close and clear device
-  reset();
-}
+  int start = -1;
+  int end = -1;
+};
 
-QByteArray CoTMessageParser::nextMessage()
+// finds the value of an attribute of the event element without parsing the message
+AttributeRange findEventAttribute(const QByteArray& message, const QByteArray& name)
 {
-  if (!m_isParsing)
+  const int tagStart = message.indexOf("<event");
+  if (tagStart < 0)
+    return AttributeRange();
+
+  const int tagEnd = message.indexOf('>', tagStart);
+  if (tagEnd < 0)
+    return AttributeRange();
+
+  int position = tagStart;
+  while ((position = message.indexOf(name, position + 1)) >= 0 && position < tagEnd)
   {
-    // if not parsing message file yet,
-    // open the file for read access
-    m_device.setFileName(filePath());
-    if (!m_device.open(QFile::ReadOnly | QFile::Text))
+    const int equals = position + name.size();
+    if (!std::isspace(static_cast<unsigned char>(message.at(position - 1))) || equals + 1 >= tagEnd ||
+        message.at(equals) != '=')
     {
-      emit errorOccurred(tr("Could not open ") + filePath() + tr(" for reading"));
-      return QByteArray();
+      continue;
     }
 
-    m_reader.setDevice(&m_device);
+    const char quote = message.at(equals + 1);
+    if (quote != '"' && quote != '\'')
+      continue;
 
-    m_isParsing = true;
+    AttributeRange range;
+    range.start = equals + 2;
+    range.end = message.indexOf(quote, range.start);
+    return range.end >= 0 && range.end < tagEnd ? range : AttributeRange();
   }
 
+  return AttributeRange();
+}
+
+qint64 parseTime(const QByteArray& message, const AttributeRange& range)
+{
+  if (range.start < 0)
+    return -1;
+
+  const QDateTime time = QDateTime::fromString(QString::fromLatin1(message.constData() + range.start, range.end - range.start),
+                                               Qt::ISODateWithMs);
+  return time.isValid() ? time.toMSecsSinceEpoch() : -1;
+}
+
+} // namespace
+
+CoTMessageParser::CoTMessageParser(const QString& filePath, QObject* parent) :
+  AbstractMessageParser(filePath, parent)
+{
+}
+
+CoTMessageParser::~CoTMessageParser()
+{
+  // unmap and close the file
+  m_file.close();
+}
+
+QByteArray CoTMessageParser::nextMessage()
+{
+  // the file is indexed the first time a message is needed
+  if (!m_fileOpened && !openFile())
+    return QByteArray();
+
   if (atEnd())
   {
     emit errorOccurred(tr("Finished parsing messages to end of file"));
     return QByteArray();
   }
 
-  QByteArray message;
-  QXmlStreamWriter streamWriter(&message);
+  // the message is a slice of the mapped file, so no XML is parsed or written here
+  return m_file.nextMessage();
+}
 
-  bool readingMessage = false;
+void CoTMessageParser::reset()
+{
+  // rewind to the first message. The index is kept so looping does not re-read the file
+  m_file.seek(0);
+}
 
-  // loop through XML stream until reaching the end
-  while (!atEnd())
-  {
-    if (m_reader.isEndElement())
-    {
-      streamWriter.writeEndElement();
-      if (m_reader.name().compare(SimulatedMessage::COT_ELEMENT_NAME, Qt::CaseInsensitive) == 0)
-      {
-        // finished reading single CoT element
-        readingMessage = false;
-        m_reader.readNext();
-        break;
-      }
-    }
-    else if (m_reader.isStartElement())
-    {
-      const QString elementName = m_reader.name().toString();
-
-      if (!readingMessage && elementName.compare(SimulatedMessage::COT_ELEMENT_NAME, Qt::CaseInsensitive) != 0)
-      {
-        // begin reading single CoT element
-        m_reader.readNext();
-        continue;
-      }
-
-      readingMessage = true;
-
-      // write element and attributes to the stream writer
-      if (m_reader.prefix().toString().isEmpty())
-      {
-        streamWriter.writeStartElement(elementName);
-      }
-      else
-      {
-        streamWriter.writeStartElement(m_reader.prefix().toString() + ":" + elementName);
-      }
-
-      if (!m_reader.attributes().isEmpty())
-      {
-        streamWriter.writeAttributes(m_reader.attributes());
-      }
-    }
-    else if (m_reader.isCharacters())
-    {
-      // write element text to the stream writer
-      streamWriter.writeCharacters(m_reader.text().toString());
-    }
+bool CoTMessageParser::atEnd() const
+{
+  return m_fileOpened && m_file.atEnd();
+}
 
-    m_reader.readNext();
-  }
+int CoTMessageParser::messageCount() const
+{
+  return m_fileOpened ? m_file.messageCount() : -1;
+}
+
+bool CoTMessageParser::seek(int index)
+{
+  if (!m_fileOpened && !openFile())
+    return false;
 
-  return message;
+  return m_file.seek(index);
 }
 
-void CoTMessageParser::reset()
+qint64 CoTMessageParser::messageTime(const QByteArray& message) const
 {
-  // close and reset device and parser
-  if (m_device.isOpen())
-    m_device.close();
+  return parseTime(message, findEventAttribute(message, QByteArrayLiteral("time")));
+}
 
-  m_device.setFileName(QString());
-  m_reader.clear();
-  m_isParsing = false;
+QByteArray CoTMessageParser::retimeMessage(const QByteArray& message, const QDateTime& time) const
+{
+  const AttributeRange timeRange = findEventAttribute(message, QByteArrayLiteral("time"));
+  const AttributeRange startRange = findEventAttribute(message, QByteArrayLiteral("start"));
+  const AttributeRange staleRange = findEventAttribute(message, QByteArrayLiteral("stale"));
+
+  const QDateTime utcTime = time.toUTC();
+  const QByteArray now = utcTime.toString(Qt::ISODateWithMs).toLatin1();
+
+  std::vector<std::pair<AttributeRange, QByteArray>> replacements;
+  if (timeRange.start >= 0)
+    replacements.emplace_back(timeRange, now);
+  if (startRange.start >= 0)
+    replacements.emplace_back(startRange, now);
+
+  // the event stays valid for as long after now as it originally did
+  const qint64 originalTime = parseTime(message, timeRange);
+  const qint64 originalStale = parseTime(message, staleRange);
+  if (originalTime >= 0 && originalStale >= 0)
+    replacements.emplace_back(staleRange, utcTime.addMSecs(originalStale - originalTime).toString(Qt::ISODateWithMs).toLatin1());
+
+  // replace from the back so the earlier ranges stay valid
+  std::sort(replacements.begin(), replacements.end(), [](const auto& a, const auto& b)
+  {
+    return a.first.start > b.first.start;
+  });
+
+  QByteArray result(message.constData(), message.size());
+  for (const auto& replacement : replacements)
+    result.replace(replacement.first.start, replacement.first.end - replacement.first.start, replacement.second);
+
+  return result;
 }
 
-bool CoTMessageParser::atEnd() const
+bool CoTMessageParser::openFile()
 {
-  return m_reader.atEnd();
+  m_fileOpened = true;
+
+  // record the byte range of every CoT element in one pass over the file
+  if (!m_file.open(filePath(), SimulatedMessage::COT_ELEMENT_NAME))
+  {
+    emit errorOccurred(tr("Could not open ") + filePath() + tr(" for reading"));
+    return false;
+  }
+
+  return true;
 }
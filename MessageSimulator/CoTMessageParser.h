@@ -18,9 +18,7 @@
 #define COTMESSAGEPARSER_H
 
 #include "AbstractMessageParser.h"
-
-#include <QXmlStreamReader>
-#include <QFile>
+#include "IndexedMessageFile.h"
 
 class CoTMessageParser : public AbstractMessageParser
 {
@@ -36,13 +34,22 @@ public:
 
   bool atEnd() const override;
 
+  int messageCount() const override;
+
+  bool seek(int index) override;
+
+  qint64 messageTime(const QByteArray& message) const override;
+
+  QByteArray retimeMessage(const QByteArray& message, const QDateTime& time) const override;
+
 private:
   Q_DISABLE_COPY(CoTMessageParser)
   CoTMessageParser() = delete;
 
-  QFile m_device;
-  QXmlStreamReader m_reader;
-  bool m_isParsing = false;
+  bool openFile();
+
+  IndexedMessageFile m_file;
+  bool m_fileOpened = false;
 };
 
 #endif // COTMESSAGEPARSER_H
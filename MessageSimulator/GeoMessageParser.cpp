@@ -24,27 +24,15 @@ GeoMessageParser::GeoMessageParser(const QString& filePath, QObject* parent) :
 
 GeoMessageParser::~GeoMessageParser()
 {
-  // close and clear device
-  reset();
+  // unmap and close the file
+  m_file.close();
 }
 
 QByteArray GeoMessageParser::nextMessage()
 {
-  if (!m_isParsing)
-  {
-    // if not parsing message file yet,
-    // open the file for read access
-    m_device.setFileName(filePath());
-    if (!m_device.open(QFile::ReadOnly | QFile::Text))
-    {
-      emit errorOccurred(tr("Could not open ") + filePath() + tr(" for reading"));
-      return QByteArray();
-    }
-
-    m_reader.setDevice(&m_device);
-
-    m_isParsing = true;
-  }
+  // the file is indexed the first time a message is needed
+  if (!m_fileOpened && !openFile())
+    return QByteArray();
 
   if (atEnd())
   {
@@ -52,77 +40,44 @@ QByteArray GeoMessageParser::nextMessage()
     return QByteArray();
   }
 
-  QByteArray message;
-  QXmlStreamWriter streamWriter(&message);
-
-  bool readingMessage = false;
-
-  // loop through XML stream until reaching the end
-  while (!atEnd())
-  {
-    if (m_reader.isEndElement())
-    {
-      streamWriter.writeEndElement();
-      if (m_reader.name().compare(SimulatedMessage::GEOMESSAGE_ELEMENT_NAME, Qt::CaseInsensitive) == 0)
-      {
-        // finished reading single GeoMessage element
-        readingMessage = false;
-        m_reader.readNext();
-        break;
-      }
-    }
-    else if (m_reader.isStartElement())
-    {
-      const QString elementName = m_reader.name().toString();
-
-      if (!readingMessage && elementName.compare(SimulatedMessage::GEOMESSAGE_ELEMENT_NAME, Qt::CaseInsensitive) != 0)
-      {
-        // begin reading single GeoMessage element
-        m_reader.readNext();
-        continue;
-      }
-
-      readingMessage = true;
-
-      // write element and attributes to the stream writer
-      if (m_reader.prefix().toString().isEmpty())
-      {
-        streamWriter.writeStartElement(elementName);
-      }
-      else
-      {
-        streamWriter.writeStartElement(m_reader.prefix().toString() + ":" + elementName);
-      }
+  // the message is a slice of the mapped file, so no XML is parsed or written here
+  return m_file.nextMessage();
+}
 
-      if (!m_reader.attributes().isEmpty())
-      {
-        streamWriter.writeAttributes(m_reader.attributes());
-      }
-    }
-    else if (m_reader.isCharacters())
-    {
-      // write element text to the stream writer
-      streamWriter.writeCharacters(m_reader.text().toString());
-    }
+void GeoMessageParser::reset()
+{
+  // rewind to the first message. The index is kept so looping does not re-read the file
+  m_file.seek(0);
+}
 
-    m_reader.readNext();
-  }
+bool GeoMessageParser::atEnd() const
+{
+  return m_fileOpened && m_file.atEnd();
+}
 
-  return message;
+int GeoMessageParser::messageCount() const
+{
+  return m_fileOpened ? m_file.messageCount() : -1;
 }
 
-void GeoMessageParser::reset()
+bool GeoMessageParser::seek(int index)
 {
-  // close and reset device and parser
-  if (m_device.isOpen())
-    m_device.close();
+  if (!m_fileOpened && !openFile())
+    return false;
 
-  m_device.setFileName(QString());
-  m_reader.clear();
-  m_isParsing = false;
+  return m_file.seek(index);
 }
 
-bool GeoMessageParser::atEnd() const
+bool GeoMessageParser::openFile()
 {
-  return m_reader.atEnd();
+  m_fileOpened = true;
+
+  // record the byte range of every GeoMessage element in one pass over the file
+  if (!m_file.open(filePath(), SimulatedMessage::GEOMESSAGE_ELEMENT_NAME))
+  {
+    emit errorOccurred(tr("Could not open ") + filePath() + tr(" for reading"));
+    return false;
+  }
+
+  return true;
 }
@@ -18,9 +18,7 @@
 #define GEOMESSAGEPARSER_H
 
 #include "AbstractMessageParser.h"
-
-#include <QFile>
-#include <QXmlStreamReader>
+#include "IndexedMessageFile.h"
 
 class GeoMessageParser : public AbstractMessageParser
 {
@@ -36,13 +34,18 @@ public:
 
   bool atEnd() const override;
 
+  int messageCount() const override;
+
+  bool seek(int index) override;
+
 private:
   Q_DISABLE_COPY(GeoMessageParser)
   GeoMessageParser() = delete;
 
-  QFile m_device;
-  QXmlStreamReader m_reader;
-  bool m_isParsing = false;
+  bool openFile();
+
+  IndexedMessageFile m_file;
+  bool m_fileOpened = false;
 };
 
 #endif // GEOMESSAGEPARSER_H
@@ -0,0 +1,263 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "IndexedMessageFile.h"
+
+#include <string_view>
+
+namespace
+{
+
+constexpr std::string_view::size_type c_notFound = std::string_view::npos;
+
+// returns the position of the '>' closing the tag which starts at from, ignoring any in quoted attribute values
+std::string_view::size_type tagEnd(std::string_view data, std::string_view::size_type from)
+{
+  char quote = 0;
+  for (auto i = from; i < data.size(); ++i)
+  {
+    const char c = data[i];
+    if (quote)
+    {
+      if (c == quote)
+        quote = 0;
+    }
+    else if (c == '"' || c == '\'')
+    {
+      quote = c;
+    }
+    else if (c == '>')
+    {
+      return i;
+    }
+  }
+
+  return c_notFound;
+}
+
+// returns the local name (without any namespace prefix) of the tag whose name starts at from
+std::string_view localName(std::string_view data, std::string_view::size_type from, std::string_view::size_type end)
+{
+  auto nameEnd = from;
+  while (nameEnd < end)
+  {
+    const char c = data[nameEnd];
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '/' || c == '>')
+      break;
+    ++nameEnd;
+  }
+
+  std::string_view name = data.substr(from, nameEnd - from);
+  const auto prefixEnd = name.rfind(':');
+  return prefixEnd == c_notFound ? name : name.substr(prefixEnd + 1);
+}
+
+bool matchesElement(std::string_view name, const QByteArray& elementName)
+{
+  return name.size() == static_cast<std::string_view::size_type>(elementName.size()) &&
+         qstrnicmp(name.data(), elementName.constData(), elementName.size()) == 0;
+}
+
+} // namespace
+
+IndexedMessageFile::IndexedMessageFile()
+{
+}
+
+IndexedMessageFile::~IndexedMessageFile()
+{
+  close();
+}
+
+bool IndexedMessageFile::open(const QString& filePath, const QString& messageElementName)
+{
+  close();
+
+  m_file.setFileName(filePath);
+  if (!m_file.open(QFile::ReadOnly))
+    return false;
+
+  m_size = m_file.size();
+  if (m_size > 0)
+  {
+    // map the whole file so that messages can be sent straight from the page cache
+    m_data = reinterpret_cast<const char*>(m_file.map(0, m_size));
+    if (!m_data)
+    {
+      // fall back to reading the file if it cannot be mapped
+      m_buffer = m_file.readAll();
+      m_data = m_buffer.constData();
+      m_size = m_buffer.size();
+    }
+  }
+
+  m_isOpen = true;
+  buildIndex(messageElementName.toUtf8());
+
+  return true;
+}
+
+void IndexedMessageFile::close()
+{
+  if (m_data && m_buffer.isEmpty())
+    m_file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_data)));
+
+  if (m_file.isOpen())
+    m_file.close();
+
+  m_buffer.clear();
+  m_data = nullptr;
+  m_size = 0;
+  m_isOpen = false;
+  m_slices.clear();
+  m_position = 0;
+}
+
+bool IndexedMessageFile::isOpen() const
+{
+  return m_isOpen;
+}
+
+QString IndexedMessageFile::errorString() const
+{
+  return m_file.errorString();
+}
+
+int IndexedMessageFile::messageCount() const
+{
+  return m_slices.size();
+}
+
+int IndexedMessageFile::position() const
+{
+  return m_position;
+}
+
+bool IndexedMessageFile::seek(int index)
+{
+  if (index < 0 || index > m_slices.size())
+    return false;
+
+  m_position = index;
+  return true;
+}
+
+bool IndexedMessageFile::atEnd() const
+{
+  return m_position >= m_slices.size();
+}
+
+QByteArray IndexedMessageFile::message(int index) const
+{
+  if (index < 0 || index >= m_slices.size())
+    return QByteArray();
+
+  // the returned array refers to the mapped file rather than copying it,
+  // so it is only valid until the file is closed
+  const Slice& slice = m_slices.at(index);
+  return QByteArray::fromRawData(m_data + slice.offset, slice.length);
+}
+
+QByteArray IndexedMessageFile::nextMessage()
+{
+  if (atEnd())
+    return QByteArray();
+
+  return message(m_position++);
+}
+
+void IndexedMessageFile::buildIndex(const QByteArray& messageElementName)
+{
+  m_slices.clear();
+  m_position = 0;
+
+  if (!m_data || m_size == 0)
+    return;
+
+  // a single pass over the raw bytes records where each message element starts and ends.
+  // Comments, CDATA sections, processing instructions and declarations are skipped
+  const std::string_view data(m_data, static_cast<std::string_view::size_type>(m_size));
+
+  int depth = 0;
+  std::string_view::size_type messageStart = 0;
+  auto position = data.find('<');
+
+  while (position != c_notFound)
+  {
+    std::string_view::size_type next = c_notFound;
+
+    if (data.compare(position, 4, "<!--") == 0)
+    {
+      next = data.find("-->", position + 4);
+      if (next != c_notFound)
+        next += 3;
+    }
+    else if (data.compare(position, 9, "<![CDATA[") == 0)
+    {
+      next = data.find("]]>", position + 9);
+      if (next != c_notFound)
+        next += 3;
+    }
+    else if (data.compare(position, 2, "<?") == 0)
+    {
+      next = data.find("?>", position + 2);
+      if (next != c_notFound)
+        next += 2;
+    }
+    else if (data.compare(position, 2, "<!") == 0)
+    {
+      next = tagEnd(data, position + 2);
+      if (next != c_notFound)
+        next += 1;
+    }
+    else
+    {
+      const bool isEndTag = data.compare(position, 2, "</") == 0;
+      const auto end = tagEnd(data, position + 1);
+      if (end == c_notFound)
+        break;
+
+      const auto name = localName(data, position + (isEndTag ? 2 : 1), end);
+      if (matchesElement(name, messageElementName))
+      {
+        if (isEndTag)
+        {
+          if (depth > 0 && --depth == 0)
+            m_slices.append(Slice{static_cast<qint64>(messageStart), static_cast<qint64>(end + 1 - messageStart)});
+        }
+        else
+        {
+          if (depth == 0)
+            messageStart = position;
+
+          const bool isSelfClosing = data[end - 1] == '/';
+          if (!isSelfClosing)
+            ++depth;
+          else if (depth == 0)
+            m_slices.append(Slice{static_cast<qint64>(messageStart), static_cast<qint64>(end + 1 - messageStart)});
+        }
+      }
+
+      next = end + 1;
+    }
+
+    if (next == c_notFound)
+      break;
+
+    position = data.find('<', next);
+  }
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef INDEXEDMESSAGEFILE_H
+#define INDEXEDMESSAGEFILE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QVector>
+
+class IndexedMessageFile
+{
+public:
+  IndexedMessageFile();
+  ~IndexedMessageFile();
+
+  bool open(const QString& filePath, const QString& messageElementName);
+  void close();
+
+  bool isOpen() const;
+  QString errorString() const;
+
+  int messageCount() const;
+
+  int position() const;
+  bool seek(int index);
+  bool atEnd() const;
+
+  QByteArray message(int index) const;
+  QByteArray nextMessage();
+
+private:
+  Q_DISABLE_COPY(IndexedMessageFile)
+
+  struct Slice
+  {
+    qint64 offset = 0;
+    qint64 length = 0;
+  };
+
+  void buildIndex(const QByteArray& messageElementName);
+
+  QFile m_file;
+  QByteArray m_buffer;
+  const char* m_data = nullptr;
+  qint64 m_size = 0;
+  bool m_isOpen = false;
+  QVector<Slice> m_slices;
+  int m_position = 0;
+};
+
+#endif // INDEXEDMESSAGEFILE_H
@@ -0,0 +1,744 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "MessageSendEngine.h"
+
+// dsa app headers
+#include "AbstractMessageParser.h"
+#include "DataSender.h"
+#include "UdpSocketPool.h"
+
+// Qt headers
+#include <QDateTime>
+#include <QTimer>
+#include <QUdpSocket>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// the longest and shortest time between two bursts of messages
+constexpr int c_maxTickMs = 1000;
+constexpr int c_minTickMs = 1;
+
+// a rate profile is re-evaluated at least this often
+constexpr int c_maxProfileTickMs = 100;
+
+// at most this many seconds' worth of messages are sent in one burst. If the
+// engine falls further behind than this the backlog is dropped rather than
+// sent as one long burst
+constexpr double c_maxBurstSeconds = 0.25;
+
+// the most messages queued before they are sent as one batch
+constexpr int c_maxBatchSize = 64;
+
+// how often the achieved rate is reported
+constexpr qint64 c_statisticsIntervalMs = 1000;
+
+// time constant of the smoothed achieved rate. A step in the rate is 63% taken up after this many seconds
+constexpr double c_rateSmoothingSeconds = 5.0;
+
+constexpr double c_nanosecondsPerSecond = 1e9;
+constexpr double c_nanosecondsPerMillisecond = 1e6;
+
+} // namespace
+
+MessageSendEngine::MessageSendEngine(QObject* parent) :
+  QObject(parent),
+  m_dataSender(new Dsa::DataSender(this)),
+  m_timer(new QTimer(this))
+{
+  m_timer->setTimerType(Qt::PreciseTimer);
+  connect(m_timer, &QTimer::timeout, this, &MessageSendEngine::sendOwedMessages);
+
+  m_clock.start();
+}
+
+MessageSendEngine::MessageSendEngine(UdpSocketPool* socketPool, QObject* parent) :
+  MessageSendEngine(parent)
+{
+  m_socketPool = socketPool;
+}
+
+MessageSendEngine::~MessageSendEngine()
+{
+  stop();
+}
+
+void MessageSendEngine::start(AbstractMessageParser* messageParser, const SendSettings& settings)
+{
+  // first stop the simulation if it was already running
+  stop();
+
+  if (!messageParser)
+    return;
+
+  // the engine owns the parser from now on
+  m_messageParser = messageParser;
+  m_messageParser->setParent(this);
+
+  m_settings = settings;
+
+  // create UDP connection to the destination address with specified port
+  m_pooledSocket = !m_socketPool.isNull();
+  if (m_pooledSocket)
+    m_udpSocket = m_socketPool->acquire(m_settings.address, m_settings.port, m_settings.sendBufferSize);
+  else
+    m_udpSocket = Dsa::DataSender::createUdpSocket(m_settings.address, static_cast<quint16>(m_settings.port), m_settings.sendBufferSize, this);
+
+  m_dataSender->setDevice(m_udpSocket);
+  m_dataSender->resetCounters();
+
+  m_activeNs = 0;
+  m_owed = 0.0;
+  m_pendingMessage.clear();
+  m_hasPendingMessage = false;
+  m_replayNeedsOrigin = true;
+  m_pendingTimeMs = 0.0;
+  m_messagesSent = 0;
+  m_messagesSentThisLoop = 0;
+  m_bytesSent = 0;
+  m_sendFailures = 0;
+  m_reportedFailures = 0;
+  m_emptyMessages = 0;
+  m_droppedMessages = 0;
+  m_loopsCompleted = 0;
+  m_latency.clear();
+  m_windowLatency.clear();
+  m_messagesSentAtWindowStart = 0;
+  m_bytesSentAtWindowStart = 0;
+  m_sendFailuresAtWindowStart = 0;
+  m_droppedMessagesAtWindowStart = 0;
+  m_achievedRate = 0.0;
+  m_smoothedRate = 0.0;
+  m_hasSmoothedRate = false;
+  m_statisticsClock.start();
+
+  if (m_settings.deterministic)
+  {
+    // generated content, the schedule and its jitter all follow the seed
+    m_messageParser->setSeed(m_settings.seed);
+    m_jitterRandom.seed(m_settings.seed);
+    m_scheduledNs = 0.0;
+    m_checksum.reset();
+    m_messagesSinceCheckpoint = 0;
+
+    // the first checkpoint tells receivers a new run is starting
+    m_run = QString::number(m_settings.seed) + QLatin1Char('-') + QString::number(QDateTime::currentMSecsSinceEpoch());
+    sendCheckpoint(false);
+  }
+
+  m_running = true;
+  m_lastTickNs = m_clock.nsecsElapsed();
+  updateTimerInterval();
+
+  emit statisticsUpdated(m_messagesSent, m_achievedRate, m_smoothedRate, m_sendFailures);
+}
+
+void MessageSendEngine::pause()
+{
+  if (!m_running)
+    return;
+
+  m_running = false;
+  m_timer->stop();
+  m_activeNs += m_clock.nsecsElapsed() - m_lastTickNs;
+  updateStatistics(true);
+}
+
+void MessageSendEngine::resume()
+{
+  if (m_running || !m_messageParser)
+    return;
+
+  // no messages are owed for the time spent paused, and the first window starts now
+  m_running = true;
+  m_lastTickNs = m_clock.nsecsElapsed();
+  m_messagesSentAtWindowStart = m_messagesSent;
+  m_bytesSentAtWindowStart = m_bytesSent;
+  m_sendFailuresAtWindowStart = m_sendFailures;
+  m_droppedMessagesAtWindowStart = m_droppedMessages;
+  m_windowLatency.clear();
+  m_statisticsClock.restart();
+  updateTimerInterval();
+}
+
+void MessageSendEngine::stop()
+{
+  m_timer->stop();
+
+  if (m_messageParser)
+  {
+    if (m_running)
+      m_activeNs += m_clock.nsecsElapsed() - m_lastTickNs;
+
+    // the last checkpoint covers every message sent
+    if (m_settings.deterministic)
+      sendCheckpoint(true);
+
+    updateStatistics(true);
+    emit stopped(summary());
+  }
+
+  m_running = false;
+  closeSocket();
+
+  // the pending message may be a view onto the parser's input
+  m_pendingMessage.clear();
+  m_hasPendingMessage = false;
+
+  if (m_messageParser)
+  {
+    delete m_messageParser;
+    m_messageParser = nullptr;
+  }
+}
+
+void MessageSendEngine::setMessagesPerSecond(double messagesPerSecond)
+{
+  if (messagesPerSecond <= 0.0)
+    return;
+
+  const double previousRate = m_settings.messagesPerSecond;
+  m_settings.messagesPerSecond = messagesPerSecond;
+
+  if (!m_running || m_settings.timestampReplay || !m_settings.rateProfile.isEmpty())
+    return;
+
+  // the time since the last tick is accounted at the previous rate, so the change applies
+  // from this instant on, without a gap or a burst
+  const qint64 now = m_clock.nsecsElapsed();
+  const qint64 elapsedNs = now - m_lastTickNs;
+  m_lastTickNs = now;
+  m_activeNs += elapsedNs;
+
+  if (m_settings.deterministic)
+  {
+    // the wait for the next scheduled message shrinks or grows with the rate
+    if (m_scheduledNs > m_activeNs)
+      m_scheduledNs = m_activeNs + (m_scheduledNs - m_activeNs) * previousRate / messagesPerSecond;
+  }
+  else
+  {
+    m_owed += elapsedNs * previousRate / c_nanosecondsPerSecond;
+  }
+
+  rescheduleTimer();
+}
+
+void MessageSendEngine::setLooped(bool looped)
+{
+  m_settings.looped = looped;
+}
+
+void MessageSendEngine::setReplaySpeed(double replaySpeed)
+{
+  if (replaySpeed <= 0.0)
+    return;
+
+  // re-anchor the replay at the current point of the original timeline so that
+  // the change applies from now on, without skipping or repeating messages
+  if (m_settings.timestampReplay && !m_replayNeedsOrigin)
+  {
+    m_replayOriginMs += (m_activeNs - m_replayOriginNs) * m_settings.replaySpeed / c_nanosecondsPerMillisecond;
+    m_replayOriginNs = m_activeNs;
+
+    if (m_hasPendingMessage)
+      m_pendingDueNs = m_replayOriginNs + static_cast<qint64>((m_pendingTimeMs - m_replayOriginMs) * c_nanosecondsPerMillisecond / replaySpeed);
+  }
+
+  m_settings.replaySpeed = replaySpeed;
+
+  if (m_running && m_settings.timestampReplay)
+    rescheduleTimer();
+}
+
+void MessageSendEngine::sendMessage(const QByteArray& message)
+{
+  if (!m_udpSocket)
+    return;
+
+  if (m_dataSender->sendData(message) == -1)
+  {
+    emit errorOccurred(tr("Failed to send message"));
+    return;
+  }
+
+  emit messageSent(message);
+}
+
+double MessageSendEngine::rateAt(const QList<QPointF>& rateProfile, double seconds)
+{
+  if (rateProfile.isEmpty())
+    return 0.0;
+
+  if (seconds <= rateProfile.first().x())
+    return rateProfile.first().y();
+
+  for (int i = 1; i < rateProfile.size(); ++i)
+  {
+    const QPointF& from = rateProfile.at(i - 1);
+    const QPointF& to = rateProfile.at(i);
+    if (seconds > to.x())
+      continue;
+
+    const double span = to.x() - from.x();
+    return span > 0.0 ? from.y() + (to.y() - from.y()) * (seconds - from.x()) / span : to.y();
+  }
+
+  // the last rate is held once the profile has been run through
+  return rateProfile.last().y();
+}
+
+void MessageSendEngine::sendOwedMessages()
+{
+  if (!m_running)
+    return;
+
+  // the running clock only advances while the engine is running, so pausing
+  // neither owes messages nor moves the replay schedule
+  const qint64 now = m_clock.nsecsElapsed();
+  const qint64 elapsedNs = now - m_lastTickNs;
+  m_lastTickNs = now;
+  m_activeNs += elapsedNs;
+
+  // a deterministic run ends at a scheduled time instead, so that it always sends the same messages
+  bool reachedEnd = !m_settings.deterministic && m_settings.duration > 0.0 &&
+      m_activeNs >= m_settings.duration * c_nanosecondsPerSecond;
+
+  QByteArray lastMessage;
+  if (!reachedEnd)
+  {
+    if (m_settings.timestampReplay)
+      sendDueMessages(now, reachedEnd, lastMessage);
+    else if (m_settings.deterministic)
+      sendScheduledMessages(now, reachedEnd, lastMessage);
+    else
+      sendRateMessages(now, elapsedNs, reachedEnd, lastMessage);
+  }
+
+  // only the last message of each burst is reported for display. Parsers may return
+  // views onto their input file, so the message is copied before it leaves this thread
+  if (!lastMessage.isEmpty())
+    emit messageSent(QByteArray(lastMessage.constData(), lastMessage.size()));
+
+  if (reachedEnd)
+  {
+    stop();
+    emit finished();
+    return;
+  }
+
+  updateTimerInterval();
+  updateStatistics(false);
+}
+
+void MessageSendEngine::sendRateMessages(qint64 now, qint64 elapsedNs, bool& reachedEnd, QByteArray& lastMessage)
+{
+  const double rate = currentRate();
+  if (rate <= 0.0)
+    return;
+
+  // messages are owed in proportion to the time since the last tick, so timer
+  // jitter does not change the rate and a rate change takes effect smoothly
+  m_owed += elapsedNs * rate / c_nanosecondsPerSecond;
+
+  const double maxBurst = std::max(1.0, rate * c_maxBurstSeconds);
+  if (m_owed > maxBurst)
+  {
+    m_droppedMessages += static_cast<qint64>(m_owed - maxBurst);
+    m_owed = maxBurst;
+  }
+
+  const double nanosecondsPerMessage = c_nanosecondsPerSecond / rate;
+  while (m_owed >= 1.0)
+  {
+    m_owed -= 1.0;
+
+    // the message fell due when the part of the credit it uses was accrued
+    const qint64 dueNs = now - static_cast<qint64>(m_owed * nanosecondsPerMessage);
+    QByteArray messageBytes;
+    if (!nextMessage(messageBytes))
+    {
+      reachedEnd = true;
+      break;
+    }
+
+    queueMessage(messageBytes, dueNs, lastMessage);
+  }
+
+  flushMessages(lastMessage);
+}
+
+void MessageSendEngine::sendDueMessages(qint64 now, bool& reachedEnd, QByteArray& lastMessage)
+{
+  // bursts in the original traffic are reproduced, so no backlog is dropped here
+  while (true)
+  {
+    if (!m_hasPendingMessage)
+    {
+      if (!nextMessage(m_pendingMessage))
+      {
+        reachedEnd = true;
+        break;
+      }
+
+      if (m_pendingMessage.isEmpty())
+        continue;
+
+      m_hasPendingMessage = true;
+
+      const qint64 timeMs = m_messageParser->messageTime(m_pendingMessage);
+      if (timeMs >= 0)
+        m_pendingTimeMs = timeMs;
+      else if (!m_replayNeedsOrigin)
+        m_pendingTimeMs += 1000.0 / m_settings.messagesPerSecond;
+
+      // the first message of each pass is sent straight away
+      if (m_replayNeedsOrigin)
+      {
+        m_replayOriginMs = m_pendingTimeMs;
+        m_replayOriginNs = m_activeNs;
+        m_replayNeedsOrigin = false;
+      }
+
+      m_pendingDueNs = m_replayOriginNs + static_cast<qint64>((m_pendingTimeMs - m_replayOriginMs) * c_nanosecondsPerMillisecond /
+                                                              m_settings.replaySpeed);
+    }
+
+    if (m_pendingDueNs > m_activeNs)
+      break;
+
+    if (m_settings.deterministic && m_settings.duration > 0.0 && m_pendingDueNs >= m_settings.duration * c_nanosecondsPerSecond)
+    {
+      reachedEnd = true;
+      break;
+    }
+
+    // the due time is on the running clock, which stands at m_activeNs when the clock reads now
+    const qint64 dueNs = now - (m_activeNs - m_pendingDueNs);
+    const QByteArray messageBytes = m_settings.rewriteTimes
+        ? m_messageParser->retimeMessage(m_pendingMessage, QDateTime::currentDateTimeUtc())
+        : m_pendingMessage;
+    m_hasPendingMessage = false;
+
+    queueMessage(messageBytes, dueNs, lastMessage);
+  }
+
+  flushMessages(lastMessage);
+}
+
+bool MessageSendEngine::nextMessage(QByteArray& message)
+{
+  if (m_messageParser->atEnd())
+  {
+    if (m_messagesSentThisLoop > 0)
+      m_loopsCompleted++;
+
+    // reached end of the message parser
+    // check if simulation is looped, if not end the simulation
+    if (m_settings.looped && m_messagesSentThisLoop > 0 &&
+        (m_settings.loopCount <= 0 || m_loopsCompleted < m_settings.loopCount))
+    {
+      // reset the message parser to the beginning to continue
+      // looping through messages
+      m_messageParser->reset();
+      m_messagesSentThisLoop = 0;
+      m_replayNeedsOrigin = true;
+    }
+    else
+    {
+      // if no messages have been sent and we've reached the end of the parser
+      // then the simulation contains no messages
+      if (m_messagesSent == 0)
+        emit errorOccurred(tr("Simulation file contains no messages"));
+
+      return false;
+    }
+  }
+
+  message = m_messageParser->nextMessage();
+  if (message.isEmpty())
+  {
+    m_emptyMessages++;
+    emit errorOccurred(tr("Message is empty"));
+  }
+
+  return true;
+}
+
+void MessageSendEngine::sendScheduledMessages(qint64 now, bool& reachedEnd, QByteArray& lastMessage)
+{
+  // messages that are late are sent late rather than dropped, so the sequence never depends on timing
+  while (m_scheduledNs <= m_activeNs)
+  {
+    if (m_settings.duration > 0.0 && m_scheduledNs >= m_settings.duration * c_nanosecondsPerSecond)
+    {
+      reachedEnd = true;
+      break;
+    }
+
+    // the rate profile is evaluated at the scheduled time, not the time the timer fired
+    const double rate = m_settings.rateProfile.isEmpty() ? m_settings.messagesPerSecond
+                                                         : rateAt(m_settings.rateProfile, m_scheduledNs / c_nanosecondsPerSecond);
+    if (rate <= 0.0)
+    {
+      m_scheduledNs += c_maxProfileTickMs * c_nanosecondsPerMillisecond;
+      continue;
+    }
+
+    QByteArray messageBytes;
+    if (!nextMessage(messageBytes))
+    {
+      reachedEnd = true;
+      break;
+    }
+
+    queueMessage(messageBytes, now - static_cast<qint64>(m_activeNs - m_scheduledNs), lastMessage);
+
+    const double intervalNs = c_nanosecondsPerSecond / rate;
+    m_scheduledNs += m_settings.jitter > 0.0 ? intervalNs * (1.0 + m_jitterRandom.uniform(-m_settings.jitter, m_settings.jitter)) : intervalNs;
+  }
+
+  flushMessages(lastMessage);
+}
+
+void MessageSendEngine::sendCheckpoint(bool final)
+{
+  if (!m_udpSocket)
+    return;
+
+  // checkpoints are not counted as messages, but follow the messages they cover on the same socket
+  m_dataSender->sendData(m_checksum.checkpointMessage(m_run, final));
+  m_messagesSinceCheckpoint = 0;
+}
+
+void MessageSendEngine::queueMessage(const QByteArray& messageBytes, qint64 dueNs, QByteArray& lastMessage)
+{
+  if (messageBytes.isEmpty())
+    return;
+
+  m_messagesSentThisLoop++;
+  m_batch.append(messageBytes);
+  m_batchDueNs.push_back(dueNs);
+
+  if (m_settings.deterministic)
+  {
+    m_checksum.add(messageBytes);
+    if (++m_messagesSinceCheckpoint >= m_settings.checkpointInterval)
+    {
+      flushMessages(lastMessage);
+      sendCheckpoint(false);
+      return;
+    }
+  }
+
+  if (m_batch.size() >= c_maxBatchSize)
+    flushMessages(lastMessage);
+}
+
+void MessageSendEngine::flushMessages(QByteArray& lastMessage)
+{
+  if (m_batch.isEmpty())
+    return;
+
+  qint64 bytesSent = 0;
+  const int messagesSent = m_dataSender->sendBatch(m_batch, &bytesSent);
+  const qint64 sentNs = m_clock.nsecsElapsed();
+
+  // the latency of a batch is measured when the whole batch has been handed over
+  for (int i = 0; i < messagesSent; ++i)
+  {
+    m_latency.record(sentNs - m_batchDueNs[i]);
+    m_windowLatency.record(sentNs - m_batchDueNs[i]);
+  }
+
+  m_messagesSent += messagesSent;
+  m_bytesSent += bytesSent;
+  m_sendFailures += m_batch.size() - messagesSent;
+
+  if (messagesSent > 0)
+    lastMessage = m_batch.last();
+
+  m_batch.clear();
+  m_batchDueNs.clear();
+}
+
+double MessageSendEngine::currentRate() const
+{
+  if (m_settings.rateProfile.isEmpty())
+    return m_settings.messagesPerSecond;
+
+  return rateAt(m_settings.rateProfile, m_activeNs / c_nanosecondsPerSecond);
+}
+
+int MessageSendEngine::timerInterval() const
+{
+  // tick twice per message at low rates so that timer jitter cannot delay a message by a
+  // whole period, otherwise as often as the timer allows and send in bursts
+  const int maxTickMs = m_settings.rateProfile.isEmpty() ? c_maxTickMs : c_maxProfileTickMs;
+  const double rate = currentRate();
+  double periodMs = rate > 0.0 ? 500.0 / rate : maxTickMs;
+
+  // in timestamp replay and deterministic runs wake up when the next message falls due
+  if (m_settings.timestampReplay)
+    periodMs = m_hasPendingMessage ? (m_pendingDueNs - m_activeNs) / c_nanosecondsPerMillisecond : c_minTickMs;
+  else if (m_settings.deterministic)
+    periodMs = (m_scheduledNs - m_activeNs) / c_nanosecondsPerMillisecond;
+
+  return std::clamp(static_cast<int>(periodMs), c_minTickMs, maxTickMs);
+}
+
+void MessageSendEngine::updateTimerInterval()
+{
+  const int interval = timerInterval();
+
+  if (!m_timer->isActive())
+    m_timer->start(interval);
+  else if (m_timer->interval() != interval)
+    m_timer->setInterval(interval);
+}
+
+void MessageSendEngine::rescheduleTimer()
+{
+  // setting the interval restarts the countdown, so between ticks the timer is only brought
+  // forward. A stream of changes, such as from a slider being dragged, would otherwise keep
+  // pushing the next tick back. A longer interval is taken up at the next tick
+  const int interval = timerInterval();
+  if (interval < m_timer->remainingTime())
+    m_timer->start(interval);
+}
+
+void MessageSendEngine::updateStatistics(bool force)
+{
+  const qint64 windowMs = m_statisticsClock.elapsed();
+  if (!force && windowMs < c_statisticsIntervalMs)
+    return;
+
+  if (windowMs > 0)
+  {
+    const double windowSeconds = windowMs / 1000.0;
+    m_achievedRate = (m_messagesSent - m_messagesSentAtWindowStart) / windowSeconds;
+
+    // each window is weighted by its length, so the short windows left by a pause do not skew the rate
+    const double weight = 1.0 - std::exp(-windowSeconds / c_rateSmoothingSeconds);
+    m_smoothedRate = m_hasSmoothedRate ? m_smoothedRate + weight * (m_achievedRate - m_smoothedRate) : m_achievedRate;
+    m_hasSmoothedRate = true;
+
+    emit intervalStatisticsUpdated(intervalStatistics(windowSeconds));
+  }
+
+  m_messagesSentAtWindowStart = m_messagesSent;
+  m_bytesSentAtWindowStart = m_bytesSent;
+  m_sendFailuresAtWindowStart = m_sendFailures;
+  m_droppedMessagesAtWindowStart = m_droppedMessages;
+  m_windowLatency.clear();
+  m_statisticsClock.restart();
+
+  // failures are reported once per window rather than once per message
+  if (m_sendFailures > m_reportedFailures)
+  {
+    emit errorOccurred(tr("Failed to send %1 messages").arg(m_sendFailures - m_reportedFailures));
+    m_reportedFailures = m_sendFailures;
+  }
+
+  emit statisticsUpdated(m_messagesSent, m_achievedRate, m_smoothedRate, m_sendFailures);
+}
+
+QVariantMap MessageSendEngine::intervalStatistics(double windowSeconds) const
+{
+  const qint64 bytesSent = m_bytesSent - m_bytesSentAtWindowStart;
+  const qint64 droppedMessages = m_droppedMessages - m_droppedMessagesAtWindowStart;
+
+  // the engine cannot keep up when it drops messages or sends them later than a burst can
+  // catch up on. The wait for a tick is allowed for, as at low rates it is up to one message interval
+  const double lateSeconds = std::max(c_maxBurstSeconds, 2.0 * m_timer->interval() / 1000.0);
+  const bool saturated = droppedMessages > 0 || m_windowLatency.percentile(99.0) > lateSeconds * c_nanosecondsPerSecond;
+
+  QVariantMap result;
+  result.insert(QStringLiteral("time"), m_activeNs / c_nanosecondsPerSecond);
+  result.insert(QStringLiteral("seconds"), windowSeconds);
+  result.insert(QStringLiteral("messagesSent"), m_messagesSent - m_messagesSentAtWindowStart);
+  result.insert(QStringLiteral("achievedRate"), m_achievedRate);
+  result.insert(QStringLiteral("smoothedRate"), m_smoothedRate);
+  // messages sent at their original times have no target rate
+  result.insert(QStringLiteral("targetRate"), m_settings.timestampReplay ? 0.0 : currentRate());
+  result.insert(QStringLiteral("bytesSent"), bytesSent);
+  result.insert(QStringLiteral("bytesPerSecond"), bytesSent / windowSeconds);
+  result.insert(QStringLiteral("sendFailures"), m_sendFailures - m_sendFailuresAtWindowStart);
+  result.insert(QStringLiteral("droppedMessages"), droppedMessages);
+  result.insert(QStringLiteral("sendLatency"), m_windowLatency.toVariantMap());
+  result.insert(QStringLiteral("saturated"), saturated);
+
+  return result;
+}
+
+QVariantMap MessageSendEngine::summary() const
+{
+  const double elapsedSeconds = m_activeNs / c_nanosecondsPerSecond;
+
+  QVariantMap result;
+  result.insert(QStringLiteral("messagesSent"), m_messagesSent);
+  result.insert(QStringLiteral("bytesSent"), m_bytesSent);
+  result.insert(QStringLiteral("elapsedSeconds"), elapsedSeconds);
+  result.insert(QStringLiteral("averageRate"), elapsedSeconds > 0.0 ? m_messagesSent / elapsedSeconds : 0.0);
+  result.insert(QStringLiteral("achievedRate"), m_achievedRate);
+  result.insert(QStringLiteral("smoothedRate"), m_smoothedRate);
+  result.insert(QStringLiteral("loopsCompleted"), m_loopsCompleted);
+  result.insert(QStringLiteral("sendFailures"), m_sendFailures);
+  result.insert(QStringLiteral("partialSends"), m_dataSender->partialSends());
+  result.insert(QStringLiteral("emptyMessages"), m_emptyMessages);
+  result.insert(QStringLiteral("droppedMessages"), m_droppedMessages);
+  result.insert(QStringLiteral("sendLatency"), m_latency.toVariantMap());
+
+  if (m_settings.deterministic)
+  {
+    result.insert(QStringLiteral("seed"), m_settings.seed);
+    result.insert(QStringLiteral("run"), m_run);
+    result.insert(QStringLiteral("checksum"), QString::number(m_checksum.value(), 16));
+    result.insert(QStringLiteral("checksumMessages"), m_checksum.count());
+  }
+
+  return result;
+}
+
+void MessageSendEngine::closeSocket()
+{
+  if (!m_udpSocket)
+    return;
+
+  m_dataSender->setDevice(nullptr);
+
+  if (m_pooledSocket)
+  {
+    // other streams may still be sending on the socket
+    if (m_socketPool)
+      m_socketPool->release(m_settings.address, m_settings.port);
+
+    m_udpSocket = nullptr;
+    return;
+  }
+
+  if (m_udpSocket->isOpen())
+    m_udpSocket->close();
+
+  delete m_udpSocket;
+  m_udpSocket = nullptr;
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef MESSAGESENDENGINE_H
+#define MESSAGESENDENGINE_H
+
+#include "LatencyHistogram.h"
+#include "SeededRandom.h"
+#include "StreamChecksum.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QPointer>
+#include <QVariantMap>
+
+// STL headers
+#include <vector>
+
+namespace Dsa {
+class DataSender;
+}
+
+class AbstractMessageParser;
+class QTimer;
+class QUdpSocket;
+class UdpSocketPool;
+
+struct SendSettings
+{
+  // broadcast by default; a unicast or multicast address sends only there
+  QHostAddress address = QHostAddress(QHostAddress::Broadcast);
+  int port = -1;
+  // bytes; 0 keeps the system's default send buffer
+  int sendBufferSize = 0;
+  double messagesPerSecond = 1.0;
+  bool looped = true;
+  // number of passes through the messages when looped; 0 loops until stopped
+  int loopCount = 0;
+  // seconds of sending after which the simulation finishes; 0 runs until stopped
+  double duration = 0.0;
+  // (seconds, messages per second) points interpolated linearly; overrides messagesPerSecond when set
+  QList<QPointF> rateProfile;
+  // send each message at its original time relative to the first, scaled by replaySpeed.
+  // Messages without a time stamp follow the previous one at messagesPerSecond
+  bool timestampReplay = false;
+  double replaySpeed = 1.0;
+  // move the time stamps of replayed messages to the time they are sent
+  bool rewriteTimes = false;
+  // send the same messages in the same order on every run with the same seed. The schedule,
+  // including any jitter, is computed from the seed instead of following the timer, no
+  // messages are dropped, and a duration counts scheduled rather than elapsed time
+  bool deterministic = false;
+  quint32 seed = 0;
+  // fraction of the interval between two messages by which a deterministic run moves each one, 0 to 1
+  double jitter = 0.0;
+  // messages between the checksum checkpoints of a deterministic run
+  int checkpointInterval = 1000;
+};
+
+class MessageSendEngine : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit MessageSendEngine(QObject* parent = nullptr);
+  // streams created with a pool share one socket per port instead of opening their own
+  explicit MessageSendEngine(UdpSocketPool* socketPool, QObject* parent = nullptr);
+  ~MessageSendEngine();
+
+  void start(AbstractMessageParser* messageParser, const SendSettings& settings);
+  void pause();
+  void resume();
+  void stop();
+
+  void setMessagesPerSecond(double messagesPerSecond);
+  void setLooped(bool looped);
+  void setReplaySpeed(double replaySpeed);
+
+  void sendMessage(const QByteArray& message);
+
+  static double rateAt(const QList<QPointF>& rateProfile, double seconds);
+
+signals:
+  void messageSent(const QByteArray& message);
+  void statisticsUpdated(qint64 messagesSent, double achievedRate, double smoothedRate, qint64 sendFailures);
+  // the messages, bytes and send latencies of each statistics window, about one second long
+  void intervalStatisticsUpdated(const QVariantMap& statistics);
+  void stopped(const QVariantMap& summary);
+  void finished();
+  void errorOccurred(const QString& error);
+
+private:
+  Q_DISABLE_COPY(MessageSendEngine)
+
+  void sendOwedMessages();
+  void sendRateMessages(qint64 now, qint64 elapsedNs, bool& reachedEnd, QByteArray& lastMessage);
+  void sendDueMessages(qint64 now, bool& reachedEnd, QByteArray& lastMessage);
+  void sendScheduledMessages(qint64 now, bool& reachedEnd, QByteArray& lastMessage);
+  void sendCheckpoint(bool final);
+  bool nextMessage(QByteArray& message);
+  void queueMessage(const QByteArray& messageBytes, qint64 dueNs, QByteArray& lastMessage);
+  void flushMessages(QByteArray& lastMessage);
+  double currentRate() const;
+  int timerInterval() const;
+  void updateTimerInterval();
+  void rescheduleTimer();
+  void updateStatistics(bool force);
+  QVariantMap intervalStatistics(double windowSeconds) const;
+  QVariantMap summary() const;
+  void closeSocket();
+
+  Dsa::DataSender* m_dataSender = nullptr;
+  AbstractMessageParser* m_messageParser = nullptr;
+  QUdpSocket* m_udpSocket = nullptr;
+  QPointer<UdpSocketPool> m_socketPool;
+  bool m_pooledSocket = false;
+  QTimer* m_timer = nullptr;
+
+  SendSettings m_settings;
+  bool m_running = false;
+
+  // messages are owed in proportion to the time spent running, measured with a monotonic clock
+  QElapsedTimer m_clock;
+  qint64 m_lastTickNs = 0;
+  qint64 m_activeNs = 0;
+  double m_owed = 0.0;
+
+  // a deterministic run sends each message at its scheduled time on the running clock
+  SeededRandom m_jitterRandom;
+  double m_scheduledNs = 0.0;
+
+  // published in checkpoints so a receiver can verify it saw the identical stream
+  Dsa::StreamChecksum m_checksum;
+  QString m_run;
+  int m_messagesSinceCheckpoint = 0;
+
+  // messages of a burst are sent together, in as few system calls as the platform allows
+  QList<QByteArray> m_batch;
+  std::vector<qint64> m_batchDueNs;
+
+  // in timestamp replay the next message is held until it falls due. Its due time is
+  // measured on the same running clock as m_activeNs, from an origin set at each loop
+  QByteArray m_pendingMessage;
+  bool m_hasPendingMessage = false;
+  bool m_replayNeedsOrigin = true;
+  double m_pendingTimeMs = 0.0;
+  double m_replayOriginMs = 0.0;
+  qint64 m_replayOriginNs = 0;
+  qint64 m_pendingDueNs = 0;
+
+  qint64 m_messagesSent = 0;
+  qint64 m_messagesSentThisLoop = 0;
+  qint64 m_bytesSent = 0;
+  qint64 m_sendFailures = 0;
+  qint64 m_reportedFailures = 0;
+  qint64 m_emptyMessages = 0;
+  qint64 m_droppedMessages = 0;
+  int m_loopsCompleted = 0;
+  Dsa::LatencyHistogram m_latency;
+
+  // statistics are reported per window, with the achieved rate smoothed over several windows
+  QElapsedTimer m_statisticsClock;
+  qint64 m_messagesSentAtWindowStart = 0;
+  qint64 m_bytesSentAtWindowStart = 0;
+  qint64 m_sendFailuresAtWindowStart = 0;
+  qint64 m_droppedMessagesAtWindowStart = 0;
+  Dsa::LatencyHistogram m_windowLatency;
+  double m_achievedRate = 0.0;
+  double m_smoothedRate = 0.0;
+  bool m_hasSmoothedRate = false;
+};
+
+#endif // MESSAGESENDENGINE_H
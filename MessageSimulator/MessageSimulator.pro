@@ -26,21 +26,39 @@ INCLUDEPATH += \
 
 HEADERS += \
     $$PWD/../Shared/utilities/DataSender.h \
+    $$PWD/../Shared/utilities/Geodesy.h \
+    $$PWD/../Shared/utilities/LatencyHistogram.h \
+    $$PWD/../Shared/utilities/NetworkService.h \
+    $$PWD/../Shared/utilities/StreamChecksum.h \
     MessageSimulatorController.h \
+    MessageSendEngine.h \
     AbstractMessageParser.h \
     CoTMessageParser.h \
     SimulatedMessage.h \
     SimulatedMessageListModel.h \
-    GeoMessageParser.h
+    GeoMessageParser.h \
+    IndexedMessageFile.h \
+    ScenarioMessageParser.h \
+    SeededRandom.h \
+    UdpSocketPool.h
 
 SOURCES += main.cpp \
     $$PWD/../Shared/utilities/DataSender.cpp \
+    $$PWD/../Shared/utilities/Geodesy.cpp \
+    $$PWD/../Shared/utilities/LatencyHistogram.cpp \
+    $$PWD/../Shared/utilities/NetworkService.cpp \
+    $$PWD/../Shared/utilities/StreamChecksum.cpp \
     AbstractMessageParser.cpp \
     CoTMessageParser.cpp \
     MessageSimulatorController.cpp \
+    MessageSendEngine.cpp \
     SimulatedMessage.cpp \
     SimulatedMessageListModel.cpp \
-    GeoMessageParser.cpp
+    GeoMessageParser.cpp \
+    IndexedMessageFile.cpp \
+    ScenarioMessageParser.cpp \
+    SeededRandom.cpp \
+    UdpSocketPool.cpp
 
 RESOURCES += qml/qml.qrc \
     Resources/application.qrc
@@ -18,83 +18,68 @@
 
 // dsa app headers
 #include "AbstractMessageParser.h"
-#include "DataSender.h"
-#include "SimulatedMessage.h"
 #include "SimulatedMessageListModel.h"
+#include "UdpSocketPool.h"
 
 // Qt headers
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QSettings>
 
-MessageSimulatorController::MessageSimulatorController(QObject* parent) :
-  QObject(parent),
-  m_dataSender(new Dsa::DataSender(this)),
-  m_messages(new SimulatedMessageListModel(this))
+// STL headers
+#include <algorithm>
+
+namespace
 {
-  connect(&m_timer, &QTimer::timeout, this, [this]
-  {
-    if (m_messageParser->atEnd())
-    {
-      // reached end of the message parser
-      // check if simulation is looped, if not end the simulation
-      if (m_simulationLooped && m_messagesSent > 0)
-      {
-        // reset the message parser to the beginning to continue
-        // looping through messages
-        m_messageParser->reset();
-      }
-      else if (m_messagesSent == 0)
-      {
-        // if no messages have been sent and we've reached the end of the parser
-        // then the simulation contains no messages
-        emit errorOccurred(tr("Simulation file contains no messages"));
-        stopSimulation();
-        return;
-      }
-      else
-      {
-        // simulation has finished
-        stopSimulation();
-        return;
-      }
-    }
 
-    const auto messageBytes = m_messageParser->nextMessage();
-    if (messageBytes.isEmpty())
-    {
-      emit errorOccurred(tr("Message is empty"));
-      return;
-    }
+// statistics windows kept for display, over all streams
+constexpr int c_statisticsHistoryLength = 120;
 
-    if (m_dataSender->sendData(messageBytes) == -1)
-    {
-      emit errorOccurred(tr("Failed to send message"));
-      return;
-    }
+QString csvField(const QString& value)
+{
+  if (!value.contains(QLatin1Char(',')) && !value.contains(QLatin1Char('"')))
+    return value;
 
-    m_messagesSent++;
-  });
+  return QLatin1Char('"') + QString(value).replace(QLatin1Char('"'), QStringLiteral("\"\"")) + QLatin1Char('"');
+}
 
-  connect(m_dataSender, &Dsa::DataSender::dataSent, this, [this](const QByteArray& data)
-  {
-    // create a simulated message to be added to the messages model
-    SimulatedMessage* simulatedMessage = SimulatedMessage::create(data, this);
-    if (!simulatedMessage)
-    {
-      emit errorOccurred(tr("Failed to create simulated message"));
-      return;
-    }
+} // namespace
 
-    m_messages->append(simulatedMessage);
-  });
+MessageSimulatorController::MessageSimulatorController(QObject* parent) :
+  MessageSimulatorController(true, parent)
+{
+}
+
+MessageSimulatorController::MessageSimulatorController(bool persistSettings, QObject* parent) :
+  QObject(parent),
+  m_messages(new SimulatedMessageListModel(this)),
+  m_socketPool(new UdpSocketPool()),
+  m_persistSettings(persistSettings)
+{
+  // the socket pool lives on the send thread with the streams and is deleted when the thread finishes
+  m_socketPool->moveToThread(&m_sendThread);
+  connect(&m_sendThread, &QThread::finished, m_socketPool, &QObject::deleteLater);
+
+  m_sendThread.start();
 
   // load settings for the app if they exist
-  loadSettings();
+  if (m_persistSettings)
+    loadSettings();
 }
 
 MessageSimulatorController::~MessageSimulatorController()
 {
   // stop active simulation
   stopSimulation();
+  discardStreams();
+
+  m_sendThread.quit();
+  m_sendThread.wait();
 }
 
 QUrl MessageSimulatorController::simulationFile() const
@@ -127,6 +112,46 @@ int MessageSimulatorController::port() const
   return m_port;
 }
 
+QString MessageSimulatorController::destinationAddress() const
+{
+  return m_destinationAddress;
+}
+
+void MessageSimulatorController::setDestinationAddress(const QString& destinationAddress)
+{
+  const QString address = destinationAddress.trimmed();
+  if (m_destinationAddress == address)
+    return;
+
+  // takes effect when the next simulation starts
+  if (!address.isEmpty() && QHostAddress(address).isNull())
+  {
+    emit errorOccurred(tr("Invalid destination address: ") + address);
+    return;
+  }
+
+  m_destinationAddress = address;
+
+  emit destinationAddressChanged();
+}
+
+int MessageSimulatorController::sendBufferSize() const
+{
+  return m_sendBufferSize;
+}
+
+void MessageSimulatorController::setSendBufferSize(int sendBufferSize)
+{
+  sendBufferSize = std::max(sendBufferSize, 0);
+  if (m_sendBufferSize == sendBufferSize)
+    return;
+
+  // takes effect when the next simulation starts
+  m_sendBufferSize = sendBufferSize;
+
+  emit sendBufferSizeChanged();
+}
+
 void MessageSimulatorController::setMessageFrequency(float messageFrequency)
 {
   const auto previousMessageFrequency = m_messageFrequency;
@@ -134,14 +159,14 @@ void MessageSimulatorController::setMessageFrequency(float messageFrequency)
   if (messageFrequency > 0)
   {
     m_messageFrequency = messageFrequency;
-    if (m_timer.isActive())
-      m_timer.stop();
 
-    if (m_simulationState == SimulationState::Running)
+    if (MessageSendEngine* engine = singleStreamEngine())
     {
-      float messageFrequencyInSeconds = (timeUnitToSeconds(m_timeUnit) / messageFrequency);
-      constexpr float millisecondsMultiplier = 1000.0f;
-      m_timer.start(messageFrequencyInSeconds * millisecondsMultiplier); // in ms
+      const double rate = messagesPerSecond();
+      QMetaObject::invokeMethod(engine, [engine, rate]()
+      {
+        engine->setMessagesPerSecond(rate);
+      }, Qt::QueuedConnection);
     }
 
     if (previousMessageFrequency != m_messageFrequency)
@@ -171,6 +196,14 @@ void MessageSimulatorController::setSimulationLooped(bool simulationLooped)
 
   m_simulationLooped = simulationLooped;
 
+  if (MessageSendEngine* engine = singleStreamEngine())
+  {
+    QMetaObject::invokeMethod(engine, [engine, simulationLooped]()
+    {
+      engine->setLooped(simulationLooped);
+    }, Qt::QueuedConnection);
+  }
+
   emit simulationLoopedChanged();
 }
 
@@ -186,6 +219,10 @@ void MessageSimulatorController::setTimeUnit(TimeUnit timeUnit)
 
   m_timeUnit = timeUnit;
 
+  // the rate in messages per second depends on the time unit
+  if (m_simulationState != SimulationState::Stopped)
+    setMessageFrequency(m_messageFrequency);
+
   emit timeUnitChanged();
 }
 
@@ -194,28 +231,294 @@ QAbstractListModel* MessageSimulatorController::messages() const
   return m_messages;
 }
 
+int MessageSimulatorController::messageHistoryDepth() const
+{
+  return m_messages->capacity();
+}
+
+void MessageSimulatorController::setMessageHistoryDepth(int messageHistoryDepth)
+{
+  if (messageHistoryDepth < 1 || m_messages->capacity() == messageHistoryDepth)
+    return;
+
+  m_messages->setCapacity(messageHistoryDepth);
+
+  emit messageHistoryDepthChanged();
+}
+
+int MessageSimulatorController::messageSampleInterval() const
+{
+  return m_messages->sampleInterval();
+}
+
+void MessageSimulatorController::setMessageSampleInterval(int messageSampleInterval)
+{
+  if (messageSampleInterval < 1 || m_messages->sampleInterval() == messageSampleInterval)
+    return;
+
+  m_messages->setSampleInterval(messageSampleInterval);
+
+  emit messageSampleIntervalChanged();
+}
+
+qint64 MessageSimulatorController::messagesSent() const
+{
+  return m_messagesSent;
+}
+
+double MessageSimulatorController::achievedRate() const
+{
+  return m_achievedRate;
+}
+
+double MessageSimulatorController::smoothedRate() const
+{
+  return m_smoothedRate;
+}
+
+bool MessageSimulatorController::isSaturated() const
+{
+  return m_saturated;
+}
+
+QVariantList MessageSimulatorController::streamStatistics() const
+{
+  QVariantList statistics;
+  for (const Stream& stream : m_streams)
+  {
+    QVariantMap streamStatistics;
+    streamStatistics.insert(QStringLiteral("name"), stream.name);
+    streamStatistics.insert(QStringLiteral("port"), stream.settings.port);
+    streamStatistics.insert(QStringLiteral("messagesSent"), stream.messagesSent);
+    streamStatistics.insert(QStringLiteral("achievedRate"), stream.achievedRate);
+    streamStatistics.insert(QStringLiteral("smoothedRate"), stream.smoothedRate);
+    streamStatistics.insert(QStringLiteral("sendFailures"), stream.sendFailures);
+    streamStatistics.insert(QStringLiteral("bytesPerSecond"), stream.lastInterval.value(QStringLiteral("bytesPerSecond"), 0.0));
+    streamStatistics.insert(QStringLiteral("sendLatency"), stream.lastInterval.value(QStringLiteral("sendLatency")));
+    streamStatistics.insert(QStringLiteral("saturated"), stream.lastInterval.value(QStringLiteral("saturated"), false));
+    streamStatistics.insert(QStringLiteral("running"), !stream.stopped);
+    statistics.append(streamStatistics);
+  }
+
+  return statistics;
+}
+
+QVariantList MessageSimulatorController::statisticsHistory() const
+{
+  return m_statisticsHistory;
+}
+
+QVariantMap MessageSimulatorController::summary() const
+{
+  return m_summary;
+}
+
+int MessageSimulatorController::loopCount() const
+{
+  return m_loopCount;
+}
+
+void MessageSimulatorController::setLoopCount(int loopCount)
+{
+  loopCount = std::max(loopCount, 0);
+  if (m_loopCount == loopCount)
+    return;
+
+  m_loopCount = loopCount;
+
+  emit loopCountChanged();
+}
+
+double MessageSimulatorController::duration() const
+{
+  return m_duration;
+}
+
+void MessageSimulatorController::setDuration(double duration)
+{
+  duration = std::max(duration, 0.0);
+  if (m_duration == duration)
+    return;
+
+  m_duration = duration;
+
+  emit durationChanged();
+}
+
+bool MessageSimulatorController::isTimestampReplay() const
+{
+  return m_timestampReplay;
+}
+
+void MessageSimulatorController::setTimestampReplay(bool timestampReplay)
+{
+  if (m_timestampReplay == timestampReplay)
+    return;
+
+  // takes effect when the next simulation starts
+  m_timestampReplay = timestampReplay;
+
+  emit timestampReplayChanged();
+}
+
+double MessageSimulatorController::replaySpeed() const
+{
+  return m_replaySpeed;
+}
+
+void MessageSimulatorController::setReplaySpeed(double replaySpeed)
+{
+  if (replaySpeed <= 0.0 || m_replaySpeed == replaySpeed)
+    return;
+
+  m_replaySpeed = replaySpeed;
+
+  if (MessageSendEngine* engine = singleStreamEngine())
+  {
+    QMetaObject::invokeMethod(engine, [engine, replaySpeed]()
+    {
+      engine->setReplaySpeed(replaySpeed);
+    }, Qt::QueuedConnection);
+  }
+
+  emit replaySpeedChanged();
+}
+
+bool MessageSimulatorController::isRewriteTimes() const
+{
+  return m_rewriteTimes;
+}
+
+void MessageSimulatorController::setRewriteTimes(bool rewriteTimes)
+{
+  if (m_rewriteTimes == rewriteTimes)
+    return;
+
+  // takes effect when the next simulation starts
+  m_rewriteTimes = rewriteTimes;
+
+  emit rewriteTimesChanged();
+}
+
+bool MessageSimulatorController::isDeterministic() const
+{
+  return m_deterministic;
+}
+
+void MessageSimulatorController::setDeterministic(bool deterministic)
+{
+  if (m_deterministic == deterministic)
+    return;
+
+  // takes effect when the next simulation starts
+  m_deterministic = deterministic;
+
+  emit deterministicChanged();
+}
+
+int MessageSimulatorController::seed() const
+{
+  return m_seed;
+}
+
+void MessageSimulatorController::setSeed(int seed)
+{
+  if (m_seed == seed)
+    return;
+
+  m_seed = seed;
+
+  emit seedChanged();
+}
+
+double MessageSimulatorController::jitter() const
+{
+  return m_jitter;
+}
+
+void MessageSimulatorController::setJitter(double jitter)
+{
+  jitter = std::clamp(jitter, 0.0, 1.0);
+  if (m_jitter == jitter)
+    return;
+
+  m_jitter = jitter;
+
+  emit jitterChanged();
+}
+
+QString MessageSimulatorController::statisticsFile() const
+{
+  return m_statisticsFile;
+}
+
+void MessageSimulatorController::setStatisticsFile(const QString& statisticsFile)
+{
+  const QString filePath = statisticsFile.trimmed();
+  if (m_statisticsFile == filePath)
+    return;
+
+  // takes effect when the next simulation starts
+  m_statisticsFile = filePath;
+
+  emit statisticsFileChanged();
+}
+
+QList<QPointF> MessageSimulatorController::rateProfile() const
+{
+  return m_rateProfile;
+}
+
+void MessageSimulatorController::setRateProfile(const QList<QPointF>& rateProfile)
+{
+  m_rateProfile = rateProfile;
+
+  // the engine interpolates between points in time order
+  std::sort(m_rateProfile.begin(), m_rateProfile.end(), [](const QPointF& a, const QPointF& b)
+  {
+    return a.x() < b.x();
+  });
+}
+
 void MessageSimulatorController::startSimulation(const QUrl& file)
 {
   // first stop the simulation if it was already running
   stopSimulation();
+  discardStreams();
 
-  // create UDP connection to broadcast address with specified port
-  m_udpSocket = new QUdpSocket(this);
-  m_udpSocket->connectToHost(QHostAddress::Broadcast, m_port, QIODevice::WriteOnly);
-  m_dataSender->setDevice(m_udpSocket);
-
-  if (m_messageParser)
-    delete m_messageParser;
+  const QString filePath = file.toLocalFile();
+  const bool streamSet = isStreamSetFile(filePath);
 
-  // create a message parser with specified input file
-  m_messageParser = AbstractMessageParser::createMessageParser(file.toLocalFile(), this);
-  if (!m_messageParser)
+  std::vector<Stream> streams;
+  if (streamSet)
   {
-    emit errorOccurred(tr("Failed to create message parser with input file"));
-    return;
+    if (!readStreamSet(filePath, streams))
+      return;
+  }
+  else
+  {
+    Stream stream;
+    stream.name = QFileInfo(filePath).completeBaseName();
+    stream.file = file;
+    stream.settings = sendSettings();
+    streams.push_back(stream);
   }
 
-  connect(m_messageParser, &AbstractMessageParser::errorOccurred, this, &MessageSimulatorController::errorOccurred);
+  // create a message parser for every stream before any starts, so a bad file starts nothing
+  std::vector<AbstractMessageParser*> messageParsers;
+  for (const Stream& stream : streams)
+  {
+    AbstractMessageParser* messageParser = AbstractMessageParser::createMessageParser(stream.file.toLocalFile());
+    if (!messageParser)
+    {
+      emit errorOccurred(streamSet ? tr("Failed to create message parser with input file ") + stream.file.toLocalFile()
+                                   : tr("Failed to create message parser with input file"));
+      qDeleteAll(messageParsers);
+      return;
+    }
+
+    messageParsers.push_back(messageParser);
+  }
 
   // clear the messages model
   m_messages->clear();
@@ -228,19 +531,33 @@ void MessageSimulatorController::startSimulation(const QUrl& file)
   }
 
   m_simulationState = SimulationState::Running;
-  setMessageFrequency(m_messageFrequency);
   m_messagesSent = 0;
+  m_achievedRate = 0.0;
+  m_smoothedRate = 0.0;
+  m_saturated = false;
+  m_statisticsHistory.clear();
+  m_summary.clear();
+  m_streamSet = streamSet;
+  m_streams = std::move(streams);
+
+  openStatisticsFile();
+
+  for (size_t i = 0; i < m_streams.size(); ++i)
+    startStream(m_streams[i], messageParsers[i]);
 
   emit simulationStateChanged();
+  emit statisticsChanged();
 
   // save app settings for next time the app is launched
-  saveSettings();
+  if (m_persistSettings)
+    saveSettings();
 }
 
 void MessageSimulatorController::pauseSimulation()
 {
   m_simulationState = SimulationState::Paused;
-  m_timer.stop();
+  for (const Stream& stream : m_streams)
+    QMetaObject::invokeMethod(stream.engine, &MessageSendEngine::pause, Qt::QueuedConnection);
 
   emit simulationStateChanged();
 }
@@ -248,7 +565,8 @@ void MessageSimulatorController::pauseSimulation()
 void MessageSimulatorController::resumeSimulation()
 {
   m_simulationState = SimulationState::Running;
-  setMessageFrequency(m_messageFrequency);
+  for (const Stream& stream : m_streams)
+    QMetaObject::invokeMethod(stream.engine, &MessageSendEngine::resume, Qt::QueuedConnection);
 
   emit simulationStateChanged();
 }
@@ -259,24 +577,384 @@ void MessageSimulatorController::stopSimulation()
   if (m_simulationState == SimulationState::Stopped)
     return;
 
-  m_timer.stop();
   m_simulationState = SimulationState::Stopped;
+  for (const Stream& stream : m_streams)
+    QMetaObject::invokeMethod(stream.engine, &MessageSendEngine::stop, Qt::QueuedConnection);
+
+  emit simulationStateChanged();
+}
 
-  if (m_udpSocket)
+void MessageSimulatorController::sendMessage(const QString& message)
+{
+  // sent on the socket of the first stream
+  if (m_streams.empty())
+    return;
+
+  QMetaObject::invokeMethod(m_streams.front().engine, [engine = m_streams.front().engine, data = message.toUtf8()]()
   {
-    if (m_udpSocket->isOpen())
-      m_udpSocket->close();
+    engine->sendMessage(data);
+  }, Qt::QueuedConnection);
+}
+
+bool MessageSimulatorController::isStreamSetFile(const QString& filePath)
+{
+  QFile file(filePath);
+  if (!file.open(QFile::ReadOnly))
+    return false;
 
-    delete m_udpSocket;
-    m_udpSocket = nullptr;
+  // only JSON documents are candidates, so XML message files are never read in full here
+  if (!file.peek(64).trimmed().startsWith('{'))
+    return false;
+
+  const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+  return document.isObject() && document.object().value(QStringLiteral("streams")).isArray();
+}
+
+bool MessageSimulatorController::readStreamSet(const QString& filePath, std::vector<Stream>& streams)
+{
+  QFile file(filePath);
+  if (!file.open(QFile::ReadOnly))
+  {
+    emit errorOccurred(tr("Could not open ") + filePath + tr(" for reading"));
+    return false;
   }
 
-  emit simulationStateChanged();
+  const QJsonArray streamArray = QJsonDocument::fromJson(file.readAll()).object().value(QStringLiteral("streams")).toArray();
+  if (streamArray.isEmpty())
+  {
+    emit errorOccurred(tr("Stream set file contains no streams"));
+    return false;
+  }
+
+  // stream files are relative to the stream set, and unset values come from the current settings
+  const QDir directory = QFileInfo(filePath).absoluteDir();
+  const SendSettings defaults = sendSettings();
+
+  for (const QJsonValue& value : streamArray)
+  {
+    const QJsonObject object = value.toObject();
+
+    Stream stream;
+    const QString streamFile = object.value(QStringLiteral("file")).toString();
+    stream.file = QUrl::fromLocalFile(directory.absoluteFilePath(streamFile));
+    stream.name = object.value(QStringLiteral("name")).toString(QFileInfo(streamFile).completeBaseName());
+
+    SendSettings& settings = stream.settings;
+    settings = defaults;
+    settings.port = object.value(QStringLiteral("port")).toInt(defaults.port);
+    settings.sendBufferSize = object.value(QStringLiteral("sendBufferSize")).toInt(defaults.sendBufferSize);
+    if (object.contains(QStringLiteral("address")))
+      settings.address = QHostAddress(object.value(QStringLiteral("address")).toString());
+    settings.messagesPerSecond = object.value(QStringLiteral("messagesPerSecond")).toDouble(defaults.messagesPerSecond);
+    settings.looped = object.value(QStringLiteral("loop")).toBool(defaults.looped);
+    settings.loopCount = object.value(QStringLiteral("loopCount")).toInt(defaults.loopCount);
+    settings.duration = object.value(QStringLiteral("duration")).toDouble(defaults.duration);
+    settings.rewriteTimes = object.value(QStringLiteral("rewriteTimes")).toBool(defaults.rewriteTimes);
+
+    // a stream with a seed is deterministic
+    if (object.contains(QStringLiteral("seed")))
+    {
+      settings.deterministic = true;
+      settings.seed = static_cast<quint32>(object.value(QStringLiteral("seed")).toInteger());
+    }
+    settings.jitter = std::clamp(object.value(QStringLiteral("jitter")).toDouble(defaults.jitter), 0.0, 1.0);
+
+    if (object.contains(QStringLiteral("replaySpeed")))
+    {
+      settings.timestampReplay = true;
+      settings.replaySpeed = object.value(QStringLiteral("replaySpeed")).toDouble(1.0);
+    }
+
+    if (object.contains(QStringLiteral("rateProfile")))
+    {
+      settings.rateProfile.clear();
+      const QJsonArray points = object.value(QStringLiteral("rateProfile")).toArray();
+      for (const QJsonValue& point : points)
+        settings.rateProfile.append(QPointF(point.toArray().at(0).toDouble(), point.toArray().at(1).toDouble()));
+
+      std::sort(settings.rateProfile.begin(), settings.rateProfile.end(), [](const QPointF& a, const QPointF& b)
+      {
+        return a.x() < b.x();
+      });
+    }
+
+    if (streamFile.isEmpty() || settings.port < 0 || settings.address.isNull() || settings.messagesPerSecond <= 0.0 ||
+        (settings.timestampReplay && settings.replaySpeed <= 0.0))
+    {
+      emit errorOccurred(tr("Stream %1 needs a file, a port, a valid address and positive rates").arg(stream.name));
+      return false;
+    }
+
+    streams.push_back(stream);
+  }
+
+  return true;
 }
 
-void MessageSimulatorController::sendMessage(const QString& message)
+void MessageSimulatorController::startStream(Stream& stream, AbstractMessageParser* messageParser)
+{
+  MessageSendEngine* engine = new MessageSendEngine(m_socketPool);
+  stream.engine = engine;
+
+  // the engine lives on the send thread and is deleted when its stream is discarded
+  engine->moveToThread(&m_sendThread);
+
+  // the model keeps a bounded, sampled history of all streams and only parses the messages which are displayed
+  connect(engine, &MessageSendEngine::messageSent, m_messages, &SimulatedMessageListModel::append);
+
+  // statistics from streams of an earlier simulation are ignored
+  connect(engine, &MessageSendEngine::statisticsUpdated, this, [this, engine](qint64 messagesSent, double achievedRate, double smoothedRate,
+                                                                             qint64 sendFailures)
+  {
+    Stream* stream = findStream(engine);
+    if (!stream)
+      return;
+
+    stream->messagesSent = messagesSent;
+    stream->achievedRate = achievedRate;
+    stream->smoothedRate = smoothedRate;
+    stream->sendFailures = sendFailures;
+    updateStatistics();
+  });
+
+  // each window arrives just before the statistics update that closes it
+  connect(engine, &MessageSendEngine::intervalStatisticsUpdated, this, [this, engine](const QVariantMap& statistics)
+  {
+    Stream* stream = findStream(engine);
+    if (!stream)
+      return;
+
+    stream->lastInterval = statistics;
+    addIntervalStatistics(*stream, statistics);
+  });
+
+  connect(engine, &MessageSendEngine::stopped, this, [this, engine](const QVariantMap& summary)
+  {
+    Stream* stream = findStream(engine);
+    if (!stream)
+      return;
+
+    stream->summary = summary;
+    stream->stopped = true;
+    updateStatistics();
+
+    if (allStreamsStopped())
+    {
+      m_statisticsCsv.close();
+      updateSummary();
+    }
+  });
+
+  // the simulation stops once every stream has run to its end
+  connect(engine, &MessageSendEngine::finished, this, [this, engine]()
+  {
+    if (findStream(engine) && allStreamsStopped())
+      stopSimulation();
+  });
+
+  auto forwardError = [this, engine](const QString& error)
+  {
+    const Stream* stream = findStream(engine);
+    emit errorOccurred(m_streamSet && stream ? stream->name + QStringLiteral(": ") + error : error);
+  };
+  connect(engine, &MessageSendEngine::errorOccurred, this, forwardError);
+  connect(messageParser, &AbstractMessageParser::errorOccurred, this, forwardError);
+
+  // hand the parser over to the send thread, which takes ownership of it
+  messageParser->moveToThread(&m_sendThread);
+  QMetaObject::invokeMethod(engine, [engine, messageParser, settings = stream.settings]()
+  {
+    engine->start(messageParser, settings);
+  }, Qt::QueuedConnection);
+}
+
+void MessageSimulatorController::discardStreams()
+{
+  // each engine is deleted on the send thread after any stop already queued for it
+  for (const Stream& stream : m_streams)
+    stream.engine->deleteLater();
+
+  m_streams.clear();
+}
+
+MessageSimulatorController::Stream* MessageSimulatorController::findStream(MessageSendEngine* engine)
 {
-  m_dataSender->sendData(message.toUtf8());
+  auto it = std::find_if(m_streams.begin(), m_streams.end(), [engine](const Stream& stream)
+  {
+    return stream.engine == engine;
+  });
+
+  return it != m_streams.end() ? &(*it) : nullptr;
+}
+
+MessageSendEngine* MessageSimulatorController::singleStreamEngine() const
+{
+  // changes made while running apply to a single simulated file; a stream set keeps its own settings
+  if (m_simulationState == SimulationState::Stopped || m_streamSet || m_streams.size() != 1)
+    return nullptr;
+
+  return m_streams.front().engine;
+}
+
+bool MessageSimulatorController::allStreamsStopped() const
+{
+  return std::all_of(m_streams.cbegin(), m_streams.cend(), [](const Stream& stream)
+  {
+    return stream.stopped;
+  });
+}
+
+void MessageSimulatorController::updateStatistics()
+{
+  m_messagesSent = 0;
+  m_achievedRate = 0.0;
+  m_smoothedRate = 0.0;
+  m_saturated = false;
+  for (const Stream& stream : m_streams)
+  {
+    m_messagesSent += stream.messagesSent;
+    m_achievedRate += stream.achievedRate;
+    m_smoothedRate += stream.smoothedRate;
+
+    // one stream that cannot keep up means the simulator is the bottleneck
+    if (!stream.stopped && stream.lastInterval.value(QStringLiteral("saturated")).toBool())
+      m_saturated = true;
+  }
+
+  emit statisticsChanged();
+}
+
+void MessageSimulatorController::addIntervalStatistics(const Stream& stream, const QVariantMap& statistics)
+{
+  QVariantMap entry = statistics;
+  entry.insert(QStringLiteral("name"), stream.name);
+  m_statisticsHistory.append(entry);
+
+  if (m_statisticsHistory.size() > c_statisticsHistoryLength)
+    m_statisticsHistory.removeFirst();
+
+  if (m_statisticsCsv.isOpen())
+    writeStatisticsRow(stream, statistics);
+}
+
+void MessageSimulatorController::openStatisticsFile()
+{
+  m_statisticsCsv.close();
+  if (m_statisticsFile.isEmpty())
+    return;
+
+  m_statisticsCsv.setFileName(m_statisticsFile);
+  if (!m_statisticsCsv.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+  {
+    emit errorOccurred(tr("Could not open ") + m_statisticsFile + tr(" for writing statistics"));
+    return;
+  }
+
+  m_statisticsCsv.write("timestamp,stream,port,time,seconds,messagesSent,achievedRate,smoothedRate,targetRate,bytesSent,bytesPerSecond,"
+                        "sendFailures,droppedMessages,latencyCount,latencyP50Us,latencyP90Us,latencyP99Us,latencyMaxUs,saturated\n");
+  m_statisticsCsv.flush();
+}
+
+void MessageSimulatorController::writeStatisticsRow(const Stream& stream, const QVariantMap& statistics)
+{
+  const QVariantMap latency = statistics.value(QStringLiteral("sendLatency")).toMap();
+
+  QStringList fields;
+  fields << QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs)
+         << csvField(stream.name)
+         << QString::number(stream.settings.port);
+
+  for (const QString& key : {QStringLiteral("time"), QStringLiteral("seconds"), QStringLiteral("messagesSent"), QStringLiteral("achievedRate"),
+                             QStringLiteral("smoothedRate"), QStringLiteral("targetRate"), QStringLiteral("bytesSent"),
+                             QStringLiteral("bytesPerSecond"), QStringLiteral("sendFailures"), QStringLiteral("droppedMessages")})
+  {
+    fields << statistics.value(key).toString();
+  }
+
+  for (const QString& key : {QStringLiteral("count"), QStringLiteral("p50Us"), QStringLiteral("p90Us"), QStringLiteral("p99Us"), QStringLiteral("maxUs")})
+    fields << latency.value(key).toString();
+
+  fields << (statistics.value(QStringLiteral("saturated")).toBool() ? QStringLiteral("1") : QStringLiteral("0"));
+
+  // flushed every window so the file can be followed while the simulation runs
+  m_statisticsCsv.write(fields.join(QLatin1Char(',')).toUtf8() + '\n');
+  m_statisticsCsv.flush();
+}
+
+void MessageSimulatorController::updateSummary()
+{
+  if (m_streams.size() == 1)
+  {
+    m_summary = m_streams.front().summary;
+
+    emit summaryChanged();
+    return;
+  }
+
+  // totals over all streams, with each stream's own summary alongside
+  qint64 messagesSent = 0;
+  qint64 bytesSent = 0;
+  qint64 sendFailures = 0;
+  qint64 emptyMessages = 0;
+  qint64 droppedMessages = 0;
+  double elapsedSeconds = 0.0;
+  double achievedRate = 0.0;
+  double smoothedRate = 0.0;
+  QVariantList streamSummaries;
+
+  for (const Stream& stream : m_streams)
+  {
+    QVariantMap streamSummary = stream.summary;
+    messagesSent += streamSummary.value(QStringLiteral("messagesSent")).toLongLong();
+    bytesSent += streamSummary.value(QStringLiteral("bytesSent")).toLongLong();
+    sendFailures += streamSummary.value(QStringLiteral("sendFailures")).toLongLong();
+    emptyMessages += streamSummary.value(QStringLiteral("emptyMessages")).toLongLong();
+    droppedMessages += streamSummary.value(QStringLiteral("droppedMessages")).toLongLong();
+    elapsedSeconds = std::max(elapsedSeconds, streamSummary.value(QStringLiteral("elapsedSeconds")).toDouble());
+    achievedRate += streamSummary.value(QStringLiteral("achievedRate")).toDouble();
+    smoothedRate += streamSummary.value(QStringLiteral("smoothedRate")).toDouble();
+
+    streamSummary.insert(QStringLiteral("name"), stream.name);
+    streamSummary.insert(QStringLiteral("simulationFile"), stream.file.toLocalFile());
+    streamSummary.insert(QStringLiteral("port"), stream.settings.port);
+    streamSummaries.append(streamSummary);
+  }
+
+  m_summary.clear();
+  m_summary.insert(QStringLiteral("messagesSent"), messagesSent);
+  m_summary.insert(QStringLiteral("bytesSent"), bytesSent);
+  m_summary.insert(QStringLiteral("elapsedSeconds"), elapsedSeconds);
+  m_summary.insert(QStringLiteral("averageRate"), elapsedSeconds > 0.0 ? messagesSent / elapsedSeconds : 0.0);
+  m_summary.insert(QStringLiteral("achievedRate"), achievedRate);
+  m_summary.insert(QStringLiteral("smoothedRate"), smoothedRate);
+  m_summary.insert(QStringLiteral("sendFailures"), sendFailures);
+  m_summary.insert(QStringLiteral("emptyMessages"), emptyMessages);
+  m_summary.insert(QStringLiteral("droppedMessages"), droppedMessages);
+  m_summary.insert(QStringLiteral("streams"), streamSummaries);
+
+  emit summaryChanged();
+}
+
+SendSettings MessageSimulatorController::sendSettings() const
+{
+  SendSettings settings;
+  if (!m_destinationAddress.isEmpty())
+    settings.address = QHostAddress(m_destinationAddress);
+  settings.port = m_port;
+  settings.sendBufferSize = m_sendBufferSize;
+  settings.messagesPerSecond = messagesPerSecond();
+  settings.looped = m_simulationLooped;
+  settings.loopCount = m_loopCount;
+  settings.duration = m_duration;
+  settings.rateProfile = m_rateProfile;
+  settings.timestampReplay = m_timestampReplay;
+  settings.replaySpeed = m_replaySpeed;
+  settings.rewriteTimes = m_rewriteTimes;
+  settings.deterministic = m_deterministic;
+  settings.seed = static_cast<quint32>(m_seed);
+  settings.jitter = m_jitter;
+
+  return settings;
 }
 
 void MessageSimulatorController::saveSettings()
@@ -284,9 +962,20 @@ void MessageSimulatorController::saveSettings()
   QSettings settings;
   settings.setValue("simulationFile", m_simulationFile);
   settings.setValue("port", m_port);
+  settings.setValue("destinationAddress", m_destinationAddress);
+  settings.setValue("sendBufferSize", m_sendBufferSize);
   settings.setValue("messageFrequency", m_messageFrequency);
   settings.setValue("timeUnit", fromTimeUnit(m_timeUnit));
   settings.setValue("loop", m_simulationLooped);
+  settings.setValue("messageHistoryDepth", messageHistoryDepth());
+  settings.setValue("messageSampleInterval", messageSampleInterval());
+  settings.setValue("timestampReplay", m_timestampReplay);
+  settings.setValue("replaySpeed", m_replaySpeed);
+  settings.setValue("rewriteTimes", m_rewriteTimes);
+  settings.setValue("deterministic", m_deterministic);
+  settings.setValue("seed", m_seed);
+  settings.setValue("jitter", m_jitter);
+  settings.setValue("statisticsFile", m_statisticsFile);
 }
 
 void MessageSimulatorController::loadSettings()
@@ -294,9 +983,20 @@ void MessageSimulatorController::loadSettings()
   QSettings settings;
   setSimulationFile(settings.value("simulationFile", QUrl()).toUrl());
   setPort(settings.value("port", -1).toInt());
+  setDestinationAddress(settings.value("destinationAddress", QString()).toString());
+  setSendBufferSize(settings.value("sendBufferSize", 0).toInt());
   setMessageFrequency(settings.value("messageFrequency", 1.0f).toFloat());
   setTimeUnit(toTimeUnit(settings.value("timeUnit", "seconds").toString()));
   setSimulationLooped(settings.value("loop", true).toBool());
+  setMessageHistoryDepth(settings.value("messageHistoryDepth", SimulatedMessageListModel::DefaultCapacity).toInt());
+  setMessageSampleInterval(settings.value("messageSampleInterval", 1).toInt());
+  setTimestampReplay(settings.value("timestampReplay", false).toBool());
+  setReplaySpeed(settings.value("replaySpeed", 1.0).toDouble());
+  setRewriteTimes(settings.value("rewriteTimes", false).toBool());
+  setDeterministic(settings.value("deterministic", false).toBool());
+  setSeed(settings.value("seed", 0).toInt());
+  setJitter(settings.value("jitter", 0.0).toDouble());
+  setStatisticsFile(settings.value("statisticsFile", QString()).toString());
 }
 
 QString MessageSimulatorController::fromTimeUnit(TimeUnit timeUnit)
@@ -327,6 +1027,11 @@ MessageSimulatorController::TimeUnit MessageSimulatorController::toTimeUnit(cons
   return TimeUnit::Seconds; // default to seconds
 }
 
+double MessageSimulatorController::messagesPerSecond() const
+{
+  return m_messageFrequency / timeUnitToSeconds(m_timeUnit);
+}
+
 float MessageSimulatorController::timeUnitToSeconds(TimeUnit timeUnit)
 {
   switch (timeUnit)
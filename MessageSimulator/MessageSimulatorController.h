@@ -17,20 +17,23 @@
 #ifndef MESSAGESIMULATORCONTROLLER_H
 #define MESSAGESIMULATORCONTROLLER_H
 
+// dsa app headers
+#include "MessageSendEngine.h"
 
 // Qt headers
 #include <QAbstractListModel>
+#include <QFile>
 #include <QObject>
-#include <QTimer>
-#include <QUdpSocket>
+#include <QPointF>
+#include <QThread>
 #include <QUrl>
 
-namespace Dsa {
-class DataSender;
-}
+// STL headers
+#include <vector>
 
 class AbstractMessageParser;
 class SimulatedMessageListModel;
+class UdpSocketPool;
 
 class MessageSimulatorController : public QObject
 {
@@ -39,10 +42,30 @@ class MessageSimulatorController : public QObject
   Q_PROPERTY(QUrl simulationFile READ simulationFile NOTIFY simulationFileChanged)
   Q_PROPERTY(SimulationState simulationState READ simulationState NOTIFY simulationStateChanged)
   Q_PROPERTY(int port READ port WRITE setPort NOTIFY portChanged)
+  Q_PROPERTY(QString destinationAddress READ destinationAddress WRITE setDestinationAddress NOTIFY destinationAddressChanged)
+  Q_PROPERTY(int sendBufferSize READ sendBufferSize WRITE setSendBufferSize NOTIFY sendBufferSizeChanged)
   Q_PROPERTY(bool simulationLooped READ isSimulationLooped WRITE setSimulationLooped NOTIFY simulationLoopedChanged)
   Q_PROPERTY(float messageFrequency READ messageFrequency WRITE setMessageFrequency NOTIFY messageFrequencyChanged)
   Q_PROPERTY(TimeUnit timeUnit READ timeUnit WRITE setTimeUnit NOTIFY timeUnitChanged)
   Q_PROPERTY(QAbstractListModel* messages READ messages NOTIFY messagesChanged)
+  Q_PROPERTY(int messageHistoryDepth READ messageHistoryDepth WRITE setMessageHistoryDepth NOTIFY messageHistoryDepthChanged)
+  Q_PROPERTY(int messageSampleInterval READ messageSampleInterval WRITE setMessageSampleInterval NOTIFY messageSampleIntervalChanged)
+  Q_PROPERTY(qint64 messagesSent READ messagesSent NOTIFY statisticsChanged)
+  Q_PROPERTY(double achievedRate READ achievedRate NOTIFY statisticsChanged)
+  Q_PROPERTY(double smoothedRate READ smoothedRate NOTIFY statisticsChanged)
+  Q_PROPERTY(bool saturated READ isSaturated NOTIFY statisticsChanged)
+  Q_PROPERTY(QVariantList streamStatistics READ streamStatistics NOTIFY statisticsChanged)
+  Q_PROPERTY(QVariantList statisticsHistory READ statisticsHistory NOTIFY statisticsChanged)
+  Q_PROPERTY(QString statisticsFile READ statisticsFile WRITE setStatisticsFile NOTIFY statisticsFileChanged)
+  Q_PROPERTY(QVariantMap summary READ summary NOTIFY summaryChanged)
+  Q_PROPERTY(int loopCount READ loopCount WRITE setLoopCount NOTIFY loopCountChanged)
+  Q_PROPERTY(double duration READ duration WRITE setDuration NOTIFY durationChanged)
+  Q_PROPERTY(bool timestampReplay READ isTimestampReplay WRITE setTimestampReplay NOTIFY timestampReplayChanged)
+  Q_PROPERTY(double replaySpeed READ replaySpeed WRITE setReplaySpeed NOTIFY replaySpeedChanged)
+  Q_PROPERTY(bool rewriteTimes READ isRewriteTimes WRITE setRewriteTimes NOTIFY rewriteTimesChanged)
+  Q_PROPERTY(bool deterministic READ isDeterministic WRITE setDeterministic NOTIFY deterministicChanged)
+  Q_PROPERTY(int seed READ seed WRITE setSeed NOTIFY seedChanged)
+  Q_PROPERTY(double jitter READ jitter WRITE setJitter NOTIFY jitterChanged)
 
 public:
   enum class TimeUnit
@@ -63,6 +86,8 @@ public:
   Q_ENUM(SimulationState)
 
   explicit MessageSimulatorController(QObject* parent = nullptr);
+  // console runs pass false so they neither load nor overwrite the GUI settings
+  explicit MessageSimulatorController(bool persistSettings, QObject* parent = nullptr);
   ~MessageSimulatorController();
 
   QUrl simulationFile() const;
@@ -71,6 +96,12 @@ public:
   void setPort(int port);
   int port() const;
 
+  QString destinationAddress() const;
+  void setDestinationAddress(const QString& destinationAddress);
+
+  int sendBufferSize() const;
+  void setSendBufferSize(int sendBufferSize);
+
   void setMessageFrequency(float messageFrequency);
   float messageFrequency() const;
 
@@ -84,6 +115,50 @@ public:
 
   QAbstractListModel* messages() const;
 
+  int messageHistoryDepth() const;
+  void setMessageHistoryDepth(int messageHistoryDepth);
+
+  int messageSampleInterval() const;
+  void setMessageSampleInterval(int messageSampleInterval);
+
+  qint64 messagesSent() const;
+  double achievedRate() const;
+  double smoothedRate() const;
+  bool isSaturated() const;
+  QVariantList streamStatistics() const;
+  QVariantList statisticsHistory() const;
+  QVariantMap summary() const;
+
+  int loopCount() const;
+  void setLoopCount(int loopCount);
+
+  double duration() const;
+  void setDuration(double duration);
+
+  bool isTimestampReplay() const;
+  void setTimestampReplay(bool timestampReplay);
+
+  double replaySpeed() const;
+  void setReplaySpeed(double replaySpeed);
+
+  bool isRewriteTimes() const;
+  void setRewriteTimes(bool rewriteTimes);
+
+  bool isDeterministic() const;
+  void setDeterministic(bool deterministic);
+
+  int seed() const;
+  void setSeed(int seed);
+
+  double jitter() const;
+  void setJitter(double jitter);
+
+  QString statisticsFile() const;
+  void setStatisticsFile(const QString& statisticsFile);
+
+  QList<QPointF> rateProfile() const;
+  void setRateProfile(const QList<QPointF>& rateProfile);
+
   Q_INVOKABLE void startSimulation(const QUrl& file);
   Q_INVOKABLE void pauseSimulation();
   Q_INVOKABLE void resumeSimulation();
@@ -94,38 +169,116 @@ public:
   Q_INVOKABLE static QString fromTimeUnit(TimeUnit timeUnit);
   Q_INVOKABLE static TimeUnit toTimeUnit(const QString& timeUnit);
 
+  static bool isStreamSetFile(const QString& filePath);
+
 signals:
   void simulationFileChanged();
   void simulationStateChanged();
   void portChanged();
+  void destinationAddressChanged();
+  void sendBufferSizeChanged();
   void simulationLoopedChanged();
   void messageFrequencyChanged();
   void timeUnitChanged();
   void messagesChanged();
+  void messageHistoryDepthChanged();
+  void messageSampleIntervalChanged();
+  void statisticsChanged();
+  void summaryChanged();
+  void loopCountChanged();
+  void durationChanged();
+  void timestampReplayChanged();
+  void replaySpeedChanged();
+  void rewriteTimesChanged();
+  void deterministicChanged();
+  void seedChanged();
+  void jitterChanged();
+  void statisticsFileChanged();
   void errorOccurred(const QString& error);
 
 private:
   Q_DISABLE_COPY(MessageSimulatorController)
 
+  // one file sent to one port; several run at once when a stream set file is simulated
+  struct Stream
+  {
+    QString name;
+    QUrl file;
+    SendSettings settings;
+    MessageSendEngine* engine = nullptr;
+    qint64 messagesSent = 0;
+    double achievedRate = 0.0;
+    double smoothedRate = 0.0;
+    qint64 sendFailures = 0;
+    // the statistics of the stream's last window, about one second long
+    QVariantMap lastInterval;
+    bool stopped = false;
+    QVariantMap summary;
+  };
+
+  bool readStreamSet(const QString& filePath, std::vector<Stream>& streams);
+  void startStream(Stream& stream, AbstractMessageParser* messageParser);
+  void discardStreams();
+  Stream* findStream(MessageSendEngine* engine);
+  MessageSendEngine* singleStreamEngine() const;
+  bool allStreamsStopped() const;
+  void updateStatistics();
+  void addIntervalStatistics(const Stream& stream, const QVariantMap& statistics);
+  void openStatisticsFile();
+  void writeStatisticsRow(const Stream& stream, const QVariantMap& statistics);
+  void updateSummary();
+  SendSettings sendSettings() const;
+
   void saveSettings();
   void loadSettings();
 
+  double messagesPerSecond() const;
+
   static float timeUnitToSeconds(TimeUnit timeUnit);
 
-  Dsa::DataSender* m_dataSender = nullptr;
-  AbstractMessageParser* m_messageParser = nullptr;
   SimulatedMessageListModel* m_messages = nullptr;
 
-  QUdpSocket* m_udpSocket = nullptr;
-  QTimer m_timer;
+  // messages are sent from a dedicated thread so the send rate is not limited by the UI.
+  // Every stream sends from this thread, sharing one socket per port
+  QThread m_sendThread;
+  UdpSocketPool* m_socketPool = nullptr;
+  std::vector<Stream> m_streams;
+  bool m_streamSet = false;
 
   QUrl m_simulationFile;
 
   int m_port = -1;
+  // empty to broadcast
+  QString m_destinationAddress;
+  int m_sendBufferSize = 0;
   float m_messageFrequency = 1;
   qint64 m_messagesSent = 0;
+  double m_achievedRate = 0.0;
+  double m_smoothedRate = 0.0;
+  bool m_saturated = false;
+  QVariantMap m_summary;
+
+  // the most recent statistics windows of every stream, oldest first
+  QVariantList m_statisticsHistory;
+
+  // every window is also written to this CSV file when one is set
+  QString m_statisticsFile;
+  QFile m_statisticsCsv;
+
+  int m_loopCount = 0;
+  double m_duration = 0.0;
+  QList<QPointF> m_rateProfile;
+
+  bool m_timestampReplay = false;
+  double m_replaySpeed = 1.0;
+  bool m_rewriteTimes = false;
+
+  bool m_deterministic = false;
+  int m_seed = 0;
+  double m_jitter = 0.0;
 
   bool m_simulationLooped = true;
+  bool m_persistSettings = true;
   SimulationState m_simulationState = SimulationState::Stopped;
 
   TimeUnit m_timeUnit = TimeUnit::Seconds;
@@ -0,0 +1,390 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "ScenarioMessageParser.h"
+
+// DSA headers
+#include "Geodesy.h"
+
+// Qt headers
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// STL headers
+#include <cmath>
+
+namespace
+{
+  const double c_headingJitter = 20.0; // degrees per random walk update
+  const double c_minimumStaleSeconds = 60.0;
+  const char* const c_defaultStartTime = "2020-01-01T00:00:00Z";
+  const int c_uidWidth = 6;
+
+  QByteArray makePayload(int size)
+  {
+    static const char c_characters[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    QByteArray payload(qMax(size, 0), Qt::Uninitialized);
+    for (int i = 0; i < payload.size(); ++i)
+      payload[i] = c_characters[i % (sizeof(c_characters) - 1)];
+
+    return payload;
+  }
+
+  QByteArray entityUid(int index)
+  {
+    return QByteArrayLiteral("scenario-") + QByteArray::number(index).rightJustified(c_uidWidth, '0');
+  }
+
+  QByteArray coordinate(double value)
+  {
+    return QByteArray::number(value, 'f', 7);
+  }
+} // namespace
+
+ScenarioMessageParser::ScenarioMessageParser(const QString& filePath, QObject* parent) :
+  AbstractMessageParser(filePath, parent)
+{
+}
+
+ScenarioMessageParser::~ScenarioMessageParser()
+{
+}
+
+bool ScenarioMessageParser::isScenarioFile(const QString& filePath)
+{
+  QFile file(filePath);
+  if (!file.open(QFile::ReadOnly))
+    return false;
+
+  // only JSON documents are candidates, so XML message files are never read in full here
+  if (!file.peek(64).trimmed().startsWith('{'))
+    return false;
+
+  const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+  return document.isObject() && document.object().value(QStringLiteral("scenario")).isObject();
+}
+
+QByteArray ScenarioMessageParser::nextMessage()
+{
+  // the scenario is read and the entities created the first time a message is needed
+  if (!m_loaded && !loadScenario())
+    return QByteArray();
+
+  if (m_updates.empty())
+  {
+    emit errorOccurred(tr("The scenario contains no entities"));
+    return QByteArray();
+  }
+
+  const Update update = m_updates.top();
+  m_updates.pop();
+
+  Entity& entity = m_entities[update.second];
+  const Group& group = m_groups[entity.group];
+  const QByteArray message = m_format == MessageFormat::CoT ? cotMessage(update.second, entity, group, update.first)
+                                                            : geoMessage(update.second, entity, group);
+
+  // move the entity on to where it will be at its next update
+  const double interval = 1.0 / group.updateRate;
+  advance(entity, interval);
+  m_updates.emplace(update.first + interval, update.second);
+
+  return message;
+}
+
+void ScenarioMessageParser::reset()
+{
+  // restart from the seeded initial positions so every loop is identical
+  if (m_loaded)
+    createEntities();
+}
+
+bool ScenarioMessageParser::atEnd() const
+{
+  return m_loaded && m_entities.empty();
+}
+
+void ScenarioMessageParser::setSeed(quint32 seed)
+{
+  // a seed in the scenario file still takes precedence
+  m_seeded = true;
+  m_runSeed = seed;
+}
+
+int ScenarioMessageParser::entityCount() const
+{
+  return static_cast<int>(m_entities.size());
+}
+
+bool ScenarioMessageParser::loadScenario()
+{
+  m_loaded = true;
+
+  QFile file(filePath());
+  if (!file.open(QFile::ReadOnly))
+  {
+    emit errorOccurred(tr("Could not open ") + filePath() + tr(" for reading"));
+    return false;
+  }
+
+  QJsonParseError parseError;
+  const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+  if (parseError.error != QJsonParseError::NoError)
+  {
+    emit errorOccurred(tr("Invalid scenario file: ") + parseError.errorString());
+    return false;
+  }
+
+  const QJsonObject scenario = document.object().value(QStringLiteral("scenario")).toObject();
+
+  const QString format = scenario.value(QStringLiteral("format")).toString(QStringLiteral("cot"));
+  if (format.compare(QStringLiteral("cot"), Qt::CaseInsensitive) == 0)
+    m_format = MessageFormat::CoT;
+  else if (format.compare(QStringLiteral("geomessage"), Qt::CaseInsensitive) == 0)
+    m_format = MessageFormat::GeoMessage;
+  else
+  {
+    emit errorOccurred(tr("Unknown scenario message format: ") + format);
+    return false;
+  }
+
+  const QJsonArray center = scenario.value(QStringLiteral("center")).toArray();
+  if (center.size() >= 2)
+  {
+    m_centerLon = center.at(0).toDouble();
+    m_centerLat = center.at(1).toDouble();
+  }
+  m_radius = scenario.value(QStringLiteral("radius")).toDouble(m_radius);
+
+  // without a seed each run is different, but loops within a run still repeat exactly
+  const QJsonValue seed = scenario.value(QStringLiteral("seed"));
+  if (seed.isDouble())
+    m_seed = static_cast<quint32>(seed.toInteger());
+  else
+    m_seed = m_seeded ? m_runSeed : std::random_device()();
+
+  // seeded runs count time from a fixed start so that every message is reproducible
+  m_startTime = QDateTime::fromString(scenario.value(QStringLiteral("startTime")).toString(QString::fromLatin1(c_defaultStartTime)),
+                                      Qt::ISODateWithMs);
+  if (!m_startTime.isValid())
+  {
+    emit errorOccurred(tr("Invalid scenario start time"));
+    return false;
+  }
+
+  // a scenario without groups describes a single group with its own keys
+  const QJsonArray groups = scenario.value(QStringLiteral("groups")).toArray();
+  int entityTotal = 0;
+  for (int i = 0; i < qMax(1, static_cast<int>(groups.size())); ++i)
+  {
+    Group group;
+    if (!readGroup(groups.isEmpty() ? scenario : groups.at(i).toObject(), scenario, group))
+      return false;
+
+    if (entityTotal + group.count > MaxEntityCount)
+    {
+      emit errorOccurred(tr("Scenario limited to %1 entities").arg(MaxEntityCount));
+      group.count = MaxEntityCount - entityTotal;
+    }
+
+    entityTotal += group.count;
+    if (group.count > 0)
+      m_groups.push_back(std::move(group));
+  }
+
+  createEntities();
+  return true;
+}
+
+bool ScenarioMessageParser::readGroup(const QJsonObject& object, const QJsonObject& defaults, Group& group)
+{
+  auto value = [&object, &defaults](const QString& key)
+  {
+    return object.contains(key) ? object.value(key) : defaults.value(key);
+  };
+
+  group.count = value(QStringLiteral("count")).toInt(1);
+  group.speed = value(QStringLiteral("speed")).toDouble(group.speed);
+  group.updateRate = value(QStringLiteral("updateRate")).toDouble(group.updateRate);
+  group.cotType = value(QStringLiteral("cotType")).toString(QStringLiteral("a-f-G-U-C")).toUtf8();
+  group.symbolId = value(QStringLiteral("symbolId")).toString(QStringLiteral("SFGPUC---------")).toUtf8();
+  group.messageType = value(QStringLiteral("messageType")).toString(QStringLiteral("position_report_land")).toUtf8();
+  group.payload = makePayload(value(QStringLiteral("payloadSize")).toInt(0));
+
+  if (group.updateRate <= 0.0)
+  {
+    emit errorOccurred(tr("Scenario update rates must be greater than zero"));
+    return false;
+  }
+
+  const QString track = value(QStringLiteral("track")).toString(QStringLiteral("randomWalk"));
+  if (track.compare(QStringLiteral("randomWalk"), Qt::CaseInsensitive) == 0)
+    group.track = TrackType::RandomWalk;
+  else if (track.compare(QStringLiteral("greatCircle"), Qt::CaseInsensitive) == 0)
+    group.track = TrackType::GreatCircle;
+  else if (track.compare(QStringLiteral("orbit"), Qt::CaseInsensitive) == 0)
+    group.track = TrackType::Orbit;
+  else
+  {
+    emit errorOccurred(tr("Unknown scenario track type: ") + track);
+    return false;
+  }
+
+  return true;
+}
+
+void ScenarioMessageParser::createEntities()
+{
+  m_random.seed(m_seed);
+  m_entities.clear();
+
+  std::vector<Update> updates;
+
+  for (int groupIndex = 0; groupIndex < static_cast<int>(m_groups.size()); ++groupIndex)
+  {
+    const Group& group = m_groups[groupIndex];
+    for (int i = 0; i < group.count; ++i)
+    {
+      Entity entity;
+      entity.group = groupIndex;
+
+      switch (group.track)
+      {
+      case TrackType::RandomWalk:
+        randomPoint(entity.lon, entity.lat);
+        entity.heading = 360.0 * m_random.uniform();
+        break;
+      case TrackType::GreatCircle:
+        randomPoint(entity.lon, entity.lat);
+        randomPoint(entity.anchorLon, entity.anchorLat);
+        entity.heading = Dsa::Geodesy::bearingBetween(entity.lon, entity.lat, entity.anchorLon, entity.anchorLat);
+        break;
+      case TrackType::Orbit:
+        randomPoint(entity.anchorLon, entity.anchorLat);
+        entity.orbitRadius = m_radius * (0.05 + 0.2 * m_random.uniform());
+        entity.orbitAngle = 360.0 * m_random.uniform();
+        Dsa::Geodesy::destination(entity.anchorLon, entity.anchorLat, entity.orbitAngle, entity.orbitRadius, entity.lon, entity.lat);
+        entity.heading = Dsa::Geodesy::normalizeBearing(entity.orbitAngle + 90.0);
+        break;
+      }
+
+      // stagger the first updates across one interval so the stream is evenly interleaved
+      updates.emplace_back(m_random.uniform() / group.updateRate, static_cast<int>(m_entities.size()));
+      m_entities.push_back(entity);
+    }
+  }
+
+  m_updates = UpdateQueue(std::greater<Update>(), std::move(updates));
+}
+
+void ScenarioMessageParser::advance(Entity& entity, double seconds)
+{
+  const Group& group = m_groups[entity.group];
+  const double distance = group.speed * seconds;
+
+  switch (group.track)
+  {
+  case TrackType::RandomWalk:
+  {
+    // wander, but head back once outside the scenario area
+    if (Dsa::Geodesy::distanceBetween(m_centerLon, m_centerLat, entity.lon, entity.lat) > m_radius)
+      entity.heading = Dsa::Geodesy::bearingBetween(entity.lon, entity.lat, m_centerLon, m_centerLat);
+    else
+      entity.heading = Dsa::Geodesy::normalizeBearing(entity.heading + m_random.normal(0.0, c_headingJitter));
+
+    Dsa::Geodesy::destination(entity.lon, entity.lat, entity.heading, distance, entity.lon, entity.lat);
+    break;
+  }
+  case TrackType::GreatCircle:
+  {
+    // follow the great circle to the destination, then start a new leg
+    const double remaining = Dsa::Geodesy::distanceBetween(entity.lon, entity.lat, entity.anchorLon, entity.anchorLat);
+    if (distance >= remaining)
+    {
+      entity.lon = entity.anchorLon;
+      entity.lat = entity.anchorLat;
+      randomPoint(entity.anchorLon, entity.anchorLat);
+    }
+    else
+    {
+      Dsa::Geodesy::destination(entity.lon, entity.lat, entity.heading, distance, entity.lon, entity.lat);
+    }
+
+    entity.heading = Dsa::Geodesy::bearingBetween(entity.lon, entity.lat, entity.anchorLon, entity.anchorLat);
+    break;
+  }
+  case TrackType::Orbit:
+  {
+    if (entity.orbitRadius > 0.0)
+      entity.orbitAngle = Dsa::Geodesy::normalizeBearing(entity.orbitAngle + Dsa::Geodesy::toDegrees(distance / entity.orbitRadius));
+
+    Dsa::Geodesy::destination(entity.anchorLon, entity.anchorLat, entity.orbitAngle, entity.orbitRadius, entity.lon, entity.lat);
+    entity.heading = Dsa::Geodesy::normalizeBearing(entity.orbitAngle + 90.0);
+    break;
+  }
+  }
+}
+
+void ScenarioMessageParser::randomPoint(double& lon, double& lat)
+{
+  // uniform over the disc around the scenario centre
+  const double distance = m_radius * std::sqrt(m_random.uniform());
+  Dsa::Geodesy::destination(m_centerLon, m_centerLat, 360.0 * m_random.uniform(), distance, lon, lat);
+}
+
+QByteArray ScenarioMessageParser::cotMessage(int index, const Entity& entity, const Group& group, double simulatedSeconds) const
+{
+  const QDateTime now = m_seeded ? m_startTime.addMSecs(static_cast<qint64>(simulatedSeconds * 1000.0)).toUTC()
+                                 : QDateTime::currentDateTimeUtc();
+  const QByteArray time = now.toString(Qt::ISODateWithMs).toLatin1();
+  const qint64 staleMs = static_cast<qint64>(1000.0 * qMax(c_minimumStaleSeconds, 3.0 / group.updateRate));
+  const QByteArray stale = now.addMSecs(staleMs).toString(Qt::ISODateWithMs).toLatin1();
+
+  QByteArray message;
+  message.reserve(384 + group.payload.size());
+  message += "<event version=\"2.0\" uid=\"" + entityUid(index) + "\" type=\"" + group.cotType +
+      "\" how=\"m-g\" time=\"" + time + "\" start=\"" + time + "\" stale=\"" + stale + "\">";
+  message += "<point lat=\"" + coordinate(entity.lat) + "\" lon=\"" + coordinate(entity.lon) +
+      "\" hae=\"0\" ce=\"10\" le=\"10\"/>";
+  message += "<detail><track course=\"" + QByteArray::number(entity.heading, 'f', 1) + "\" speed=\"" +
+      QByteArray::number(group.speed, 'f', 1) + "\"/>";
+  if (!group.payload.isEmpty())
+    message += "<remarks>" + group.payload + "</remarks>";
+  message += "</detail></event>";
+
+  return message;
+}
+
+QByteArray ScenarioMessageParser::geoMessage(int index, const Entity& entity, const Group& group) const
+{
+  const QByteArray uid = entityUid(index);
+
+  QByteArray message;
+  message.reserve(384 + group.payload.size());
+  message += "<geomessage v=\"1.0\"><_type>" + group.messageType + "</_type><_action>update</_action><_id>" +
+      uid + "</_id><_control_points>" + coordinate(entity.lon) + "," + coordinate(entity.lat) +
+      "</_control_points><_wkid>4326</_wkid><sic>" + group.symbolId + "</sic><uniquedesignation>" + uid +
+      "</uniquedesignation><direction>" + QByteArray::number(entity.heading, 'f', 1) + "</direction>";
+  if (!group.payload.isEmpty())
+    message += "<additionalinformation>" + group.payload + "</additionalinformation>";
+  message += "</geomessage>";
+
+  return message;
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef SCENARIOMESSAGEPARSER_H
+#define SCENARIOMESSAGEPARSER_H
+
+#include "AbstractMessageParser.h"
+#include "SeededRandom.h"
+
+// Qt headers
+#include <QDateTime>
+
+// STL headers
+#include <functional>
+#include <queue>
+#include <vector>
+
+class QJsonObject;
+
+// Generates CoT or GeoMessage traffic for a synthetic set of moving entities
+// described by a JSON scenario file, instead of replaying recorded messages.
+// Each entity is updated at its own rate; messages come out in simulated time order
+// and the stream never ends, so the send engine's rate and duration limits apply.
+class ScenarioMessageParser : public AbstractMessageParser
+{
+  Q_OBJECT
+
+public:
+  static constexpr int MaxEntityCount = 100000;
+
+  explicit ScenarioMessageParser(const QString& filePath, QObject* parent = nullptr);
+  ~ScenarioMessageParser();
+
+  static bool isScenarioFile(const QString& filePath);
+
+  QByteArray nextMessage() override;
+
+  void reset() override;
+
+  bool atEnd() const override;
+
+  void setSeed(quint32 seed) override;
+
+  int entityCount() const;
+
+private:
+  Q_DISABLE_COPY(ScenarioMessageParser)
+  ScenarioMessageParser() = delete;
+
+  enum class MessageFormat
+  {
+    CoT,
+    GeoMessage
+  };
+
+  enum class TrackType
+  {
+    RandomWalk,
+    GreatCircle,
+    Orbit
+  };
+
+  struct Group
+  {
+    int count = 0;
+    TrackType track = TrackType::RandomWalk;
+    double speed = 10.0;      // metres per second
+    double updateRate = 1.0;  // updates per second per entity
+    QByteArray cotType;
+    QByteArray symbolId;
+    QByteArray messageType;
+    QByteArray payload;
+  };
+
+  struct Entity
+  {
+    int group = 0;
+    double lon = 0.0;
+    double lat = 0.0;
+    double heading = 0.0;
+    // orbit centre, or the destination of a great circle leg
+    double anchorLon = 0.0;
+    double anchorLat = 0.0;
+    double orbitRadius = 0.0;
+    double orbitAngle = 0.0;
+  };
+
+  // (simulated update time, entity index), earliest first
+  using Update = std::pair<double, int>;
+  using UpdateQueue = std::priority_queue<Update, std::vector<Update>, std::greater<Update>>;
+
+  bool loadScenario();
+  bool readGroup(const QJsonObject& object, const QJsonObject& defaults, Group& group);
+  void createEntities();
+  void advance(Entity& entity, double seconds);
+  void randomPoint(double& lon, double& lat);
+
+  QByteArray cotMessage(int index, const Entity& entity, const Group& group, double simulatedSeconds) const;
+  QByteArray geoMessage(int index, const Entity& entity, const Group& group) const;
+
+  bool m_loaded = false;
+  MessageFormat m_format = MessageFormat::CoT;
+  double m_centerLon = 0.0;
+  double m_centerLat = 0.0;
+  double m_radius = 10000.0; // metres
+  quint32 m_seed = 0;
+  // a seeded run stamps messages with simulated rather than wall clock time
+  bool m_seeded = false;
+  quint32 m_runSeed = 0;
+  QDateTime m_startTime;
+  std::vector<Group> m_groups;
+  std::vector<Entity> m_entities;
+  UpdateQueue m_updates;
+  SeededRandom m_random;
+};
+
+#endif // SCENARIOMESSAGEPARSER_H
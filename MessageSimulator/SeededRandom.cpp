@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "SeededRandom.h"
+
+// DSA headers
+#include "Geodesy.h"
+
+// STL headers
+#include <cmath>
+
+SeededRandom::SeededRandom(std::uint32_t seed) :
+  m_generator(seed)
+{
+}
+
+void SeededRandom::seed(std::uint32_t seed)
+{
+  m_generator.seed(seed);
+}
+
+// uniform in [0, 1) with 53 random bits, built from two 32 bit draws
+double SeededRandom::uniform()
+{
+  const std::uint64_t high = m_generator() >> 5;
+  const std::uint64_t low = m_generator() >> 6;
+  return static_cast<double>((high << 26) | low) * 0x1p-53;
+}
+
+double SeededRandom::uniform(double minimum, double maximum)
+{
+  return minimum + (maximum - minimum) * uniform();
+}
+
+// Box-Muller; the second value of each pair is discarded so every call draws the same amount
+double SeededRandom::normal(double mean, double standardDeviation)
+{
+  const double u1 = 1.0 - uniform();
+  const double u2 = uniform();
+  return mean + standardDeviation * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * Dsa::Geodesy::Pi * u2);
+}
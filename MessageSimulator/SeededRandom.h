@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef SEEDEDRANDOM_H
+#define SEEDEDRANDOM_H
+
+// STL headers
+#include <cstdint>
+#include <random>
+
+// Random numbers which are the same for a given seed on every platform. Only the
+// output of std::mt19937 is specified by the standard; the distributions are not,
+// so the values are derived from the raw generator output here
+class SeededRandom
+{
+public:
+  explicit SeededRandom(std::uint32_t seed = std::mt19937::default_seed);
+
+  void seed(std::uint32_t seed);
+
+  double uniform();
+  double uniform(double minimum, double maximum);
+  double normal(double mean, double standardDeviation);
+
+private:
+  std::mt19937 m_generator;
+};
+
+#endif // SEEDEDRANDOM_H
@@ -17,8 +17,11 @@
 #include "SimulatedMessageListModel.h"
 #include "SimulatedMessage.h"
 
+#include <algorithm>
+
 SimulatedMessageListModel::SimulatedMessageListModel(QObject* parent) :
-  QAbstractListModel(parent)
+  QAbstractListModel(parent),
+  m_entries(DefaultCapacity)
 {
   setupRoles();
 }
@@ -35,26 +38,78 @@ void SimulatedMessageListModel::setupRoles()
   m_roles[SymbolIdRole] = "symbolId";
 }
 
-void SimulatedMessageListModel::append(SimulatedMessage* message)
+int SimulatedMessageListModel::capacity() const
+{
+  return static_cast<int>(m_entries.size());
+}
+
+void SimulatedMessageListModel::setCapacity(int capacity)
+{
+  capacity = std::max(capacity, 1);
+  if (capacity == this->capacity())
+    return;
+
+  // keep the most recent messages which still fit
+  const int kept = std::min(m_count, capacity);
+  if (kept < m_count)
+    removeRows(0, m_count - kept);
+
+  std::vector<Entry> entries(capacity);
+  for (int row = 0; row < m_count; ++row)
+    entries[row] = std::move(m_entries[entryIndex(row)]);
+
+  m_entries = std::move(entries);
+  m_first = 0;
+}
+
+int SimulatedMessageListModel::sampleInterval() const
+{
+  return m_sampleInterval;
+}
+
+void SimulatedMessageListModel::setSampleInterval(int sampleInterval)
 {
-  if (!message)
+  m_sampleInterval = std::max(sampleInterval, 1);
+}
+
+void SimulatedMessageListModel::append(const QByteArray& message)
+{
+  // only keep 1 in every sampleInterval messages
+  if (m_offered++ % m_sampleInterval != 0)
     return;
 
-  beginInsertRows(QModelIndex(), rowCount(), rowCount());
+  // once full, the oldest message makes way for the new one
+  if (m_count == capacity())
+  {
+    beginRemoveRows(QModelIndex(), 0, 0);
+    m_entries[m_first] = Entry();
+    m_first = (m_first + 1) % capacity();
+    m_count--;
+    endRemoveRows();
+  }
+
+  beginInsertRows(QModelIndex(), m_count, m_count);
 
-  m_messages.append(message);
+  Entry& entry = m_entries[entryIndex(m_count)];
+  entry.data = message;
+  m_count++;
 
   endInsertRows();
 }
 
 void SimulatedMessageListModel::clear()
 {
+  m_offered = 0;
+
   if (rowCount() > 0)
   {
     beginRemoveRows(QModelIndex(), 0, rowCount() - 1);
 
-    qDeleteAll(m_messages);
-    m_messages.clear();
+    for (auto& entry : m_entries)
+      entry = Entry();
+
+    m_first = 0;
+    m_count = 0;
 
     endRemoveRows();
   }
@@ -73,7 +128,7 @@ int SimulatedMessageListModel::rowCount(const QModelIndex& parent) const
   if (parent.isValid())
     return 0;
 
-  return m_messages.size();
+  return m_count;
 }
 
 QVariant SimulatedMessageListModel::data(const QModelIndex& index, int role) const
@@ -83,7 +138,7 @@ QVariant SimulatedMessageListModel::data(const QModelIndex& index, int role) con
 
   QVariant retVal;
 
-  SimulatedMessage* message = m_messages.at(index.row());
+  const SimulatedMessage* message = this->message(index.row());
   if (message)
   {
     switch (role)
@@ -115,13 +170,16 @@ bool SimulatedMessageListModel::removeRows(int row, int count, const QModelIndex
 
   beginRemoveRows(QModelIndex(), row, row + count - 1);
 
-  for (int r = row; r < row + count; ++r)
-  {
-    SimulatedMessage* message = m_messages.at(r);
-    m_messages.removeAt(r);
-    if (message)
-      delete message;
-  }
+  // close the gap by shifting the later rows down, then release the freed entries at the end
+  for (int r = row; r + count < m_count; ++r)
+    m_entries[entryIndex(r)] = std::move(m_entries[entryIndex(r + count)]);
+
+  for (int r = m_count - count; r < m_count; ++r)
+    m_entries[entryIndex(r)] = Entry();
+
+  m_count -= count;
+  if (m_count == 0)
+    m_first = 0;
 
   endRemoveRows();
 
@@ -132,3 +190,21 @@ QHash<int, QByteArray> SimulatedMessageListModel::roleNames() const
 {
   return m_roles;
 }
+
+int SimulatedMessageListModel::entryIndex(int row) const
+{
+  return (m_first + row) % capacity();
+}
+
+const SimulatedMessage* SimulatedMessageListModel::message(int row) const
+{
+  const Entry& entry = m_entries[entryIndex(row)];
+  if (!entry.parsed)
+  {
+    // messages which cannot be parsed are remembered so they are not parsed again
+    entry.message.reset(SimulatedMessage::create(entry.data));
+    entry.parsed = true;
+  }
+
+  return entry.message.get();
+}
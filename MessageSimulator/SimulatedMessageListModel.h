@@ -19,6 +19,9 @@
 
 #include <QAbstractListModel>
 
+#include <memory>
+#include <vector>
+
 class SimulatedMessage;
 
 class SimulatedMessageListModel : public QAbstractListModel
@@ -34,10 +37,18 @@ public:
     SymbolIdRole = Qt::UserRole + 4
   };
 
+  static constexpr int DefaultCapacity = 1000;
+
   explicit SimulatedMessageListModel(QObject* parent = nullptr);
   ~SimulatedMessageListModel();
 
-  void append(SimulatedMessage* message);
+  int capacity() const;
+  void setCapacity(int capacity);
+
+  int sampleInterval() const;
+  void setSampleInterval(int sampleInterval);
+
+  void append(const QByteArray& message);
 
   void clear();
 
@@ -55,10 +66,27 @@ protected:
 private:
   Q_DISABLE_COPY(SimulatedMessageListModel)
 
+  struct Entry
+  {
+    QByteArray data;
+    // parsed on first access so that rows which are never shown are never parsed
+    mutable std::unique_ptr<SimulatedMessage> message;
+    mutable bool parsed = false;
+  };
+
   void setupRoles();
+  int entryIndex(int row) const;
+  const SimulatedMessage* message(int row) const;
 
   QHash<int, QByteArray> m_roles;
-  QList<SimulatedMessage*> m_messages;
+
+  // fixed-size ring buffer holding the most recent messages, oldest first
+  std::vector<Entry> m_entries;
+  int m_first = 0;
+  int m_count = 0;
+
+  int m_sampleInterval = 1;
+  qint64 m_offered = 0;
 };
 
 #endif // SIMULATEDMESSAGELISTMODEL_H
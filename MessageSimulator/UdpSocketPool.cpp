@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "UdpSocketPool.h"
+
+// dsa app headers
+#include "DataSender.h"
+
+// Qt headers
+#include <QUdpSocket>
+
+UdpSocketPool::UdpSocketPool(QObject* parent) :
+  QObject(parent)
+{
+}
+
+UdpSocketPool::~UdpSocketPool()
+{
+  // the sockets are children of the pool and are deleted with it
+}
+
+QUdpSocket* UdpSocketPool::acquire(const QHostAddress& address, int port, int sendBufferSize)
+{
+  PooledSocket& pooled = m_sockets[key(address, port)];
+  if (!pooled.socket)
+  {
+    // create UDP connection to the address with specified port
+    pooled.socket = Dsa::DataSender::createUdpSocket(address, static_cast<quint16>(port), sendBufferSize, this);
+  }
+  else if (sendBufferSize > pooled.socket->socketOption(QAbstractSocket::SendBufferSizeSocketOption).toInt())
+  {
+    // a shared socket gets the largest buffer any of its streams asks for
+    pooled.socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, sendBufferSize);
+  }
+
+  pooled.users++;
+  return pooled.socket;
+}
+
+void UdpSocketPool::release(const QHostAddress& address, int port)
+{
+  auto it = m_sockets.find(key(address, port));
+  if (it == m_sockets.end())
+    return;
+
+  if (--it->users > 0)
+    return;
+
+  // the last stream on this port has stopped
+  if (it->socket->isOpen())
+    it->socket->close();
+
+  delete it->socket;
+  m_sockets.erase(it);
+}
+
+int UdpSocketPool::socketCount() const
+{
+  return m_sockets.size();
+}
+
+QString UdpSocketPool::key(const QHostAddress& address, int port)
+{
+  return address.toString() + QLatin1Char(':') + QString::number(port);
+}
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef UDPSOCKETPOOL_H
+#define UDPSOCKETPOOL_H
+
+// Qt headers
+#include <QHash>
+#include <QHostAddress>
+#include <QObject>
+
+class QUdpSocket;
+
+// Sockets shared by every stream sending to the same address and port. The pool
+// lives on the send thread and is only used from there
+class UdpSocketPool : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit UdpSocketPool(QObject* parent = nullptr);
+  ~UdpSocketPool();
+
+  QUdpSocket* acquire(const QHostAddress& address, int port, int sendBufferSize = 0);
+  void release(const QHostAddress& address, int port);
+
+  int socketCount() const;
+
+private:
+  Q_DISABLE_COPY(UdpSocketPool)
+
+  struct PooledSocket
+  {
+    QUdpSocket* socket = nullptr;
+    int users = 0;
+  };
+
+  static QString key(const QHostAddress& address, int port);
+
+  QHash<QString, PooledSocket> m_sockets;
+};
+
+#endif // UDPSOCKETPOOL_H
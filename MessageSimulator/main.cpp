@@ -15,14 +15,38 @@
  ******************************************************************************/
 
 #include <QGuiApplication>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QQmlApplicationEngine>
+#include <QTimer>
 
 #include "MessageSimulatorController.h"
 
+#include <csignal>
+
 #ifdef Q_OS_WIN
 #include <Windows.h>
 #endif
 
+namespace
+{
+// how often console mode checks whether an interrupt asked it to stop
+constexpr int c_stopRequestInterval = 100;
+
+// set from the signal handler; only a flag is async-signal-safe to touch there
+volatile std::sig_atomic_t s_stopRequested = 0;
+
+void requestStop(int signal)
+{
+  s_stopRequested = 1;
+
+  // a second interrupt terminates right away
+  std::signal(signal, SIG_DFL);
+}
+
+} // namespace
+
 void printHelp()
 {
   QTextStream out(stdout);
@@ -30,13 +54,63 @@ void printHelp()
   out << "  -h                     Print help and exit" << Qt::endl;
   out << "  -c                     Console mode (no GUI)" << Qt::endl;
   out << "Parameters available only in console mode:" << Qt::endl;
-  out << "  -p <port number>       Port number: Required" << Qt::endl;
-  out << "  -f <filename>          Simulation file: Required" << Qt::endl;
+  out << "  -p <port number>       Port number: Required, except for stream sets whose" << Qt::endl <<
+         "                         streams each name a port" << Qt::endl;
+  out << "  -f <filename>          Simulation file: Required; CoT or GeoMessage XML, a" << Qt::endl <<
+         "                         JSON scenario that generates moving entities, or a" << Qt::endl <<
+         "                         JSON stream set that sends several files at once" << Qt::endl;
+  out << "  -a <address>           Send to this unicast or multicast address instead" << Qt::endl <<
+         "                         of broadcasting" << Qt::endl;
+  out << "  -b <bytes>             Size of the socket send buffer" << Qt::endl;
   out << "  -q <frequency>         Frequency (messages per time unit); default is 1.0" << Qt::endl;
   out << "  -t <time unit>         Time unit for frequency; valid values are seconds," << Qt::endl <<
          "                         minute, and hour; default is second" << Qt::endl;
   out << "  -l                     Simulation loops through simulation file" << Qt::endl;
-  out << "  -s                     Silent mode; no verbose output" << Qt::endl;
+  out << "  -n <loops>             Number of passes through the simulation file;" << Qt::endl <<
+         "                         implies -l; default is to loop until stopped" << Qt::endl;
+  out << "  -d <seconds>           Stop after sending for this many seconds" << Qt::endl;
+  out << "  -r <profile>           Rate ramp as comma separated seconds:rate points," << Qt::endl <<
+         "                         e.g. 0:1000,30:50000; rates are messages per second" << Qt::endl <<
+         "                         and are interpolated linearly; overrides -q and -t" << Qt::endl;
+  out << "  -x <speed>             Replay messages at their original time stamps," << Qt::endl <<
+         "                         sped up by this factor, e.g. 0.5 or 100; messages" << Qt::endl <<
+         "                         without a time stamp follow at the -q rate" << Qt::endl;
+  out << "  -u                     With -x, update message times to when they are sent" << Qt::endl;
+  out << "  -S <seed>              Deterministic run: the same seed sends the same" << Qt::endl <<
+         "                         messages in the same order with the same schedule," << Qt::endl <<
+         "                         and checksum checkpoints are sent for receivers to verify" << Qt::endl;
+  out << "  -j <fraction>          With -S, move each message by up to this fraction" << Qt::endl <<
+         "                         of the message interval" << Qt::endl;
+  out << "  -o <filename>          Write the rate, bytes and send latency percentiles" << Qt::endl <<
+         "                         of every second to this CSV file" << Qt::endl;
+  out << "  -s                     Silent mode; no verbose output, only the summary" << Qt::endl;
+  out << "When the simulation ends a JSON summary of the achieved rate, send latency" << Qt::endl <<
+         "percentiles and error counts is printed to stdout; progress and errors go" << Qt::endl <<
+         "to stderr. Ctrl+C or SIGTERM stops the simulation and still prints the summary." << Qt::endl;
+  out << "Console mode exits with 0 on success, 1 when errors or send failures occurred" << Qt::endl <<
+         "or the simulation could not start, and 2 for invalid parameters." << Qt::endl;
+}
+
+bool parseRateProfile(const QString& profileString, QList<QPointF>& rateProfile)
+{
+  const auto points = profileString.split(',', Qt::SkipEmptyParts);
+  for (const auto& point : points)
+  {
+    const auto values = point.split(':');
+    if (values.size() != 2)
+      return false;
+
+    bool secondsOk = false;
+    bool rateOk = false;
+    const double seconds = values.at(0).trimmed().toDouble(&secondsOk);
+    const double rate = values.at(1).trimmed().toDouble(&rateOk);
+    if (!secondsOk || !rateOk || seconds < 0.0 || rate < 0.0)
+      return false;
+
+    rateProfile.append(QPointF(seconds, rate));
+  }
+
+  return !rateProfile.isEmpty();
 }
 
 int main(int argc, char *argv[])
@@ -48,9 +122,20 @@ int main(int argc, char *argv[])
   bool isGui = true;
   QString simulationFile;
   int port = -1;
+  QString destinationAddress;
+  int sendBufferSize = 0;
   float frequency = 1.0f;
   QString timeUnit = "second";
   bool isLoop = false;
+  int loopCount = 0;
+  double duration = 0.0;
+  QString rateProfileString;
+  double replaySpeed = 0.0;
+  bool rewriteTimes = false;
+  bool deterministic = false;
+  int seed = 0;
+  double jitter = 0.0;
+  QString statisticsFile;
   bool isVerbose = true;
 
   for (int i = 1; i < argc; i++)
@@ -92,6 +177,20 @@ int main(int argc, char *argv[])
         port = atoi(argv[++i]);
       }
     }
+    else if (!strcmp(argv[i], "-a"))
+    {
+      if ((i + 1) < argc)
+      {
+        destinationAddress = QString(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-b"))
+    {
+      if ((i + 1) < argc)
+      {
+        sendBufferSize = atoi(argv[++i]);
+      }
+    }
     else if (!strcmp(argv[i], "-q"))
     {
       if ((i + 1) < argc)
@@ -110,6 +209,61 @@ int main(int argc, char *argv[])
     {
       isLoop = true;
     }
+    else if (!strcmp(argv[i], "-n"))
+    {
+      if ((i + 1) < argc)
+      {
+        loopCount = atoi(argv[++i]);
+        isLoop = true;
+      }
+    }
+    else if (!strcmp(argv[i], "-d"))
+    {
+      if ((i + 1) < argc)
+      {
+        duration = atof(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-r"))
+    {
+      if ((i + 1) < argc)
+      {
+        rateProfileString = QString(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-x"))
+    {
+      if ((i + 1) < argc)
+      {
+        replaySpeed = atof(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-u"))
+    {
+      rewriteTimes = true;
+    }
+    else if (!strcmp(argv[i], "-S"))
+    {
+      if ((i + 1) < argc)
+      {
+        seed = atoi(argv[++i]);
+        deterministic = true;
+      }
+    }
+    else if (!strcmp(argv[i], "-j"))
+    {
+      if ((i + 1) < argc)
+      {
+        jitter = atof(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-o"))
+    {
+      if ((i + 1) < argc)
+      {
+        statisticsFile = QString(argv[++i]);
+      }
+    }
     else if (!strcmp(argv[i], "-s"))
     {
       isVerbose = false;
@@ -122,41 +276,122 @@ int main(int argc, char *argv[])
     AllocConsole() ;
     AttachConsole(GetCurrentProcessId());
     freopen("CON", "w", stdout);
+    freopen("CON", "w", stderr);
 #endif
 
-    if (simulationFile.isEmpty() || port == -1)
+    QList<QPointF> rateProfile;
+    // the streams of a stream set file may each name their own port
+    if (simulationFile.isEmpty() ||
+        (port == -1 && !MessageSimulatorController::isStreamSetFile(simulationFile)) ||
+        (!destinationAddress.isEmpty() && QHostAddress(destinationAddress).isNull()) ||
+        (!rateProfileString.isEmpty() && !parseRateProfile(rateProfileString, rateProfile)))
     {
       printHelp();
-      return 0;
+      return 2;
     }
 
     QCoreApplication app(argc, argv);
 
-    MessageSimulatorController controller;
+    // console runs leave the settings of the GUI alone
+    MessageSimulatorController controller(false);
 
-    if (isVerbose)
+    int errorCount = 0;
+    QObject::connect(&controller, &MessageSimulatorController::errorOccurred, &app, [&errorCount, isVerbose](const QString& error)
     {
-      QObject::connect(&controller, &MessageSimulatorController::errorOccurred, &app, [](const QString& error)
-      {
+      errorCount++;
+      if (isVerbose)
         qDebug() << error;
-      });
-    }
+    });
+
+    // print the summary of the run as JSON and exit once the simulation has stopped
+    QObject::connect(&controller, &MessageSimulatorController::summaryChanged, &app, [&]()
+    {
+      QJsonObject summary = QJsonObject::fromVariantMap(controller.summary());
+      summary.insert("simulationFile", simulationFile);
+      summary.insert("port", port);
+      summary.insert("errors", errorCount);
+
+      QTextStream out(stdout);
+      out << QJsonDocument(summary).toJson();
+      out.flush();
+
+      const bool failed = errorCount > 0 || summary.value("sendFailures").toVariant().toLongLong() > 0;
+      app.exit(failed ? 1 : 0);
+    });
+
+    // stop on Ctrl+C or SIGTERM so the summary is still printed
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    QTimer stopRequestTimer;
+    QObject::connect(&stopRequestTimer, &QTimer::timeout, &app, [&controller]()
+    {
+      if (s_stopRequested)
+        controller.stopSimulation();
+    });
+    stopRequestTimer.start(c_stopRequestInterval);
 
     controller.setMessageFrequency(frequency);
     controller.setTimeUnit(MessageSimulatorController::toTimeUnit(timeUnit));
     controller.setPort(port);
+    controller.setDestinationAddress(destinationAddress);
+    controller.setSendBufferSize(sendBufferSize);
     controller.setSimulationLooped(isLoop);
+    controller.setLoopCount(loopCount);
+    controller.setDuration(duration);
+    controller.setRateProfile(rateProfile);
+    controller.setTimestampReplay(replaySpeed > 0.0);
+    if (replaySpeed > 0.0)
+      controller.setReplaySpeed(replaySpeed);
+    controller.setRewriteTimes(rewriteTimes);
+    controller.setDeterministic(deterministic);
+    controller.setSeed(seed);
+    controller.setJitter(jitter);
+    controller.setStatisticsFile(statisticsFile);
     controller.startSimulation(QUrl::fromLocalFile(simulationFile));
 
+    if (controller.simulationState() == MessageSimulatorController::SimulationState::Stopped)
+    {
+      QTextStream(stderr) << "Could not start simulation with file: " << simulationFile << "\n";
+      return 1;
+    }
+
+    // progress goes to stderr so stdout only carries the JSON summary
     if (isVerbose)
     {
-      QTextStream out(stdout);
+      QTextStream out(stderr);
       out << "Simulation started with file: " << controller.simulationFile().toString() << "\n";
       out << "UDP port: " << controller.port() << "\n";
-      out << "Sending " << controller.messageFrequency() << " message per " <<
-                  MessageSimulatorController::fromTimeUnit(controller.timeUnit()) << "\n";
+      out << "Destination: " << (destinationAddress.isEmpty() ? QStringLiteral("broadcast") : destinationAddress) << "\n";
+      if (replaySpeed > 0.0)
+      {
+        out << "Replaying at original message times, " << replaySpeed << "x" << (rewriteTimes ? ", times updated to now" : "") << "\n";
+      }
+      else if (rateProfile.isEmpty())
+      {
+        out << "Sending " << controller.messageFrequency() << " message per " <<
+                    MessageSimulatorController::fromTimeUnit(controller.timeUnit()) << "\n";
+      }
+      else
+      {
+        out << "Sending with rate profile: " << rateProfileString << "\n";
+      }
+      if (deterministic)
+        out << "Deterministic run with seed " << seed << "\n";
       if (isLoop)
         out << "Simulation loop mode enabled\n";
+      if (loopCount > 0)
+        out << "Stopping after " << loopCount << " loops\n";
+      if (duration > 0.0)
+        out << "Stopping after " << duration << " seconds\n";
+      if (!statisticsFile.isEmpty())
+        out << "Writing statistics to " << statisticsFile << "\n";
+
+      QObject::connect(&controller, &MessageSimulatorController::statisticsChanged, &app, [&controller]()
+      {
+        QTextStream out(stderr);
+        out << "Messages sent: " << controller.messagesSent() << " (" << controller.smoothedRate() << " per second)" <<
+               (controller.isSaturated() ? ", cannot keep up\n" : "\n");
+      });
     }
 
     return app.exec();
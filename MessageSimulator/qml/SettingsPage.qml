@@ -119,7 +119,6 @@ Rectangle {
                     id: speedSlider
                     Layout.leftMargin: 5
                    // Layout.preferredWidth: 200
-                    enabled: messageSimulatorController.simulationState !== MessageSimulatorController.Running
                     orientation: Qt.Horizontal
                     from: 1
                     to: 500
@@ -147,7 +146,6 @@ Rectangle {
                     Layout.fillWidth: true
                     Layout.rightMargin: 5
                     Layout.preferredWidth: 48
-                    enabled: messageSimulatorController.simulationState !== MessageSimulatorController.Running
 
                     onCurrentTextChanged: {
                         var timeUnit = messageSimulatorController.toTimeUnit(currentText);
@@ -178,6 +176,78 @@ Rectangle {
             }
         }
 
+        Rectangle {
+            Layout.preferredWidth: settingsPage.width
+            Layout.preferredHeight: 50 * scaleFactor
+            color: "steelblue"
+            radius: 4 * scaleFactor
+
+            RowLayout {
+                spacing: 10
+                width: parent.width
+
+                Label {
+                    id: destinationLabel
+                    Layout.leftMargin: 5
+                    text: "Send to"
+                    font.bold: true
+                    color: "white"
+                    horizontalAlignment: Text.AlignHCenter
+                    verticalAlignment: Text.AlignVCenter
+                }
+
+                TextField {
+                    id: destinationEdit
+                    Layout.rightMargin: 5
+                    Layout.fillWidth: true
+                    enabled: messageSimulatorController.simulationState === MessageSimulatorController.Stopped
+                    text: messageSimulatorController.destinationAddress
+                    placeholderText: "broadcast, or a unicast or multicast address"
+                    height: destinationLabel.height
+
+                    onEditingFinished: {
+                        messageSimulatorController.destinationAddress = text;
+                        text = messageSimulatorController.destinationAddress;
+                    }
+                }
+            }
+        }
+
+        Rectangle {
+            Layout.preferredWidth: settingsPage.width
+            Layout.preferredHeight: 50 * scaleFactor
+            color: "steelblue"
+            radius: 4 * scaleFactor
+
+            RowLayout {
+                spacing: 10
+                width: parent.width
+
+                Label {
+                    id: statisticsFileLabel
+                    Layout.leftMargin: 5
+                    text: "Statistics CSV"
+                    font.bold: true
+                    color: "white"
+                    horizontalAlignment: Text.AlignHCenter
+                    verticalAlignment: Text.AlignVCenter
+                }
+
+                TextField {
+                    Layout.rightMargin: 5
+                    Layout.fillWidth: true
+                    enabled: messageSimulatorController.simulationState === MessageSimulatorController.Stopped
+                    text: messageSimulatorController.statisticsFile
+                    placeholderText: "file to write per second statistics to, or empty"
+                    height: statisticsFileLabel.height
+
+                    onEditingFinished: {
+                        messageSimulatorController.statisticsFile = text;
+                    }
+                }
+            }
+        }
+
         CheckBox {
             id: loopCheckBox
             text: "Loop"
@@ -187,11 +257,86 @@ Rectangle {
                 messageSimulatorController.simulationLooped = checked;
             }
         }
+
+        Row {
+            spacing: 10 * scaleFactor
+
+            CheckBox {
+                id: timestampReplayCheckBox
+                text: qsTr("Replay at original times")
+                font.bold: true
+                enabled: messageSimulatorController.simulationState === MessageSimulatorController.Stopped
+                checked: messageSimulatorController.timestampReplay
+                onCheckedChanged: {
+                    messageSimulatorController.timestampReplay = checked;
+                }
+            }
+
+            ComboBox {
+                id: replaySpeedOptions
+                anchors.verticalCenter: parent.verticalCenter
+                enabled: timestampReplayCheckBox.checked
+                model: [0.5, 1, 2, 5, 10, 25, 50, 100]
+                displayText: currentText + "x"
+                currentIndex: Math.max(0, model.indexOf(messageSimulatorController.replaySpeed))
+                onActivated: {
+                    messageSimulatorController.replaySpeed = model[currentIndex];
+                }
+            }
+
+            CheckBox {
+                text: qsTr("Update times to now")
+                font.bold: true
+                enabled: timestampReplayCheckBox.checked &&
+                         messageSimulatorController.simulationState === MessageSimulatorController.Stopped
+                checked: messageSimulatorController.rewriteTimes
+                onCheckedChanged: {
+                    messageSimulatorController.rewriteTimes = checked;
+                }
+            }
+        }
+
+        Row {
+            spacing: 10 * scaleFactor
+
+            Label {
+                anchors.verticalCenter: parent.verticalCenter
+                font.bold: true
+                text: qsTr("Keep last")
+            }
+
+            SpinBox {
+                from: 10
+                to: 100000
+                stepSize: 100
+                editable: true
+                value: messageSimulatorController.messageHistoryDepth
+                onValueModified: {
+                    messageSimulatorController.messageHistoryDepth = value;
+                }
+            }
+
+            Label {
+                anchors.verticalCenter: parent.verticalCenter
+                font.bold: true
+                text: qsTr("messages, showing 1 in")
+            }
+
+            SpinBox {
+                from: 1
+                to: 10000
+                editable: true
+                value: messageSimulatorController.messageSampleInterval
+                onValueModified: {
+                    messageSimulatorController.messageSampleInterval = value;
+                }
+            }
+        }
     }
 
     XmlLoader {
         id: loader
-        supportedExtensions: ["xml"]
+        supportedExtensions: ["xml", "json"]
     }
 }
 
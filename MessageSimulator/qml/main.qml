@@ -63,6 +63,118 @@ ApplicationWindow {
                                                                     qsTr("Log:"))
     }
 
+    Text {
+        id: statisticsText
+        anchors {
+            margins: 16 * scaleFactor
+            top: parent.top
+            right: parent.right
+        }
+        visible: messageSimulatorController.simulationState !== MessageSimulatorController.Stopped
+        horizontalAlignment: Text.AlignRight
+        text: {
+            var lines = [qsTr("Sent: ") + messageSimulatorController.messagesSent +
+                         " (" + messageSimulatorController.smoothedRate.toFixed(1) + qsTr(" per second)")];
+
+            // the latest window of whichever stream reported last
+            var history = messageSimulatorController.statisticsHistory;
+            if (history.length > 0) {
+                var last = history[history.length - 1];
+                lines.push((last.bytesPerSecond / 1024).toFixed(1) + qsTr(" KB/s, p99 latency ") +
+                           (last.sendLatency.p99Us / 1000).toFixed(1) + qsTr(" ms"));
+            }
+
+            // one line per stream when a stream set is running
+            var streams = messageSimulatorController.streamStatistics;
+            if (streams.length > 1) {
+                for (var i = 0; i < streams.length; i++) {
+                    lines.push(streams[i].name + qsTr(" on port ") + streams[i].port + ": " + streams[i].messagesSent +
+                               " (" + streams[i].achievedRate.toFixed(1) + ")");
+                }
+            }
+
+            return lines.join("\n");
+        }
+    }
+
+    Text {
+        id: saturatedText
+        anchors {
+            margins: 4 * scaleFactor
+            top: statisticsText.bottom
+            right: parent.right
+            rightMargin: 16 * scaleFactor
+        }
+        visible: statisticsText.visible && messageSimulatorController.saturated
+        color: "red"
+        font.bold: true
+        text: qsTr("The simulator cannot keep up with the requested rate")
+    }
+
+    // messages sent per second, summed over the streams, with the worst p99 send latency drawn over them
+    Canvas {
+        id: statisticsChart
+        anchors {
+            margins: 4 * scaleFactor
+            top: saturatedText.visible ? saturatedText.bottom : statisticsText.bottom
+            right: parent.right
+            rightMargin: 16 * scaleFactor
+        }
+        width: 180 * scaleFactor
+        height: 40 * scaleFactor
+        visible: statisticsText.visible
+
+        Connections {
+            target: messageSimulatorController
+            function onStatisticsChanged() { statisticsChart.requestPaint(); }
+        }
+
+        onPaint: {
+            var ctx = getContext("2d");
+            ctx.reset();
+
+            // windows of different streams that started together fall into the same second
+            var seconds = {};
+            var history = messageSimulatorController.statisticsHistory;
+            for (var i = 0; i < history.length; i++) {
+                var second = Math.floor(history[i].time);
+                var entry = seconds[second] || { rate: 0, latency: 0 };
+                entry.rate += history[i].achievedRate;
+                entry.latency = Math.max(entry.latency, history[i].sendLatency.p99Us);
+                seconds[second] = entry;
+            }
+
+            var keys = Object.keys(seconds).map(Number).sort(function(a, b) { return a - b; }).slice(-60);
+            if (keys.length === 0)
+                return;
+
+            var maxRate = 1;
+            var maxLatency = 1;
+            for (var k = 0; k < keys.length; k++) {
+                maxRate = Math.max(maxRate, seconds[keys[k]].rate);
+                maxLatency = Math.max(maxLatency, seconds[keys[k]].latency);
+            }
+
+            var barWidth = width / 60;
+            ctx.fillStyle = "steelblue";
+            for (k = 0; k < keys.length; k++) {
+                var barHeight = height * seconds[keys[k]].rate / maxRate;
+                ctx.fillRect(k * barWidth, height - barHeight, Math.max(1, barWidth - 1), barHeight);
+            }
+
+            ctx.strokeStyle = messageSimulatorController.saturated ? "red" : "orange";
+            ctx.beginPath();
+            for (k = 0; k < keys.length; k++) {
+                var y = height - height * seconds[keys[k]].latency / maxLatency;
+                if (k === 0)
+                    ctx.moveTo(k * barWidth + barWidth / 2, y);
+                else
+                    ctx.lineTo(k * barWidth + barWidth / 2, y);
+            }
+            ctx.stroke();
+        }
+    }
+
     SwipeView {
         id: view
 
@@ -311,6 +311,25 @@ void AddLocalDataController::createMarkupLayer(const QString& path, int layerInd
     emit layerCreated(layerIndex, markupLayer);
 }
 
+/*!
+ \brief Adds a \a markupLayer which is already in memory, such as a received markup, to the operational layer list.
+
+ The layer is shown if \a visible is \c true.
+*/
+void AddLocalDataController::addMarkupLayer(QObject* markupLayer, bool visible)
+{
+  MarkupLayer* layer = qobject_cast<MarkupLayer*>(markupLayer);
+  if (!layer)
+    return;
+
+  layer->setParent(this);
+  layer->setVisible(visible);
+  connect(layer, &MarkupLayer::errorOccurred, this, &AddLocalDataController::errorOccurred);
+
+  auto operationalLayers = ToolResourceProvider::instance()->operationalLayers();
+  operationalLayers->append(layer);
+}
+
 /*!
  \brief Adds the provided \a indices from the list model as layers.
  */
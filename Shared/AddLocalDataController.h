@@ -71,6 +71,7 @@ public:
   void createElevationSourceFromTpk(const QString& path);
   void createElevationSourceFromRasters(const QStringList& paths);
   Q_INVOKABLE void createMarkupLayer(const QString& path, int layerIndex = -1, bool visible = true, bool autoAdd = true);
+  Q_INVOKABLE void addMarkupLayer(QObject* markupLayer, bool visible = true);
   QStringList dataPaths() const { return m_dataPaths; }
 
 signals:
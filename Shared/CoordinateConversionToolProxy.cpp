@@ -16,6 +16,7 @@
  ******************************************************************************/
 #include "CoordinateConversionToolProxy.h"
 
+#include "LocationSubscription.h"
 #include "ToolManager.h"
 #include "ToolResourceProvider.h"
 
@@ -49,6 +50,13 @@ using namespace Esri::ArcGISRuntime::Toolkit;
 namespace Dsa
 {
 
+namespace
+{
+// the conversions are read by people, so they need not follow every update of the receiver
+constexpr int c_locationUpdateInterval = 250;
+constexpr double c_locationUpdateDistance = 1.0;
+} // namespace
+
 CoordinateConversionToolProxy::CoordinateConversionToolProxy(QObject* parent) :
   AbstractTool(parent),
   m_inInputMode(false),
@@ -173,7 +181,8 @@ void CoordinateConversionToolProxy::connectController()
   auto geoView = ToolResourceProvider::instance()->geoView();
   m_controller->setGeoView(static_cast<SceneQuickView*>(geoView));
 
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::locationChanged,
+  auto* locationSubscription = ToolResourceProvider::instance()->subscribeToLocation(this, c_locationUpdateInterval, c_locationUpdateDistance);
+  connect(locationSubscription, &LocationSubscription::locationChanged,
     m_controller,
     [this](const Point& point)
     {
@@ -19,18 +19,13 @@
 
 #include "GPXLocationSimulator.h"
 
-// C++ API headers
-#include "SpatialReference.h"
-
 // Qt headers
-#include <QTimer>
-#include <QXmlStreamReader>
+#include <QFile>
 #include <QGeoPositionInfo>
+#include <QTimer>
 
 // STL headers
-#include <cmath>
-
-using namespace Esri::ArcGISRuntime;
+#include <algorithm>
 
 namespace Dsa {
 
@@ -39,6 +34,16 @@ namespace Dsa {
   \inmodule Dsa
   \inherits QGeoPositionInfoSource
   \brief Position source simulator that reads from a GPX file.
+
+  The track is read once into a \l GpxTrack, so each update costs the same however
+  long the track is, and the simulation can loop and seek without reading the file
+  again.
+
+  Between two points of the track the position moves along the great circle at a
+  constant speed, so updates more frequent than the points of the track still move
+  smoothly. Each update reports the heading and ground
+  speed as well, and the heading can turn smoothly at each point; see
+  \l setHeadingSmoothing.
  */
 
 /*!
@@ -48,9 +53,7 @@ namespace Dsa {
  */
 GPXLocationSimulator::GPXLocationSimulator(QObject* parent) :
   QGeoPositionInfoSource(parent),
-  m_gpxReader(new QXmlStreamReader()),
-  m_timer(new QTimer(this)),
-  m_angleOffset(0.0, -90.0, 0.0, 90.0)
+  m_timer(new QTimer(this))
 {
   connectSignals();
   setUpdateInterval(500);
@@ -67,7 +70,6 @@ GPXLocationSimulator::GPXLocationSimulator(QObject* parent) :
  */
 GPXLocationSimulator::GPXLocationSimulator(const QString& gpxFileName, int updateInterval, QObject* parent) :
   QGeoPositionInfoSource(parent),
-  m_gpxReader(new QXmlStreamReader()),
   m_timer(new QTimer(this))
 {
   connectSignals();
@@ -76,7 +78,7 @@ GPXLocationSimulator::GPXLocationSimulator(const QString& gpxFileName, int updat
   if (!setGpxFile(gpxFileName))
   {
     // raise error
-    m_gpxFile.setFileName("");
+    m_gpxFileName.clear();
   }
 }
 
@@ -98,86 +100,11 @@ void GPXLocationSimulator::connectSignals()
           this, &QGeoPositionInfoSource::errorOccurred);
 }
 
-/*!
-  \internal
- */
-bool GPXLocationSimulator::gotoNextPositionElement()
-{
-  while (!m_gpxReader->atEnd() && !m_gpxReader->hasError())
-  {
-    if (m_gpxReader->isStartElement())
-    {
-      if (m_gpxReader->name().compare(QString("trkpt"), Qt::CaseInsensitive) == 0)
-      {
-        return true;
-      }
-    }
-
-    m_gpxReader->readNext();
-  }
-
-  return false;
-}
-
-/*!
-  \internal
- */
-Point GPXLocationSimulator::getNextPoint(QTime& time)
-{
-  // Convert the current gpx position to Point and QTime parmeters.
-  if (!gotoNextPositionElement())
-  {
-    return Point();
-  }
-
-  // fetch the lat and lon attributes from the trkpt element
-  const QXmlStreamAttributes attrs = m_gpxReader->attributes();
-  const double x = attrs.value("lon").toString().toDouble();
-  const double y = attrs.value("lat").toString().toDouble();
-  double z = NAN;
-  // if the new point is the same as the old point then trash it and try to get another.
-  if (x == m_latestPoint.x() && y == m_latestPoint.y())
-  {
-    m_gpxReader->readNext();
-    return getNextPoint(time);
-  }
-
-  // goto the start of the time child element
-  m_gpxReader->readNextStartElement();
-
-  while (m_gpxReader->name().compare(QString("trkpt"), Qt::CaseInsensitive) != 0 && !m_gpxReader->atEnd())
-  {
-    if (m_gpxReader->isStartElement())
-    {
-      if (m_gpxReader->name().compare(QString("ele"), Qt::CaseInsensitive) == 0)
-      {
-        z = m_gpxReader->readElementText().toDouble();
-      }
-      else if (m_gpxReader->name().compare(QString("time"), Qt::CaseInsensitive) == 0)
-      {
-        const QString timeString = m_gpxReader->readElementText();
-        const int hours = timeString.section(":", 0, 0).right(2).toInt();
-        const int minutes = timeString.section(":", 1, 1).toInt();
-        const int seconds = timeString.section(":", 2, 2).left(2).toInt();
-        time.setHMS(hours ,minutes, seconds, 0);
-      }
-    }
-
-    m_gpxReader->readNext();
-  }
-
-  m_latestPoint = std::isnan(z) ?
-        Point(x, y, SpatialReference::wgs84()) :
-        Point(x, y, z, SpatialReference::wgs84());
-
-  return m_latestPoint;
-}
-
 /*!
   \brief Starts position updates.
 
-  Loads a GPX file into a stream reader, fetches the first 3 coordinates
-  and starts a timer that performs interpolation and position updating.
+  Starts a timer that performs interpolation and position updating from the
+  current position of the track.
  */
 void GPXLocationSimulator::startUpdates()
 {
@@ -186,7 +113,7 @@ void GPXLocationSimulator::startUpdates()
 
   // if the gpx file does not contain enough information to
   // interpolate on then cancel the simulation.
-  if (!initializeInterpolationValues())
+  if (m_track.isEmpty())
   {
     return;
   }
@@ -270,132 +197,48 @@ int GPXLocationSimulator::minimumUpdateInterval() const
   \internal
 
  increments the current time
- fetches new positions from the gpx file as necessary
+ moves on to the segment containing it, starting over at the end of the track
  calculates and sets the current position and orientation
  */
 void GPXLocationSimulator::handleTimerEvent()
 {
-  // update the current time
-  m_currentTime = m_currentTime.addMSecs(m_timer->interval() * m_playbackMultiplier);
-
-  // determine if a new position needs to be obtained from the gpx
-  if (m_currentTime > m_segmentEndTime)
-  {
-    if (!updateInterpolationParameters())
-    {
-      m_gpxReader->clear();
-      m_gpxReader->addData(m_gpxData);
-      initializeInterpolationValues();
-
-      return;
-    }
-  }
-
-  // normalize the time across the current segment
-  const double val1 = static_cast<double>(m_segmentStartTime.msecsTo(m_currentTime));
-  const double val2 = static_cast<double>(m_segmentStartTime.msecsTo(m_segmentEndTime));
-  const double normalizedTime = val1 / val2;
-
-  // get the interpolated position and orientation on the current
-  // segment based on the normalized time.
-  const Point currentPosition = normalizedTime <= 0.5 ? m_currentSegment.startPoint() : m_currentSegment.endPoint();
-  const double currentHeading = getInterpolatedHeading(currentPosition, normalizedTime);
-
-  QGeoPositionInfo qtPosition;
-  auto timeStamp = QDateTime::currentDateTime();
-  timeStamp.setTime(m_currentTime);
-  qtPosition.setTimestamp(timeStamp);
-
-  qtPosition.setCoordinate(QGeoCoordinate(currentPosition.y(), currentPosition.x(), currentPosition.z()));
-
-  m_lastKnownPosition = qtPosition;
-  emit positionUpdated(qtPosition);
-  emit headingChanged(currentHeading);
-}
+  if (m_track.isEmpty())
+    return;
 
-/*!
-  \internal
- */
-bool GPXLocationSimulator::initializeInterpolationValues()
-{
-  // fetch the first 3 points from the gpx feed to populate the
-  // initial interpolation components.
-  const Point pt1 = getNextPoint(m_segmentStartTime);
-  const Point pt2 = getNextPoint(m_segmentEndTime);
-  const Point pt3 = getNextPoint(m_nextSegmentEndTime);
+  // update the current time
+  m_currentTime += static_cast<qint64>(m_timer->interval()) * m_playbackMultiplier;
 
-  if (pt1.isEmpty() || pt2.isEmpty() || pt3.isEmpty())
+  // start over once the end of the track has been passed
+  if (m_currentTime > m_track.duration())
   {
-    return false;
+    m_currentTime = 0;
+    m_segment = 0;
   }
 
-  // define the interpolation segments
-  m_currentSegment = LineSegment(pt1, pt2, SpatialReference::wgs84());
-  m_nextSegment = LineSegment(pt2, pt3, SpatialReference::wgs84());
-  m_startHeadingDelta = 0;
-  m_endHeadingDelta = heading(m_currentSegment);
+  // a tick rarely passes more than a segment or two, so the segment is found by stepping forward
+  m_segment = m_track.segmentIndex(m_currentTime, m_segment);
 
-  // define the current time as the first timestamp extracted from the gpx file
-  m_currentTime = m_segmentStartTime;
-
-  return true;
+  updatePosition();
 }
 
 /*!
   \internal
- */
-double GPXLocationSimulator::getInterpolatedHeading(const Point& currentPosition, double normalizedTime)
-{
-  // implementation for smooth orientation transfer between segments.
-  // the smoothing is spread across the final 10% of the current segment
-  // and the first 10% of the next segment.
-
-  LineSegment segment;
-
-  // interpolation of the first 10% of the segment
-  if (normalizedTime < 0.1)
-  {
-    segment = LineSegment(m_currentSegment.startPoint(), currentPosition, SpatialReference::wgs84());
-    return heading(m_currentSegment);
-  }
-  // interpolation of the last 10% of the segment
-  else if (normalizedTime > 0.9)
-  {
-    segment = LineSegment(m_currentSegment.endPoint(), currentPosition, SpatialReference::wgs84());
-    return heading(m_currentSegment);
-  }
 
-  // no orientation interpolation needed, use the current segments angle
-  return heading(m_currentSegment);
-}
-
-/*!
-  \internal
+  Emits the position and heading at the current time of the track.
  */
-bool GPXLocationSimulator::updateInterpolationParameters()
+void GPXLocationSimulator::updatePosition()
 {
-  // fetch the next coordinate in the gpx file and updates all the
-  // internal interpolation vars
+  const GpxTrack::Position position = m_track.position(m_currentTime, m_segment);
 
-  m_segmentStartTime = m_segmentEndTime;
-  m_segmentEndTime = m_nextSegmentEndTime;
-  Point newPt = getNextPoint(m_nextSegmentEndTime);
-
-  // if there are no more points to get then notify simulation to start over
-  if (newPt.isEmpty())
-  {
-    return false;
-  }
-
-  // discard the oldest segment and populate the newest segment.
-  m_currentSegment = m_nextSegment;
-  m_nextSegment = LineSegment(m_currentSegment.endPoint(), newPt, SpatialReference::wgs84());
-
-  // discard the oldest orientation delta and populate the newest
-  m_startHeadingDelta = m_endHeadingDelta;
-  m_endHeadingDelta = heading(m_currentSegment);
+  QGeoPositionInfo qtPosition;
+  qtPosition.setTimestamp(m_track.startTime().addMSecs(m_currentTime));
+  qtPosition.setCoordinate(QGeoCoordinate(position.y, position.x, position.z));
+  qtPosition.setAttribute(QGeoPositionInfo::Direction, position.heading);
+  qtPosition.setAttribute(QGeoPositionInfo::GroundSpeed, position.speed);
 
-  return true;
+  m_lastKnownPosition = qtPosition;
+  emit positionUpdated(qtPosition);
+  emit headingChanged(position.heading);
 }
 
 /*!
@@ -403,12 +246,13 @@ bool GPXLocationSimulator::updateInterpolationParameters()
  */
 QString GPXLocationSimulator::gpxFile()
 {
-  return m_gpxFile.fileName();
+  return m_gpxFileName;
 }
 
 /*!
   \brief Sets the GPX file location to \a fileName.
 
+  The whole track is read, and the simulation restarts at its beginning.
   Returns whether the file was succesfully read.
  */
 bool GPXLocationSimulator::setGpxFile(const QString& fileName)
@@ -420,18 +264,16 @@ bool GPXLocationSimulator::setGpxFile(const QString& fileName)
     return false;
   }
 
-  if (m_gpxFile.isOpen())
-    m_gpxFile.close();
-
-  m_gpxFile.setFileName(fileName);
-
-  if (!m_gpxFile.open(QFile::ReadOnly | QFile::Text))
+  QFile gpxFile(fileName);
+  if (!gpxFile.open(QFile::ReadOnly))
     return false;
 
-  m_gpxData = m_gpxFile.readAll();
-  m_gpxReader->clear();
-  m_gpxReader->addData(m_gpxData);
-  m_gpxFile.close();
+  m_gpxFileName = fileName;
+
+  // a track with fewer than two points is kept, but cannot be started
+  m_track.read(gpxFile.readAll());
+  m_currentTime = 0;
+  m_segment = 0;
 
   m_isStarted = false;
 
@@ -457,13 +299,56 @@ void GPXLocationSimulator::setPlaybackMultiplier(int val)
 }
 
 /*!
-  \brief Returns the heading in degrees of the supplied \a segment.
+  \brief Returns the time in milliseconds from the first to the last point of the track.
+ */
+qint64 GPXLocationSimulator::trackDuration() const
+{
+  return m_track.duration();
+}
+
+/*!
+  \brief Returns the current time of the simulation in milliseconds from the start of the track.
+ */
+qint64 GPXLocationSimulator::trackPosition() const
+{
+  return m_currentTime;
+}
+
+/*!
+  \brief Moves the simulation to \a msecs milliseconds from the start of the track.
+
+  The segment is found by binary search, so any point of a long track is reached at
+  once. While updates are started, the new position is reported straight away.
+ */
+void GPXLocationSimulator::seek(qint64 msecs)
+{
+  if (m_track.isEmpty())
+    return;
+
+  m_currentTime = std::clamp<qint64>(msecs, 0, trackDuration());
+  m_segment = m_track.segmentIndex(m_currentTime);
+
+  if (isStarted())
+    updatePosition();
+}
+
+/*!
+  \brief Returns the time in milliseconds over which the heading turns at each point of the track.
+ */
+int GPXLocationSimulator::headingSmoothing() const
+{
+  return m_track.headingSmoothing();
+}
+
+/*!
+  \brief Sets the time in milliseconds over which the heading turns at each point of the track to \a msecs.
+
+  The turn is centred on the point and takes at most half of the segments either side.
+  The default of 0 turns to the heading of the next segment at once.
  */
-double GPXLocationSimulator::heading(const Esri::ArcGISRuntime::LineSegment& segment) const
+void GPXLocationSimulator::setHeadingSmoothing(int msecs)
 {
-  const auto startPoint = segment.startPoint();
-  const auto endPoint = segment.endPoint();
-  return m_angleOffset.angleTo(QLineF(startPoint.x(), startPoint.y(), endPoint.x(), endPoint.y()));
+  m_track.setHeadingSmoothing(msecs);
 }
 
 } // Dsa
@@ -17,21 +17,12 @@
 #ifndef GPXLOCATIONSIMULATOR_H
 #define GPXLOCATIONSIMULATOR_H
 
-// C++ API headers
-#include "LineSegment.h"
-#include "Point.h"
+// DSA headers
+#include "GpxTrack.h"
 
 // Qt headers
-#include <QFile>
 #include <QGeoPositionInfoSource>
-#include <QLineF>
-#include <QPointF>
-#include <QTime>
 
-// STL headers
-#include <memory>
-
-class QXmlStreamReader;
 class QTimer;
 
 namespace Dsa {
@@ -58,6 +49,13 @@ public:
   int playbackMultiplier();
   void setPlaybackMultiplier(int multiplier);
 
+  qint64 trackDuration() const;
+  qint64 trackPosition() const;
+  void seek(qint64 msecs);
+
+  int headingSmoothing() const;
+  void setHeadingSmoothing(int msecs);
+
   QGeoPositionInfoSource::Error error() const override;
 
 public slots:
@@ -72,35 +70,21 @@ signals:
   void errorInternal(QGeoPositionInfoSource::Error);
 
 private:
-  void pauseSimulation();
-  void resumeSimulation();
-
-  bool gotoNextPositionElement();
-  Esri::ArcGISRuntime::Point getNextPoint(QTime& time);
-  bool updateInterpolationParameters();
-  bool initializeInterpolationValues();
-  double heading(const Esri::ArcGISRuntime::LineSegment& segment) const;
-
-  double getInterpolatedHeading(const Esri::ArcGISRuntime::Point& currentPosition, double normalizedTime);
+  void updatePosition();
 
   void connectSignals();
 
-  QFile m_gpxFile;
-  QByteArray m_gpxData;
-  std::unique_ptr<QXmlStreamReader> m_gpxReader;
+  QString m_gpxFileName;
   QTimer* m_timer = nullptr;
   int m_playbackMultiplier = 1;
-  Esri::ArcGISRuntime::LineSegment m_currentSegment;
-  Esri::ArcGISRuntime::LineSegment m_nextSegment;
-  Esri::ArcGISRuntime::Point m_latestPoint;
-  double m_startHeadingDelta;
-  double m_endHeadingDelta;
-  QTime m_currentTime;
-  QTime m_segmentStartTime;
-  QTime m_segmentEndTime;
-  QTime m_nextSegmentEndTime;
+
+  // the whole track is read once, so ticks, loops and seeks never go back to the file
+  GpxTrack m_track;
+  qint64 m_currentTime = 0;
+  // the index of the sample which starts the segment containing the current time
+  int m_segment = 0;
+
   bool m_isStarted = false;
-  const QLineF m_angleOffset;
   QGeoPositionInfo m_lastKnownPosition;
   QGeoPositionInfoSource::Error m_lastError = QGeoPositionInfoSource::NoError;
 
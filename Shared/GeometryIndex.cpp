@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "GeometryIndex.h"
+
+// C++ API headers
+#include "Envelope.h"
+#include "GeoElement.h"
+#include "GeometryEngine.h"
+#include "Point.h"
+#include "SpatialReference.h"
+
+// DSA headers
+#include "GeometryQuadtree.h"
+#include "PointGridIndex.h"
+
+// STL headers
+#include <algorithm>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+namespace
+{
+
+constexpr double c_fullRevolution = 360.0;
+
+} // namespace
+
+/*!
+  \class Dsa::GeometryIndex
+  \inmodule Dsa
+  \inherits QObject
+  \brief Base type for spatial indexes covering a set of
+  \l Esri::ArcGISRuntime::GeoElement objects.
+
+  An index returns candidate geometries for a query extent or location so that
+  exact geometry tests only have to be carried out on a small subset of the data.
+  Use \l createIndex to pick the most suitable index for a set of elements.
+
+  \note This is an abstract base type.
+ */
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+GeometryIndex::GeometryIndex(QObject* parent) :
+  QObject(parent)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+GeometryIndex::~GeometryIndex()
+{
+}
+
+/*!
+  \brief Creates the index best suited to \a geoElements, with an optional \a parent.
+
+  If every element is a point a \l PointGridIndex is created, since moving a point
+  in the grid is O(1). Otherwise a \l GeometryQuadtree covering \a extent is
+  created. An empty \a extent makes the quadtree cover the elements.
+ */
+GeometryIndex* GeometryIndex::createIndex(const Envelope& extent,
+                                          const QList<GeoElement*>& geoElements,
+                                          QObject* parent)
+{
+  if (isPointOnly(geoElements))
+    return new PointGridIndex(geoElements, PointGridIndex::DefaultCellSize, parent);
+
+  return new GeometryQuadtree(extent, geoElements, GeometryQuadtree::DefaultMaxLevels, parent);
+}
+
+/*!
+  \brief Returns whether every element in \a geoElements has point geometry.
+
+  Elements which do not have a geometry yet are ignored.
+ */
+bool GeometryIndex::isPointOnly(const QList<GeoElement*>& geoElements)
+{
+  for (auto* geoElement : geoElements)
+  {
+    if (!geoElement)
+      continue;
+
+    const Geometry geometry = geoElement->geometry();
+    if (!geometry.isEmpty() && geometry.geometryType() != GeometryType::Point)
+      return false;
+  }
+
+  return true;
+}
+
+/*!
+  \brief Returns whether this index is specialized for point geometry.
+
+  Other geometry types can still be added to such an index, but queries
+  against them are not accelerated.
+ */
+bool GeometryIndex::isPointIndex() const
+{
+  return false;
+}
+
+/*!
+  \fn void Dsa::GeometryIndex::appendGeoElement(Esri::ArcGISRuntime::GeoElement* newGeoElement)
+  \brief Adds the \a newGeoElement into the index.
+ */
+
+/*!
+  \fn void Dsa::GeometryIndex::updateGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement)
+  \brief Updates the location of \a geoElement in the index.
+ */
+
+/*!
+  \fn void Dsa::GeometryIndex::removeGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement)
+  \brief Removes \a geoElement from the index.
+ */
+
+/*!
+  \brief Returns the list of \l Geometry objects which are candidates for intersecting \a geometry.
+
+  \note No intersection test is carried out between the supplied Geometry and the results. For exact results,
+  you should perform the desired geometry tests on the list of \l Geometry objects returned.
+ */
+QList<Geometry> GeometryIndex::candidateIntersections(const Geometry& geometry) const
+{
+  return candidateIntersections(geometry.extent());
+}
+
+/*!
+  \fn QList<Esri::ArcGISRuntime::Geometry> Dsa::GeometryIndex::candidateIntersections(const Esri::ArcGISRuntime::Envelope& extent) const
+  \brief Returns the list of \l Geometry objects which are candidates for intersecting \a extent.
+ */
+
+/*!
+  \fn QList<Esri::ArcGISRuntime::Geometry> Dsa::GeometryIndex::candidateIntersections(const Esri::ArcGISRuntime::Point& location) const
+  \brief Returns the list of \l Geometry objects which are candidates for intersecting \a location.
+ */
+
+/*!
+  \fn QVariantMap Dsa::GeometryIndex::statistics() const
+  \brief Returns statistics describing the index and the queries made against it.
+ */
+
+/*!
+  \internal
+
+  Returns \a geometry in WGS84.
+ */
+Geometry GeometryIndex::toWgs84(const Geometry& geometry)
+{
+  // avoid a round trip through the geometry engine for the common case of WGS84 data
+  if (geometry.isEmpty() || geometry.spatialReference().wkid() == SpatialReference::wgs84().wkid())
+    return geometry;
+
+  return GeometryEngine::project(geometry, SpatialReference::wgs84());
+}
+
+/*!
+  \internal
+
+  Longitudes are not normalized, so data near the antimeridian can be stored
+  either side of it. Returns \a extent along with copies of it shifted one
+  revolution east and west wherever they overlap the data between \a dataXMin
+  and \a dataXMax. The copies never overlap \a extent itself.
+
+  An extent spanning a full revolution covers every longitude, so it is widened
+  to cover all of the data instead.
+ */
+QList<Envelope> GeometryIndex::wrappedQueries(const Envelope& extent, double dataXMin, double dataXMax)
+{
+  QList<Envelope> queries{extent};
+  if (extent.isEmpty())
+    return queries;
+
+  if (extent.xMax() - extent.xMin() >= c_fullRevolution)
+  {
+    queries[0] = Envelope(std::min(extent.xMin(), dataXMin), extent.yMin(), std::max(extent.xMax(), dataXMax), extent.yMax(),
+                          SpatialReference::wgs84());
+    return queries;
+  }
+
+  for (const double shift : {-c_fullRevolution, c_fullRevolution})
+  {
+    if (extent.xMin() + shift <= dataXMax && extent.xMax() + shift >= dataXMin)
+    {
+      queries.append(Envelope(extent.xMin() + shift, extent.yMin(), extent.xMax() + shift, extent.yMax(),
+                              SpatialReference::wgs84()));
+    }
+  }
+
+  return queries;
+}
+
+/*!
+  \internal
+
+  Returns \a location along with copies of it shifted one revolution east and
+  west wherever they lie within the data between \a dataXMin and \a dataXMax.
+ */
+QList<Point> GeometryIndex::wrappedQueries(const Point& location, double dataXMin, double dataXMax)
+{
+  QList<Point> queries{location};
+  if (location.isEmpty())
+    return queries;
+
+  for (const double shift : {-c_fullRevolution, c_fullRevolution})
+  {
+    if (location.x() + shift <= dataXMax && location.x() + shift >= dataXMin)
+      queries.append(Point(location.x() + shift, location.y(), SpatialReference::wgs84()));
+  }
+
+  return queries;
+}
+
+} // Dsa
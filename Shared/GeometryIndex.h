@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef GEOMETRYINDEX_H
+#define GEOMETRYINDEX_H
+
+// Qt headers
+#include <QList>
+#include <QObject>
+#include <QVariantMap>
+
+namespace Esri::ArcGISRuntime {
+  class Envelope;
+  class GeoElement;
+  class Geometry;
+  class Point;
+}
+
+namespace Dsa {
+
+class GeometryIndex : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~GeometryIndex();
+
+  static GeometryIndex* createIndex(const Esri::ArcGISRuntime::Envelope& extent,
+                                    const QList<Esri::ArcGISRuntime::GeoElement*>& geoElements,
+                                    QObject* parent = nullptr);
+  static bool isPointOnly(const QList<Esri::ArcGISRuntime::GeoElement*>& geoElements);
+
+  virtual bool isPointIndex() const;
+
+  virtual void appendGeoElement(Esri::ArcGISRuntime::GeoElement* newGeoElement) = 0;
+  virtual void updateGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement) = 0;
+  virtual void removeGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement) = 0;
+
+  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Geometry& geometry) const;
+  virtual QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Envelope& extent) const = 0;
+  virtual QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Point& location) const = 0;
+
+  virtual QVariantMap statistics() const = 0;
+
+protected:
+  explicit GeometryIndex(QObject* parent = nullptr);
+
+  static Esri::ArcGISRuntime::Geometry toWgs84(const Esri::ArcGISRuntime::Geometry& geometry);
+  static QList<Esri::ArcGISRuntime::Envelope> wrappedQueries(const Esri::ArcGISRuntime::Envelope& extent, double dataXMin, double dataXMax);
+  static QList<Esri::ArcGISRuntime::Point> wrappedQueries(const Esri::ArcGISRuntime::Point& location, double dataXMin, double dataXMax);
+
+private:
+  Q_DISABLE_COPY(GeometryIndex)
+};
+
+} // Dsa
+
+#endif // GEOMETRYINDEX_H
@@ -31,23 +31,45 @@
 // Qt headers
 #include <QSet>
 
+// STL headers
+#include <algorithm>
+
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+namespace
+{
+
+struct TreeStatistics
+{
+  QVector<int> nodesPerDepth;
+  int leafCount = 0;
+  qint64 leafOccupancy = 0;
+  int maxLeafOccupancy = 0;
+};
+
+} // namespace
+
 struct GeometryQuadtree::QuadTree
 {
   explicit QuadTree(int level, double xMin, double xMax, double yMin, double yMax);
   ~QuadTree();
 
-  QuadTree* createTopLeft(int maxLevels);
-  QuadTree* createTopRight(int maxLevels);
-  QuadTree* createBottomLeft(int maxLevels);
-  QuadTree* createBottomRight(int maxLevels);
+  QuadTree* createTopLeft() const;
+  QuadTree* createTopRight() const;
+  QuadTree* createBottomLeft() const;
+  QuadTree* createBottomRight() const;
 
-  bool assign(const Envelope& extent, int geomId, int maxLevels);
+  bool assign(const Envelope& extent, int geomId, const GeometryQuadtree& owner);
+  void assignToChildren(const Envelope& extent, int geomId, const GeometryQuadtree& owner);
+  void subdivide(const GeometryQuadtree& owner);
   void prune();
 
+  bool isLeaf() const;
+  void clearChildren();
+  void collectStatistics(TreeStatistics& statistics) const;
+
   QSet<int> intersectingIds(const Envelope& extent) const;
   QSet<int> intersectingIds(const Point& location) const;
 
@@ -55,7 +77,8 @@ struct GeometryQuadtree::QuadTree
   bool intersects(const Envelope& extent) const;
   bool intersects(const Point& location) const;
 
-  void removeId(int geomId);
+  void removeId(int geomId, int mergeThreshold);
+  void removeIdFromChild(QuadTree*& child, int geomId, int mergeThreshold);
 
   int m_level = 0;
   double m_xMin = 0.0;
@@ -72,30 +95,60 @@ struct GeometryQuadtree::QuadTree
 /*!
   \class Dsa::GeometryQuadtree
   \inmodule Dsa
-  \inherits QObject
+  \inherits GeometryIndex
   \brief A Quadtree spatial structure covering a set of
   \l Esri::ArcGISRuntime::GeoElement objects.
 
   The tree then allows geometric tests for candidate intersections against
   query geometries.
+
+  Cells are subdivided adaptively: a cell is only split once it holds more than
+  \l nodeCapacity geometries, down to at most \l maxLevels levels. Dense clusters
+  therefore get small cells while sparse areas are covered by a few large ones.
+  Use \l statistics to check how a given dataset is distributed over the tree.
  */
 
 /*!
   \brief Constructor taking the \a extent of the quadtree, the list of \a geoElements
   which the tree should include, the \a maxLevels for the tree and an optional \a parent.
+
+  The tree uses the default node capacity.
+ */
+GeometryQuadtree::GeometryQuadtree(const Envelope& extent,
+                                   const QList<GeoElement*>& geoElements,
+                                   int maxLevels,
+                                   QObject* parent):
+  GeometryQuadtree(extent, geoElements, maxLevels, DefaultNodeCapacity, parent)
+{
+}
+
+/*!
+  \brief Constructor taking the \a extent of the quadtree, the list of \a geoElements
+  which the tree should include, the \a maxLevels for the tree, the \a nodeCapacity
+  and an optional \a parent.
+
+  A cell is only split into four children once it holds more than \a nodeCapacity
+  geometries, and never beyond \a maxLevels levels below the root.
  */
 GeometryQuadtree::GeometryQuadtree(const Envelope& extent,
                                    const QList<GeoElement*>& geoElements,
                                    int maxLevels,
+                                   int nodeCapacity,
                                    QObject* parent):
-  QObject(parent),
-  m_maxLevels(maxLevels)
+  GeometryIndex(parent),
+  m_maxLevels(std::max(maxLevels, 0)),
+  m_nodeCapacity(std::max(nodeCapacity, 1))
 {
   // connect to the geometryChanged signal of individual GeoElements
   for (const auto& element : geoElements)
-    handleNewGeoElement(element);
+  {
+    const int key = handleNewGeoElement(element);
+    if (key != -1)
+      m_elementExtents.insert(key, toWgs84(element->geometry()).extent());
+  }
 
-  buildTree(extent);
+  // if no extent is supplied, cover the extent of the elements
+  buildTree(extent.isEmpty() ? elementsExtent() : extent);
 }
 
 /*!
@@ -106,28 +159,161 @@ GeometryQuadtree::~GeometryQuadtree()
 }
 
 /*!
-  \brief Adds the \a newGeoElement into the quadtree.
+  \brief Returns the maximum depth of the tree below the root cell.
+ */
+int GeometryQuadtree::maxLevels() const
+{
+  return m_maxLevels;
+}
+
+/*!
+  \brief Sets the maximum depth of the tree below the root cell to \a maxLevels.
+
+  \note The tree will be re-built.
+ */
+void GeometryQuadtree::setMaxLevels(int maxLevels)
+{
+  maxLevels = std::max(maxLevels, 0);
+  if (m_maxLevels == maxLevels)
+    return;
+
+  m_maxLevels = maxLevels;
+  buildTree(Envelope(m_tree->m_xMin, m_tree->m_yMin, m_tree->m_xMax, m_tree->m_yMax, SpatialReference::wgs84()));
+}
+
+/*!
+  \brief Returns the number of geometries a cell can hold before it is split.
+ */
+int GeometryQuadtree::nodeCapacity() const
+{
+  return m_nodeCapacity;
+}
+
+/*!
+  \brief Sets the number of geometries a cell can hold before it is split to \a nodeCapacity.
 
   \note The tree will be re-built.
  */
-void GeometryQuadtree::appendGeoElment(GeoElement* newGeoElement)
+void GeometryQuadtree::setNodeCapacity(int nodeCapacity)
+{
+  nodeCapacity = std::max(nodeCapacity, 1);
+  if (m_nodeCapacity == nodeCapacity)
+    return;
+
+  m_nodeCapacity = nodeCapacity;
+  buildTree(Envelope(m_tree->m_xMin, m_tree->m_yMin, m_tree->m_xMax, m_tree->m_yMax, SpatialReference::wgs84()));
+}
+
+/*!
+  \brief Returns statistics describing the shape of the tree and the queries made against it.
+
+  The map contains:
+  \list
+    \li \c elementCount - the number of elements in the tree.
+    \li \c maxLevels and \c nodeCapacity - the current settings.
+    \li \c nodeCount - the number of cells.
+    \li \c depthHistogram - a list with the number of cells at each depth, starting with the root.
+    \li \c leafCount - the number of cells without children.
+    \li \c averageLeafOccupancy and \c maxLeafOccupancy - the number of geometries held by leaf cells.
+    \li \c queryCount - the number of queries since the statistics were last reset.
+    \li \c averageCandidatesPerQuery - the mean number of candidates returned per query.
+  \endlist
+ */
+QVariantMap GeometryQuadtree::statistics() const
+{
+  TreeStatistics treeStatistics;
+  if (m_tree)
+    m_tree->collectStatistics(treeStatistics);
+
+  QVariantList depthHistogram;
+  int nodeCount = 0;
+  for (const int count : std::as_const(treeStatistics.nodesPerDepth))
+  {
+    depthHistogram.append(count);
+    nodeCount += count;
+  }
+
+  const qint64 queryCount = m_queryCount.load(std::memory_order_relaxed);
+  const qint64 candidateCount = m_candidateCount.load(std::memory_order_relaxed);
+
+  QVariantMap result;
+  result.insert(QStringLiteral("elementCount"), m_elementStorage.size());
+  result.insert(QStringLiteral("maxLevels"), m_maxLevels);
+  result.insert(QStringLiteral("nodeCapacity"), m_nodeCapacity);
+  result.insert(QStringLiteral("nodeCount"), nodeCount);
+  result.insert(QStringLiteral("depthHistogram"), depthHistogram);
+  result.insert(QStringLiteral("leafCount"), treeStatistics.leafCount);
+  result.insert(QStringLiteral("averageLeafOccupancy"),
+                treeStatistics.leafCount > 0 ? static_cast<double>(treeStatistics.leafOccupancy) / treeStatistics.leafCount : 0.0);
+  result.insert(QStringLiteral("maxLeafOccupancy"), treeStatistics.maxLeafOccupancy);
+  result.insert(QStringLiteral("queryCount"), queryCount);
+  result.insert(QStringLiteral("averageCandidatesPerQuery"),
+                queryCount > 0 ? static_cast<double>(candidateCount) / queryCount : 0.0);
+
+  return result;
+}
+
+/*!
+  \brief Resets the query counters reported by \l statistics.
+ */
+void GeometryQuadtree::resetQueryStatistics()
+{
+  m_queryCount.store(0, std::memory_order_relaxed);
+  m_candidateCount.store(0, std::memory_order_relaxed);
+}
+
+/*!
+  \brief Adds the \a newGeoElement into the quadtree.
+
+  If the element is already in the tree, its location is updated instead.
+
+  \note The tree will only be re-built if the element lies outside the current extent of the tree.
+ */
+void GeometryQuadtree::appendGeoElement(GeoElement* newGeoElement)
 {
   if (!newGeoElement)
     return;
 
-  const int newKey = handleNewGeoElement(newGeoElement);
-  handleGeometryChange(newKey);
+  auto findIt = m_elementKeys.constFind(newGeoElement);
+  const int key = findIt != m_elementKeys.constEnd() ? findIt.value() : handleNewGeoElement(newGeoElement);
+  handleGeometryChange(key);
 }
 
 /*!
-  \brief Returns the list of \l Geometry objects which are in quadtree cells which intersect \a geometry
+  \brief Updates the location of \a geoElement in the quadtree.
 
-  \note No intersection test is carried out between the supplied Geometry and the results. For exact results,
-  you should perform the desired geometry tests on the list of \l Geometry objects returned.
+  Only the cells which held the element previously and those which hold it now are visited,
+  so an update costs O(log n) unless the element has moved outside the extent of the tree.
+  Elements whose extent has not changed are ignored.
  */
-QList<Geometry> GeometryQuadtree::candidateIntersections(const Geometry& geometry) const
+void GeometryQuadtree::updateGeoElement(GeoElement* geoElement)
 {
-  return candidateIntersections(geometry.extent());
+  auto findIt = m_elementKeys.constFind(geoElement);
+  if (findIt == m_elementKeys.constEnd())
+    return;
+
+  handleGeometryChange(findIt.value());
+}
+
+/*!
+  \brief Removes \a geoElement from the quadtree.
+ */
+void GeometryQuadtree::removeGeoElement(GeoElement* geoElement)
+{
+  auto findIt = m_elementKeys.constFind(geoElement);
+  if (findIt == m_elementKeys.constEnd())
+    return;
+
+  const int key = findIt.value();
+  GeoElementSignaler* signaler = m_elementStorage.value(key);
+  removeKey(key, geoElement);
+
+  // the signaler is owned by the element so it must be deleted explicitly
+  if (signaler)
+  {
+    signaler->disconnect(this);
+    delete signaler;
+  }
 }
 
 /*!
@@ -142,7 +328,9 @@ QList<Geometry> GeometryQuadtree::candidateIntersections(const Envelope& extent)
   const Envelope wgs84 = geometry_cast<Envelope>(GeometryEngine::project(extent, SpatialReference::wgs84()));
 
   // obtain the indices of Geometry objects from quadtree nodes which intersect the extent
-  QSet<int> geomIds = m_tree->intersectingIds(wgs84);
+  QSet<int> geomIds;
+  for (const Envelope& query : wrappedQueries(wgs84, m_tree->m_xMin, m_tree->m_xMax))
+    geomIds += m_tree->intersectingIds(query);
 
   // collect the Geometry objects with an intersecting Id
   QList<Geometry> results;
@@ -158,6 +346,8 @@ QList<Geometry> GeometryQuadtree::candidateIntersections(const Envelope& extent)
     }
   }
 
+  recordQuery(static_cast<int>(results.size()));
+
   return results;
 }
 
@@ -173,7 +363,9 @@ QList<Geometry> GeometryQuadtree::candidateIntersections(const Point& location)
   const Point wgs84 = geometry_cast<Point>(GeometryEngine::project(location, SpatialReference::wgs84()));
 
   // obtain the indices of Geometry objects from quadtree nodes which contain the location
-  QSet<int> geomIds = m_tree->intersectingIds(wgs84);
+  QSet<int> geomIds;
+  for (const Point& query : wrappedQueries(wgs84, m_tree->m_xMin, m_tree->m_xMax))
+    geomIds += m_tree->intersectingIds(query);
 
   // collect the Geometry objects with an intersecting Id
   QList<Geometry> results;
@@ -189,6 +381,8 @@ QList<Geometry> GeometryQuadtree::candidateIntersections(const Point& location)
     }
   }
 
+  recordQuery(static_cast<int>(results.size()));
+
   return results;
 }
 
@@ -198,22 +392,20 @@ QList<Geometry> GeometryQuadtree::candidateIntersections(const Point& location)
 void GeometryQuadtree::buildTree(const Envelope& extent)
 {
   // ensure the tree's extent is in WGS84
-  const Envelope extentWgs84 = geometry_cast<Envelope>(GeometryEngine::project(extent, SpatialReference::wgs84()));
+  const Envelope extentWgs84 = geometry_cast<Envelope>(toWgs84(extent));
 
   // build the (currently empty) tree to the desired depth
   m_tree.reset(new QuadTree(0, extentWgs84.xMin(), extentWgs84.xMax(), extentWgs84.yMin(), extentWgs84.yMax()));
 
-  // assign the geometry of each element to the tree, along with its id in the lookup
-  auto it = m_elementStorage.cbegin();
-  auto itEnd = m_elementStorage.cend();
+  // assign the extent of each element to the tree, along with its id in the lookup
+  auto it = m_elementExtents.cbegin();
+  auto itEnd = m_elementExtents.cend();
   for (; it != itEnd; ++it)
   {
-    GeoElementSignaler* element = it.value();
-    if (!element)
+    if (it.value().isEmpty())
       continue;
 
-    const Geometry wgs84 = GeometryEngine::project(element->geoElement()->geometry(), SpatialReference::wgs84());
-    m_tree->assign(wgs84.extent(), it.key(), m_maxLevels);
+    m_tree->assign(it.value(), it.key(), *this);
   }
 
   // remove any nodes from the tree which contain no geometry
@@ -231,38 +423,41 @@ void GeometryQuadtree::handleGeometryChange(int changedId)
   if (!changedElement)
     return;
 
-  const Geometry wgs84Geom = GeometryEngine::project(changedElement->geoElement()->geometry(), SpatialReference::wgs84());
-  const Envelope wgs84Extent = wgs84Geom.extent();
+  const Envelope wgs84Extent = toWgs84(changedElement->geoElement()->geometry()).extent();
 
-  // if the extent of the changed geom is the same or smaller than the existing tree, it can still be used
-  if (m_tree->m_xMin <= wgs84Extent.xMin() &&
-      m_tree->m_xMax >= wgs84Extent.xMax() &&
-      m_tree->m_yMin <= wgs84Extent.yMin() &&
-      m_tree->m_yMax >= wgs84Extent.yMax())
+  // nothing to do if the element has not moved
+  auto previousIt = m_elementExtents.constFind(changedId);
+  if (previousIt != m_elementExtents.constEnd())
   {
-    m_tree->removeId(changedId);
-    m_tree->assign(wgs84Geom.extent(), changedId, m_maxLevels);
-    m_tree->prune();
+    const Envelope& previous = previousIt.value();
+    if (previous.isEmpty() == wgs84Extent.isEmpty() &&
+        (wgs84Extent.isEmpty() ||
+         (previous.xMin() == wgs84Extent.xMin() &&
+          previous.xMax() == wgs84Extent.xMax() &&
+          previous.yMin() == wgs84Extent.yMin() &&
+          previous.yMax() == wgs84Extent.yMax())))
+      return;
+  }
+
+  m_elementExtents.insert(changedId, wgs84Extent);
+
+  // an element without a location is kept in the lookup but not in the tree
+  if (wgs84Extent.isEmpty())
+  {
+    m_tree->removeId(changedId, mergeThreshold());
+    emit treeChanged();
+  }
+  // if the extent of the changed geom lies within the existing tree, it can still be used
+  else if (treeContains(wgs84Extent))
+  {
+    m_tree->removeId(changedId, mergeThreshold());
+    m_tree->assign(wgs84Extent, changedId, *this);
     emit treeChanged();
   }
   // otherwise calculate the new extent and rebuild the tree
   else
   {
-    QList<Geometry> allGeom;
-    for(auto it = m_elementStorage.begin(); it != m_elementStorage.end(); ++it)
-    {
-      GeoElementSignaler* element = it.value();
-      if (!element)
-        continue;
-
-      if (element->geoElement()->geometry().isEmpty())
-        continue;
-
-      allGeom.append(GeometryEngine::project(element->geoElement()->geometry(), SpatialReference::wgs84()));
-    }
-
-    const Envelope newExtent = GeometryEngine::combineExtents(allGeom);
-    buildTree(newExtent);
+    buildTree(elementsExtent());
   }
 }
 
@@ -281,51 +476,115 @@ int GeometryQuadtree::handleNewGeoElement(GeoElement* geoElement)
   GeoElementSignaler* signaler = new GeoElementSignaler(geoElement, GeoElementUtils::toQObject(geoElement));
 
   m_elementStorage.insert(m_nextKey, signaler);
+  m_elementKeys.insert(geoElement, m_nextKey);
   const int insertedKey = m_nextKey;
   m_nextKey++;
 
-  connect(signaler, &GeoElementSignaler::geometryChanged, this, [this, signaler]()
+  connect(signaler, &GeoElementSignaler::geometryChanged, this, [this, insertedKey]()
   {
-    auto it = m_elementStorage.cbegin();
-    auto itEnd = m_elementStorage.cend();
-    for (; it != itEnd; ++it)
-    {
-      GeoElementSignaler* testElement = it.value();
-      if (!testElement)
-        continue;
-
-      if (testElement == signaler)
-      {
-        handleGeometryChange(it.key());
-        return;
-      }
-    }
+    handleGeometryChange(insertedKey);
   });
 
-  connect(signaler, &GeoElementSignaler::destroyed, this, [this, signaler]()
+  // the element pointer is only used as a lookup key since it is being destroyed
+  connect(signaler, &GeoElementSignaler::destroyed, this, [this, insertedKey, geoElement]()
   {
-    auto it = m_elementStorage.cbegin();
-    auto itEnd = m_elementStorage.cend();
-    for (; it != itEnd; ++it)
-    {
-      GeoElementSignaler* testElement = it.value();
-      if (!testElement)
-        continue;
-
-      if (testElement == signaler)
-      {
-        m_tree->removeId(it.key());
-        m_tree->prune();
-        m_elementStorage.remove(it.key());
-        emit treeChanged();
-        return;
-      }
-    }
+    removeKey(insertedKey, geoElement);
   });
 
   return insertedKey;
 }
 
+/*!
+  \internal
+
+  Removes the \a geoElement stored with \a key from the tree and the lookups.
+ */
+void GeometryQuadtree::removeKey(int key, GeoElement* geoElement)
+{
+  auto findIt = m_elementStorage.find(key);
+  if (findIt == m_elementStorage.end())
+    return;
+
+  m_elementStorage.erase(findIt);
+  m_elementExtents.remove(key);
+  m_elementKeys.remove(geoElement);
+
+  m_tree->removeId(key, mergeThreshold());
+  emit treeChanged();
+}
+
+/*!
+  \internal
+
+  Returns whether \a extent lies within the root of the tree.
+ */
+bool GeometryQuadtree::treeContains(const Envelope& extent) const
+{
+  // a degenerate tree (e.g. one built before any element had a location) cannot hold anything
+  if (!(m_tree->m_xMax > m_tree->m_xMin) || !(m_tree->m_yMax > m_tree->m_yMin))
+    return false;
+
+  return m_tree->contains(extent);
+}
+
+/*!
+  \internal
+
+  Returns the combined WGS84 extent of every element, padded so that elements
+  moving around the edges of the data do not force the tree to be rebuilt.
+ */
+Envelope GeometryQuadtree::elementsExtent() const
+{
+  bool found = false;
+  double xMin = 0.0;
+  double xMax = 0.0;
+  double yMin = 0.0;
+  double yMax = 0.0;
+
+  for (const Envelope& extent : m_elementExtents)
+  {
+    if (extent.isEmpty())
+      continue;
+
+    xMin = found ? std::min(xMin, extent.xMin()) : extent.xMin();
+    xMax = found ? std::max(xMax, extent.xMax()) : extent.xMax();
+    yMin = found ? std::min(yMin, extent.yMin()) : extent.yMin();
+    yMax = found ? std::max(yMax, extent.yMax()) : extent.yMax();
+    found = true;
+  }
+
+  if (!found)
+    return Envelope();
+
+  constexpr double paddingFactor = 0.25;
+  constexpr double minimumPadding = 0.01; // degrees
+  const double xPadding = std::max((xMax - xMin) * paddingFactor, minimumPadding);
+  const double yPadding = std::max((yMax - yMin) * paddingFactor, minimumPadding);
+
+  return Envelope(xMin - xPadding, yMin - yPadding, xMax + xPadding, yMax + yPadding, SpatialReference::wgs84());
+}
+
+/*!
+  \internal
+
+  Returns the number of geometries at or below which a cell's children are merged
+  back into it. This is lower than the node capacity so that an element moving back
+  and forth does not repeatedly split and merge the same cell.
+ */
+int GeometryQuadtree::mergeThreshold() const
+{
+  return m_nodeCapacity / 2;
+}
+
+/*!
+  \internal
+ */
+void GeometryQuadtree::recordQuery(int candidateCount) const
+{
+  m_queryCount.fetch_add(1, std::memory_order_relaxed);
+  m_candidateCount.fetch_add(candidateCount, std::memory_order_relaxed);
+}
+
 /*!
   \internal
  */
@@ -343,61 +602,35 @@ GeometryQuadtree::QuadTree::QuadTree(int level, double xMin, double xMax, double
  */
 GeometryQuadtree::QuadTree::~QuadTree()
 {
-  if (m_tl)
-    delete m_tl;
-
-  if (m_tr)
-    delete m_tr;
-
-  if (m_bl)
-    delete m_bl;
-
-  if (m_br)
-    delete m_br;
+  clearChildren();
 }
 
-GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createTopLeft(int maxLevels)
+GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createTopLeft() const
 {
-  // if we have not reached the max depth of the tree, add the child nodes
-  if (m_level > maxLevels)
-    return nullptr;
-
   const double xMid = ((m_xMax - m_xMin) * 0.5) + m_xMin;
   const double yMid = ((m_yMax - m_yMin) * 0.5) + m_yMin;
 
   return new QuadTree(m_level +1, m_xMin, xMid, yMid, m_yMax);
 }
 
-GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createTopRight(int maxLevels)
+GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createTopRight() const
 {
-  // if we have not reached the max depth of the tree, add the child nodes
-  if (m_level > maxLevels)
-    return nullptr;
-
   const double xMid = ((m_xMax - m_xMin) * 0.5) + m_xMin;
   const double yMid = ((m_yMax - m_yMin) * 0.5) + m_yMin;
 
   return new QuadTree(m_level + 1, xMid, m_xMax, yMid, m_yMax);
 }
 
-GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createBottomLeft(int maxLevels)
+GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createBottomLeft() const
 {
-  // if we have not reached the max depth of the tree, add the child nodes
-  if (m_level > maxLevels)
-    return nullptr;
-
   const double xMid = ((m_xMax - m_xMin) * 0.5) + m_xMin;
   const double yMid = ((m_yMax - m_yMin) * 0.5) + m_yMin;
 
   return new QuadTree(m_level + 1, m_xMin, xMid, m_yMin, yMid);
 }
 
-GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createBottomRight(int maxLevels)
+GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createBottomRight() const
 {
-  // if we have not reached the max depth of the tree, add the child nodes
-  if (m_level > maxLevels)
-    return nullptr;
-
   const double xMid = ((m_xMax - m_xMin) * 0.5) + m_xMin;
   const double yMid = ((m_yMax - m_yMin) * 0.5) + m_yMin;
 
@@ -406,8 +639,12 @@ GeometryQuadtree::QuadTree* GeometryQuadtree::QuadTree::createBottomRight(int ma
 
 /*!
   \internal
+
+  Assigns the geometry \a geomIndex with \a extent to this node. Leaf nodes are only
+  split once they hold more than the node capacity of the \a owner and have not reached
+  its maximum depth, so dense areas get deep trees and sparse areas stay shallow.
  */
-bool GeometryQuadtree::QuadTree::assign(const Envelope& extent, int geomIndex, int maxLevels)
+bool GeometryQuadtree::QuadTree::assign(const Envelope& extent, int geomIndex, const GeometryQuadtree& owner)
 {
   // if the extent of the incoming geometry does not lie within this node, return
   if (!intersects(extent))
@@ -416,17 +653,36 @@ bool GeometryQuadtree::QuadTree::assign(const Envelope& extent, int geomIndex, i
   // record this geometry index
   m_geometryIds.insert(geomIndex);
 
+  if (isLeaf())
+  {
+    // split the leaf once it becomes too full, unless it is already as deep as allowed
+    if (m_geometryIds.size() > owner.m_nodeCapacity && m_level < owner.m_maxLevels)
+      subdivide(owner);
+
+    return true;
+  }
+
+  assignToChildren(extent, geomIndex, owner);
+
+  return true;
+}
+
+/*!
+  \internal
+ */
+void GeometryQuadtree::QuadTree::assignToChildren(const Envelope& extent, int geomIndex, const GeometryQuadtree& owner)
+{
   // (recursively) attempt to assign the geomeytry to each child node
   // if the node already exists, just assign
   if (m_tl)
   {
-    m_tl->assign(extent, geomIndex, maxLevels);
+    m_tl->assign(extent, geomIndex, owner);
   }
   // otherwise, create a temporary node and only keep it if it will contain this geometry
   else
   {
-    QuadTree* temp = createTopLeft(maxLevels);
-    if (temp && temp->assign(extent, geomIndex, maxLevels))
+    QuadTree* temp = createTopLeft();
+    if (temp->assign(extent, geomIndex, owner))
       m_tl = temp;
     else
       delete temp;
@@ -434,12 +690,12 @@ bool GeometryQuadtree::QuadTree::assign(const Envelope& extent, int geomIndex, i
 
   if (m_tr)
   {
-    m_tr->assign(extent, geomIndex, maxLevels);
+    m_tr->assign(extent, geomIndex, owner);
   }
   else
   {
-    QuadTree* temp = createTopRight(maxLevels);
-    if (temp && temp->assign(extent, geomIndex, maxLevels))
+    QuadTree* temp = createTopRight();
+    if (temp->assign(extent, geomIndex, owner))
       m_tr = temp;
     else
       delete temp;
@@ -447,12 +703,12 @@ bool GeometryQuadtree::QuadTree::assign(const Envelope& extent, int geomIndex, i
 
   if (m_bl)
   {
-    m_bl->assign(extent, geomIndex, maxLevels);
+    m_bl->assign(extent, geomIndex, owner);
   }
   else
   {
-    QuadTree* temp = createBottomLeft(maxLevels);
-    if (temp && temp->assign(extent, geomIndex, maxLevels))
+    QuadTree* temp = createBottomLeft();
+    if (temp->assign(extent, geomIndex, owner))
       m_bl = temp;
     else
       delete temp;
@@ -460,18 +716,82 @@ bool GeometryQuadtree::QuadTree::assign(const Envelope& extent, int geomIndex, i
 
   if (m_br)
   {
-    m_br->assign(extent, geomIndex, maxLevels);
+    m_br->assign(extent, geomIndex, owner);
   }
   else
   {
-    QuadTree* temp = createBottomRight(maxLevels);
-    if (temp && temp->assign(extent, geomIndex, maxLevels))
+    QuadTree* temp = createBottomRight();
+    if (temp->assign(extent, geomIndex, owner))
       m_br = temp;
     else
       delete temp;
   }
+}
 
-  return true;
+/*!
+  \internal
+
+  Turns this leaf into an inner node by distributing its geometry to new child nodes.
+ */
+void GeometryQuadtree::QuadTree::subdivide(const GeometryQuadtree& owner)
+{
+  for (const int id : std::as_const(m_geometryIds))
+  {
+    auto findIt = owner.m_elementExtents.constFind(id);
+    if (findIt != owner.m_elementExtents.constEnd())
+      assignToChildren(findIt.value(), id, owner);
+  }
+}
+
+/*!
+  \internal
+ */
+bool GeometryQuadtree::QuadTree::isLeaf() const
+{
+  return !m_tl && !m_tr && !m_bl && !m_br;
+}
+
+/*!
+  \internal
+ */
+void GeometryQuadtree::QuadTree::clearChildren()
+{
+  delete m_tl;
+  delete m_tr;
+  delete m_bl;
+  delete m_br;
+  m_tl = nullptr;
+  m_tr = nullptr;
+  m_bl = nullptr;
+  m_br = nullptr;
+}
+
+/*!
+  \internal
+
+  Adds the nodes of this (sub)tree to \a statistics.
+ */
+void GeometryQuadtree::QuadTree::collectStatistics(TreeStatistics& statistics) const
+{
+  if (statistics.nodesPerDepth.size() <= m_level)
+    statistics.nodesPerDepth.resize(m_level + 1);
+
+  statistics.nodesPerDepth[m_level]++;
+
+  if (isLeaf())
+  {
+    const int occupancy = static_cast<int>(m_geometryIds.size());
+    statistics.leafCount++;
+    statistics.leafOccupancy += occupancy;
+    statistics.maxLeafOccupancy = std::max(statistics.maxLeafOccupancy, occupancy);
+    return;
+  }
+
+  for (const QuadTree* child : {m_tl, m_tr, m_bl, m_br})
+  {
+    if (child)
+      child->collectStatistics(statistics);
+  }
 }
 
 /*!
@@ -619,11 +939,13 @@ bool GeometryQuadtree::QuadTree::contains(const Envelope& extent) const
  */
 bool GeometryQuadtree::QuadTree::intersects(const Envelope& extent) const
 {
-  // return whether the supplied extent overlaps this cell
-  return (extent.xMin() < m_xMax &&
-          extent.xMax() > m_xMin &&
-          extent.yMin() < m_yMax &&
-          extent.yMax() > m_yMin);
+  // return whether the supplied extent overlaps or touches this cell. Edges are
+  // inclusive so that points and lines lying exactly on the boundary between two
+  // cells are assigned to (and found in) both of them
+  return (extent.xMin() <= m_xMax &&
+          extent.xMax() >= m_xMin &&
+          extent.yMin() <= m_yMax &&
+          extent.yMax() >= m_yMin);
 }
 
 /*!
@@ -638,21 +960,42 @@ bool GeometryQuadtree::QuadTree::intersects(const Point& location) const
           location.y() >= m_yMin);
 }
 
-void GeometryQuadtree::QuadTree::removeId(int index)
+/*!
+  \internal
+
+  Removes \a index from this node and any children which contain it. Children
+  which become empty are deleted, so the tree does not need to be pruned afterwards.
+  Once a node holds no more than \a mergeThreshold geometries its children are
+  merged back into it.
+ */
+void GeometryQuadtree::QuadTree::removeId(int index, int mergeThreshold)
 {
   if (m_geometryIds.remove(index))
   {
-    if (m_tl)
-      m_tl->removeId(index);
-
-    if (m_tr)
-      m_tr->removeId(index);
+    removeIdFromChild(m_tl, index, mergeThreshold);
+    removeIdFromChild(m_tr, index, mergeThreshold);
+    removeIdFromChild(m_bl, index, mergeThreshold);
+    removeIdFromChild(m_br, index, mergeThreshold);
+
+    // every node already records the ids of its whole subtree so merging is just dropping the children
+    if (!isLeaf() && m_geometryIds.size() <= mergeThreshold)
+      clearChildren();
+  }
+}
 
-    if (m_bl)
-      m_bl->removeId(index);
+/*!
+  \internal
+ */
+void GeometryQuadtree::QuadTree::removeIdFromChild(QuadTree*& child, int index, int mergeThreshold)
+{
+  if (!child)
+    return;
 
-    if (m_br)
-      m_br->removeId(index);
+  child->removeId(index, mergeThreshold);
+  if (child->m_geometryIds.empty())
+  {
+    delete child;
+    child = nullptr;
   }
 }
 
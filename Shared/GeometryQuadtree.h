@@ -17,16 +17,22 @@
 #ifndef GEOMETRYQUADTREE_H
 #define GEOMETRYQUADTREE_H
 
+// C++ API headers
+#include "Envelope.h"
+
+// DSA headers
+#include "GeometryIndex.h"
+
 // Qt headers
 #include <QHash>
 #include <QList>
-#include <QObject>
+#include <QVariantMap>
 
 // STL headers
+#include <atomic>
 #include <memory>
 
 namespace Esri::ArcGISRuntime {
-  class Envelope;
   class GeoElement;
   class Geometry;
   class Point;
@@ -36,22 +42,41 @@ namespace Dsa {
 
 class GeoElementSignaler;
 
-class GeometryQuadtree : public QObject
+class GeometryQuadtree : public GeometryIndex
 {
   Q_OBJECT
 
 public:
+  static constexpr int DefaultMaxLevels = 16;
+  static constexpr int DefaultNodeCapacity = 16;
+
   GeometryQuadtree(const Esri::ArcGISRuntime::Envelope& extent,
                    const QList<Esri::ArcGISRuntime::GeoElement*>& geoElements,
                    int maxLevels,
                    QObject* parent = nullptr);
+  GeometryQuadtree(const Esri::ArcGISRuntime::Envelope& extent,
+                   const QList<Esri::ArcGISRuntime::GeoElement*>& geoElements,
+                   int maxLevels,
+                   int nodeCapacity,
+                   QObject* parent = nullptr);
   ~GeometryQuadtree();
 
-  void appendGeoElment(Esri::ArcGISRuntime::GeoElement* newGeoElement);
+  int maxLevels() const;
+  void setMaxLevels(int maxLevels);
+
+  int nodeCapacity() const;
+  void setNodeCapacity(int nodeCapacity);
+
+  QVariantMap statistics() const override;
+  void resetQueryStatistics();
 
-  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Geometry& geometry) const;
-  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Envelope& extent) const;
-  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Point& location) const;
+  void appendGeoElement(Esri::ArcGISRuntime::GeoElement* newGeoElement) override;
+  void updateGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement) override;
+  void removeGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement) override;
+
+  using GeometryIndex::candidateIntersections;
+  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Envelope& extent) const override;
+  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Point& location) const override;
 
 signals:
   void treeChanged();
@@ -60,13 +85,24 @@ private:
   void buildTree(const Esri::ArcGISRuntime::Envelope& extent);
   void handleGeometryChange(int changedIndex);
   int handleNewGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement);
+  void removeKey(int key, Esri::ArcGISRuntime::GeoElement* geoElement);
+  bool treeContains(const Esri::ArcGISRuntime::Envelope& extent) const;
+  Esri::ArcGISRuntime::Envelope elementsExtent() const;
+  int mergeThreshold() const;
+  void recordQuery(int candidateCount) const;
 
   struct QuadTree;
 
   int m_maxLevels;
+  int m_nodeCapacity;
   std::unique_ptr<QuadTree> m_tree;
   QHash<int, GeoElementSignaler*> m_elementStorage;
+  QHash<int, Esri::ArcGISRuntime::Envelope> m_elementExtents;
+  QHash<Esri::ArcGISRuntime::GeoElement*, int> m_elementKeys;
   int m_nextKey = 0;
+
+  mutable std::atomic<qint64> m_queryCount{0};
+  mutable std::atomic<qint64> m_candidateCount{0};
 };
 
 } // Dsa
@@ -0,0 +1,470 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// PCH header
+#include "pch.hpp"
+
+#include "GpxTrack.h"
+
+// DSA headers
+#include "Geodesy.h"
+
+// Qt headers
+#include <QDate>
+#include <QXmlStreamReader>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+namespace Dsa {
+
+namespace
+{
+// the Julian day of 1970-01-01
+constexpr qint64 c_julianDayOfEpoch = 2440588;
+
+constexpr qint64 c_secondsPerDay = 24 * 60 * 60;
+
+/*!
+  \internal
+
+  Returns the heading \a weight of the way from \a from to \a to, turning the shorter way round.
+ */
+double turn(double from, double to, double weight)
+{
+  const double difference = std::remainder(to - from, 360.0);
+  return std::fmod(from + difference * weight + 360.0, 360.0);
+}
+
+/*!
+  \internal
+
+  Returns the number made of the \a count digits at \a from in \a text, or -1.
+ */
+int digits(QStringView text, qsizetype from, qsizetype count)
+{
+  if (from + count > text.size())
+    return -1;
+
+  int value = 0;
+  for (qsizetype i = from; i < from + count; ++i)
+  {
+    if (!text[i].isDigit())
+      return -1;
+
+    value = value * 10 + text[i].digitValue();
+  }
+
+  return value;
+}
+
+/*!
+  \internal
+
+  Sets \a msecsSinceEpoch to the ISO 8601 \a time, such as 2017-03-21T17:31:56.250Z. Times
+  without an offset are in UTC, as GPX requires. Returns whether the time could be read.
+ */
+bool parseTime(QStringView time, qint64& msecsSinceEpoch)
+{
+  // the common forms are read directly, since QDateTime is slow for hundreds of thousands of points
+  if (time.size() >= 19 && time[4] == QLatin1Char('-') && time[7] == QLatin1Char('-') &&
+      (time[10] == QLatin1Char('T') || time[10] == QLatin1Char('t') || time[10] == QLatin1Char(' ')) &&
+      time[13] == QLatin1Char(':') && time[16] == QLatin1Char(':'))
+  {
+    const QDate date(digits(time, 0, 4), digits(time, 5, 2), digits(time, 8, 2));
+    const int hours = digits(time, 11, 2);
+    const int minutes = digits(time, 14, 2);
+    const int seconds = digits(time, 17, 2);
+
+    qsizetype position = 19;
+    qint64 milliseconds = 0;
+    if (position < time.size() && (time[position] == QLatin1Char('.') || time[position] == QLatin1Char(',')))
+    {
+      // digits beyond milliseconds are ignored
+      int scale = 100;
+      for (++position; position < time.size() && time[position].isDigit(); ++position)
+      {
+        milliseconds += time[position].digitValue() * scale;
+        scale /= 10;
+      }
+    }
+
+    const QStringView zone = time.mid(position);
+    int offsetMinutes = 0;
+    bool zoneOk = zone.isEmpty() || zone.compare(QLatin1String("Z"), Qt::CaseInsensitive) == 0;
+    if (!zoneOk && (zone.size() == 3 || zone.size() == 5 || zone.size() == 6) &&
+        (zone[0] == QLatin1Char('+') || zone[0] == QLatin1Char('-')))
+    {
+      const int offsetHours = digits(zone, 1, 2);
+      const int offsetMins = zone.size() == 3 ? 0 : digits(zone, zone.size() - 2, 2);
+      zoneOk = offsetHours >= 0 && offsetMins >= 0 && (zone.size() != 6 || zone[3] == QLatin1Char(':'));
+      offsetMinutes = (offsetHours * 60 + offsetMins) * (zone[0] == QLatin1Char('-') ? -1 : 1);
+    }
+
+    if (date.isValid() && hours >= 0 && hours < 24 && minutes >= 0 && minutes < 60 && seconds >= 0 && seconds < 61 && zoneOk)
+    {
+      const qint64 secondsSinceEpoch = (date.toJulianDay() - c_julianDayOfEpoch) * c_secondsPerDay +
+          hours * 3600 + minutes * 60 + seconds - offsetMinutes * 60;
+      msecsSinceEpoch = secondsSinceEpoch * 1000 + milliseconds;
+      return true;
+    }
+  }
+
+  // anything else, such as a date without a time, is left to QDateTime
+  QDateTime dateTime = QDateTime::fromString(time.toString(), Qt::ISODateWithMs);
+  if (!dateTime.isValid())
+    return false;
+
+  if (dateTime.timeSpec() == Qt::LocalTime)
+    dateTime.setTimeSpec(Qt::UTC);
+
+  msecsSinceEpoch = dateTime.toMSecsSinceEpoch();
+  return true;
+}
+
+} // namespace
+
+/*!
+  \class Dsa::GpxTrack
+  \inmodule Dsa
+  \brief A GPX track, read once into an array of timed samples.
+
+  Track point times are read in full, dates included, and are kept in milliseconds
+  from the first point. Between two points a position moves along the great circle
+  at a constant speed, and its heading can turn smoothly at each point; see
+  \l setHeadingSmoothing.
+
+  Finding the segment for a time is a binary search, or a step or two forward from
+  the segment of a slightly earlier time, so evaluating a position costs the same
+  however long the track is. Tracks are read only, so one track can be shared by
+  any number of simulated entities.
+ */
+
+/*!
+  \brief Constructor for an empty track.
+ */
+GpxTrack::GpxTrack()
+{
+}
+
+/*!
+  \brief Reads every track point of \a gpxData, replacing any read before.
+
+  Repeated points at the same place are kept with their times, so the track stops
+  there and holds the heading it arrived with. Points without a time are reached at
+  the same time as the point before them. Returns \c false if the track has fewer
+  than two points.
+ */
+bool GpxTrack::read(const QByteArray& gpxData)
+{
+  m_samples.clear();
+  m_startTime = QDateTime();
+
+  QXmlStreamReader reader(gpxData);
+  TrackSample sample;
+  bool inTrackPoint = false;
+  bool hasTime = false;
+  qint64 firstTime = 0;
+
+  while (!reader.atEnd() && !reader.hasError())
+  {
+    const QXmlStreamReader::TokenType token = reader.readNext();
+    if (token == QXmlStreamReader::StartElement)
+    {
+      const QStringView name = reader.name();
+      if (name.compare(QLatin1String("trkpt"), Qt::CaseInsensitive) == 0)
+      {
+        // a point without a time stamp is reached at the same time as the one before it
+        const QXmlStreamAttributes attributes = reader.attributes();
+        sample.x = attributes.value(QLatin1String("lon")).toDouble();
+        sample.y = attributes.value(QLatin1String("lat")).toDouble();
+        sample.z = NAN;
+        inTrackPoint = true;
+      }
+      else if (inTrackPoint && name.compare(QLatin1String("ele"), Qt::CaseInsensitive) == 0)
+      {
+        sample.z = reader.readElementText().toDouble();
+      }
+      else if (inTrackPoint && name.compare(QLatin1String("time"), Qt::CaseInsensitive) == 0)
+      {
+        qint64 time = 0;
+        if (!parseTime(reader.readElementText(), time))
+          continue;
+
+        if (!hasTime)
+        {
+          hasTime = true;
+          firstTime = time;
+          m_startTime = QDateTime::fromMSecsSinceEpoch(time, Qt::UTC);
+        }
+
+        // a step back in time is treated as no time passing, to keep the samples in time order
+        sample.time = std::max(sample.time, time - firstTime);
+      }
+    }
+    else if (token == QXmlStreamReader::EndElement && inTrackPoint &&
+             reader.name().compare(QLatin1String("trkpt"), Qt::CaseInsensitive) == 0)
+    {
+      inTrackPoint = false;
+      m_samples.push_back(sample);
+    }
+  }
+
+  // a malformed file is read up to the point where it could be read
+  m_samples.shrink_to_fit();
+  if (!m_startTime.isValid())
+    m_startTime = QDateTime::currentDateTimeUtc();
+
+  // the segments are measured once, so no position has more work to do than another
+  for (size_t i = 0; i + 1 < m_samples.size(); ++i)
+    m_samples[i].angle = Geodesy::angleBetween(m_samples[i].x, m_samples[i].y, m_samples[i + 1].x, m_samples[i + 1].y);
+
+  // a stop holds the heading the track arrived with, or before the first move the heading it leaves with
+  const int segmentCount = static_cast<int>(m_samples.size()) - 1;
+  double heldHeading = 0.0;
+  for (int i = 0; i < segmentCount; ++i)
+  {
+    if (!isStop(i))
+    {
+      heldHeading = Geodesy::bearingBetween(m_samples[i].x, m_samples[i].y, m_samples[i + 1].x, m_samples[i + 1].y);
+      break;
+    }
+  }
+
+  for (int i = 0; i < segmentCount; ++i)
+  {
+    m_samples[i].heading = heldHeading;
+    if (!isStop(i))
+    {
+      const TrackSample& start = m_samples[i];
+      const TrackSample& end = m_samples[i + 1];
+      heldHeading = std::fmod(Geodesy::bearingBetween(end.x, end.y, start.x, start.y) + 180.0, 360.0);
+    }
+  }
+
+  return !isEmpty();
+}
+
+/*!
+  \brief Returns \c true if the track has fewer than two points.
+ */
+bool GpxTrack::isEmpty() const
+{
+  return m_samples.size() < 2;
+}
+
+/*!
+  \brief Returns the number of points of the track.
+ */
+int GpxTrack::sampleCount() const
+{
+  return static_cast<int>(m_samples.size());
+}
+
+/*!
+  \brief Returns the time in milliseconds from the first to the last point of the track.
+ */
+qint64 GpxTrack::duration() const
+{
+  return m_samples.empty() ? 0 : m_samples.back().time;
+}
+
+/*!
+  \brief Returns the time of the first point of the track in UTC.
+
+  A track without times starts at the time it was read.
+ */
+QDateTime GpxTrack::startTime() const
+{
+  return m_startTime;
+}
+
+/*!
+  \brief Returns the time in milliseconds over which the heading turns at each point of the track.
+ */
+int GpxTrack::headingSmoothing() const
+{
+  return m_headingSmoothing;
+}
+
+/*!
+  \brief Sets the time in milliseconds over which the heading turns at each point of the track to \a msecs.
+
+  The turn is centred on the point and takes at most half of the segments either side.
+  The default of 0 turns to the heading of the next segment at once.
+ */
+void GpxTrack::setHeadingSmoothing(int msecs)
+{
+  m_headingSmoothing = std::max(msecs, 0);
+}
+
+/*!
+  \brief Returns the index of the point which starts the segment containing \a time.
+ */
+int GpxTrack::segmentIndex(qint64 time) const
+{
+  if (isEmpty())
+    return 0;
+
+  // the first sample which comes after the time ends the segment
+  const auto it = std::upper_bound(m_samples.cbegin(), m_samples.cend(), time, [](qint64 value, const TrackSample& sample)
+  {
+    return value < sample.time;
+  });
+
+  const int index = static_cast<int>(it - m_samples.cbegin()) - 1;
+  return std::clamp(index, 0, static_cast<int>(m_samples.size()) - 2);
+}
+
+/*!
+  \brief Returns the index of the point which starts the segment containing \a time,
+  starting from the segment \a hint of an earlier time.
+
+  Times which move forward by less than a few segments at a time are found by stepping
+  forward; any other time is found by binary search.
+ */
+int GpxTrack::segmentIndex(qint64 time, int hint) const
+{
+  constexpr int maxSteps = 4;
+
+  const int lastSegment = static_cast<int>(m_samples.size()) - 2;
+  if (hint < 0 || hint > lastSegment || m_samples[hint].time > time)
+    return segmentIndex(time);
+
+  for (int step = 0; step < maxSteps; ++step)
+  {
+    if (hint == lastSegment || m_samples[hint + 1].time >= time)
+      return hint;
+
+    ++hint;
+  }
+
+  return segmentIndex(time);
+}
+
+/*!
+  \brief Returns the position at \a time milliseconds from the start of the track, on the
+  segment starting at the point \a segment.
+
+  \sa segmentIndex
+ */
+GpxTrack::Position GpxTrack::position(qint64 time, int segment) const
+{
+  Position result;
+  if (isEmpty())
+    return result;
+
+  segment = std::clamp(segment, 0, static_cast<int>(m_samples.size()) - 2);
+  const TrackSample& start = m_samples[segment];
+  const TrackSample& end = m_samples[segment + 1];
+
+  // normalize the time across the segment
+  const qint64 span = end.time - start.time;
+  const double normalizedTime = span > 0 ? std::clamp(static_cast<double>(time - start.time) / span, 0.0, 1.0) : 1.0;
+
+  // the position moves along the great circle between the points at a constant speed
+  Geodesy::interpolate(start.x, start.y, end.x, end.y, start.angle, normalizedTime, result.x, result.y);
+
+  result.z = start.z + (end.z - start.z) * normalizedTime;
+  if (std::isnan(start.z) || std::isnan(end.z))
+    result.z = std::isnan(start.z) ? end.z : start.z;
+
+  // a stop has no heading of its own, so it keeps the one it arrived with
+  if (isStop(segment))
+  {
+    result.heading = start.heading;
+    return result;
+  }
+
+  // the heading along a great circle changes as it is followed. It is taken towards the
+  // nearer end of the segment, where it is least sensitive to the position
+  const double heading = normalizedTime < 0.5 ? Geodesy::bearingBetween(result.x, result.y, end.x, end.y)
+                                              : std::fmod(Geodesy::bearingBetween(result.x, result.y, start.x, start.y) + 180.0, 360.0);
+  result.heading = smoothedHeading(heading, time, segment);
+  result.speed = span > 0 ? start.angle * Geodesy::EarthRadius * 1000.0 / span : 0.0;
+
+  return result;
+}
+
+/*!
+  \internal
+
+  Returns \c true if the segment starting at the point \a segment repeats the same place.
+ */
+bool GpxTrack::isStop(int segment) const
+{
+  const TrackSample& start = m_samples[segment];
+  const TrackSample& end = m_samples[segment + 1];
+
+  return start.x == end.x && start.y == end.y;
+}
+
+/*!
+  \internal
+
+  Returns \a heading turned towards the heading of the neighbouring segment when \a time
+  is within the smoothing time of either end of the segment starting at \a segment.
+ */
+double GpxTrack::smoothedHeading(double heading, qint64 time, int segment) const
+{
+  if (m_headingSmoothing <= 0)
+    return heading;
+
+  const TrackSample& start = m_samples[segment];
+  const TrackSample& end = m_samples[segment + 1];
+
+  // around each point the heading turns from the arriving segment's to the departing one's,
+  // and is halfway round at the point itself
+  const double startTime = vertexSmoothingTime(segment);
+  if (startTime > 0.0 && time - start.time < startTime)
+  {
+    const TrackSample& previous = m_samples[segment - 1];
+    const double arrival = std::fmod(Geodesy::bearingBetween(start.x, start.y, previous.x, previous.y) + 180.0, 360.0);
+    return turn(arrival, heading, 0.5 + (time - start.time) / (2.0 * startTime));
+  }
+
+  const double endTime = vertexSmoothingTime(segment + 1);
+  if (endTime > 0.0 && end.time - time < endTime)
+  {
+    const TrackSample& next = m_samples[segment + 2];
+    const double departure = Geodesy::bearingBetween(end.x, end.y, next.x, next.y);
+    return turn(heading, departure, 0.5 - (end.time - time) / (2.0 * endTime));
+  }
+
+  return heading;
+}
+
+/*!
+  \internal
+
+  Returns the time in milliseconds either side of the point at \a vertex over which the
+  heading turns.
+ */
+double GpxTrack::vertexSmoothingTime(int vertex) const
+{
+  // the ends of the track have no turn, and nor do stops, which hold their heading
+  if (vertex <= 0 || vertex >= static_cast<int>(m_samples.size()) - 1 || isStop(vertex - 1) || isStop(vertex))
+    return 0.0;
+
+  // a turn takes at most half of either segment, so the turns at consecutive points never overlap
+  const qint64 before = m_samples[vertex].time - m_samples[vertex - 1].time;
+  const qint64 after = m_samples[vertex + 1].time - m_samples[vertex].time;
+
+  return std::min({m_headingSmoothing / 2.0, before / 2.0, after / 2.0});
+}
+
+} // Dsa
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef GPXTRACK_H
+#define GPXTRACK_H
+
+// Qt headers
+#include <QByteArray>
+#include <QDateTime>
+
+// STL headers
+#include <cmath>
+#include <vector>
+
+namespace Dsa {
+
+class GpxTrack
+{
+public:
+  // a point on the track at a given time, with the heading in degrees and the speed in metres per second
+  struct Position
+  {
+    double x = 0.0;
+    double y = 0.0;
+    double z = NAN;
+    double heading = 0.0;
+    double speed = 0.0;
+  };
+
+  GpxTrack();
+
+  bool read(const QByteArray& gpxData);
+
+  bool isEmpty() const;
+  int sampleCount() const;
+  qint64 duration() const;
+  QDateTime startTime() const;
+
+  int headingSmoothing() const;
+  void setHeadingSmoothing(int msecs);
+
+  int segmentIndex(qint64 time) const;
+  int segmentIndex(qint64 time, int hint) const;
+  Position position(qint64 time, int segment) const;
+
+private:
+  // a track point, timed in milliseconds from the first point of the track
+  struct TrackSample
+  {
+    qint64 time = 0;
+    double x = 0.0;
+    double y = 0.0;
+    // NaN when the point has no elevation
+    double z = 0.0;
+    // the great circle angle in radians to the next point
+    double angle = 0.0;
+    // the heading in degrees held while the track stays at this point
+    double heading = 0.0;
+  };
+
+  bool isStop(int segment) const;
+  double smoothedHeading(double heading, qint64 time, int segment) const;
+  double vertexSmoothingTime(int vertex) const;
+
+  std::vector<TrackSample> m_samples;
+  QDateTime m_startTime;
+
+  // milliseconds over which the heading turns from one segment to the next; 0 turns at once
+  int m_headingSmoothing = 0;
+};
+
+} // Dsa
+
+#endif // GPXTRACK_H
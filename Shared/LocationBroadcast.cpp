@@ -21,16 +21,20 @@
 
 // dsa app headers
 #include "DataSender.h"
+#include "Geodesy.h"
 
 // toolkit headers
 #include "ToolResourceProvider.h"
 
 // Qt headers
+#include <QDateTime>
 #include <QHostInfo>
 #include <QTimer>
-#include <QUdpSocket>
 #include <QUuid>
 
+// STL headers
+#include <algorithm>
+
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
@@ -50,6 +54,12 @@ static const QString s_locationBroadcastSic{QStringLiteral("SFGPEVAL-------")};
   The broadcast should typically be configured with an existing message feed type
   over an existing message feed UDP port.
 
+  The location is checked every \l frequency milliseconds, and sent only when it has
+  moved more than \l distanceThreshold metres from the last location sent, or when
+  nothing has been sent for \l heartbeatInterval milliseconds. A stationary device
+  therefore only sends a heartbeat, while a moving one is never shown further than
+  the threshold from where it is.
+
   \sa MessageFeedsController
   \sa setMessageType
   \sa setUdpPort
@@ -134,7 +144,7 @@ void LocationBroadcast::setLocation(const Point& location)
 
   m_location = location;
 
-  broadcastLocation();
+  broadcastLocation(true);
 }
 
 /*!
@@ -215,9 +225,9 @@ void LocationBroadcast::setUdpPort(int port)
 }
 
 /*!
-   \brief Returns the frequency of broadcasted location updates.
+   \brief Returns how often, in milliseconds, the location is checked for broadcasting.
 
-   The frequency value is in milliseconds. The default is \c 3000 milliseconds
+   The default is \c 3000 milliseconds
  */
 int LocationBroadcast::frequency() const
 {
@@ -225,7 +235,7 @@ int LocationBroadcast::frequency() const
 }
 
 /*!
-   \brief Sets the frequency, in milliseconds, of broadcasted location updates to \a frequency.
+   \brief Sets how often, in milliseconds, the location is checked for broadcasting to \a frequency.
 
    Setting the frequency to a new value will adjust the current broadcast of
    location updates.
@@ -243,6 +253,49 @@ void LocationBroadcast::setFrequency(int frequency)
     m_timer->setInterval(m_frequency);
 }
 
+/*!
+   \brief Returns the distance in metres the location must move from the last location
+   sent before it is sent again.
+
+   The default is \c 10 metres.
+ */
+double LocationBroadcast::distanceThreshold() const
+{
+  return m_distanceThreshold;
+}
+
+/*!
+   \brief Sets the distance in metres the location must move from the last location
+   sent before it is sent again to \a distanceThreshold.
+
+   A threshold of \c 0 sends every location which has moved at all.
+ */
+void LocationBroadcast::setDistanceThreshold(double distanceThreshold)
+{
+  m_distanceThreshold = std::max(distanceThreshold, 0.0);
+}
+
+/*!
+   \brief Returns the longest time in milliseconds between two messages.
+
+   The default is \c 30000 milliseconds.
+ */
+int LocationBroadcast::heartbeatInterval() const
+{
+  return m_heartbeatInterval;
+}
+
+/*!
+   \brief Sets the longest time in milliseconds between two messages to \a heartbeatInterval.
+
+   The location is sent after this long even if it has not moved, so receivers know the
+   broadcast is still alive. The heartbeat is only as precise as \l frequency.
+ */
+void LocationBroadcast::setHeartbeatInterval(int heartbeatInterval)
+{
+  m_heartbeatInterval = std::max(heartbeatInterval, 0);
+}
+
 /*!
    \brief Returns \c true if the location broadcast reports
    message status as being in distress.
@@ -270,6 +323,9 @@ void LocationBroadcast::setInDistress(bool inDistress)
 
   m_inDistress = inDistress;
 
+  // a changed message is sent on the next check, however far the location has moved
+  updateAttribute(Message::GEOMESSAGE_STATUS_911_NAME, m_inDistress ? 1 : 0);
+
   if (m_inDistress && !isEnabled())
     setEnabled(true);
 }
@@ -298,6 +354,13 @@ void LocationBroadcast::update()
   if (m_messageType.isEmpty() || m_udpPort == -1)
     return;
 
+  // a new broadcast starts with a full message
+  if (!m_message.isEmpty())
+    m_message.setMessageType(m_messageType);
+  m_templateChanged = true;
+  m_sentLocation = Point();
+  m_sinceSent.invalidate();
+
   if (m_dataSender)
   {
     delete m_dataSender;
@@ -307,9 +370,7 @@ void LocationBroadcast::update()
 
   m_dataSender = new DataSender(this);
 
-  QUdpSocket* udpSocket = new QUdpSocket(m_dataSender);
-  udpSocket->connectToHost(QHostAddress::Broadcast, m_udpPort, QIODevice::WriteOnly);
-  m_dataSender->setDevice(udpSocket);
+  m_dataSender->setUdpTarget(QHostAddress::Broadcast, m_udpPort);
 
   m_timer = new QTimer(m_dataSender);
   connect(m_timer, &QTimer::timeout, this, [this]
@@ -338,10 +399,15 @@ void LocationBroadcast::update()
    \brief Broadcasts the current location with the configured
    message feed type and UDP port.
 
-   This function updates the current message with the current location
-   and broadcasts the message in GeoMessage format.
+   Receivers show the last location they were sent until the next message, so the
+   location is sent only when it has moved more than \l distanceThreshold metres from
+   that, when the message itself has changed, or after \l heartbeatInterval
+   milliseconds without a message. Set \a force to send regardless.
+
+   The message is serialized in GeoMessage format once, as a template, and only the
+   position and time stamp are written into it for each send.
  */
-void LocationBroadcast::broadcastLocation()
+void LocationBroadcast::broadcastLocation(bool force)
 {
   if (!m_enabled || !m_dataSender || m_location.isEmpty())
     return;
@@ -360,21 +426,89 @@ void LocationBroadcast::broadcastLocation()
     const int status911 = m_inDistress ? 1 : 0;
     attribs.insert(Message::GEOMESSAGE_STATUS_911_NAME, status911);
     m_message.setAttributes(attribs);
+    m_templateChanged = true;
   }
-  else
-  {
-    m_message.setGeometry(m_location);
 
-    QVariantMap attribs = m_message.attributes();
+  const bool heartbeatDue = !m_sinceSent.isValid() || m_sinceSent.hasExpired(m_heartbeatInterval);
+  const bool moved = m_sentLocation.isEmpty() || Geodesy::distanceBetween(m_sentLocation.x(), m_sentLocation.y(), m_location.x(), m_location.y()) > m_distanceThreshold;
+  if (!force && !m_templateChanged && !heartbeatDue && !moved)
+    return;
 
-    const int status911 = m_inDistress ? 1 : 0;
-    attribs.insert(Message::GEOMESSAGE_STATUS_911_NAME, status911);
-    m_message.setAttributes(attribs);
+  m_message.setGeometry(m_location);
+  emit messageChanged();
+
+  if (m_templateChanged)
+    m_templateChanged = !buildTemplate();
+
+  // a message whose template could not be split is serialized in full
+  m_dataSender->sendData(m_templateChanged ? m_message.toGeoMessage() : templateMessage());
+
+  m_sentLocation = m_location;
+  m_sinceSent.start();
+}
+
+/*!
+   \internal
+   \brief Serializes the message once and splits it around the text of its position
+   and time stamp.
+
+   Returns \c false if the serialized message has no place for either.
+ */
+bool LocationBroadcast::buildTemplate()
+{
+  // the time stamp is written as an attribute, after the control points
+  Message templateSource = m_message;
+  QVariantMap attribs = templateSource.attributes();
+  attribs.insert(Message::GEOMESSAGE_DATETIME_VALID_NAME, QString());
+  templateSource.setAttributes(attribs);
+
+  const QByteArray serialized = templateSource.toGeoMessage();
+  const QByteArray controlPointsStart = '<' + Message::GEOMESSAGE_CONTROL_POINTS_NAME.toUtf8() + '>';
+  const QByteArray controlPointsEnd = "</" + Message::GEOMESSAGE_CONTROL_POINTS_NAME.toUtf8() + '>';
+  const QByteArray dateTimeElement = '<' + Message::GEOMESSAGE_DATETIME_VALID_NAME.toUtf8() + "></" + Message::GEOMESSAGE_DATETIME_VALID_NAME.toUtf8() + '>';
+
+  const qsizetype headEnd = serialized.indexOf(controlPointsStart);
+  const qsizetype middleStart = serialized.indexOf(controlPointsEnd, headEnd);
+  // an empty element may be written in its short form
+  qsizetype dateTimeStart = serialized.indexOf(dateTimeElement, middleStart);
+  qsizetype dateTimeLength = dateTimeElement.size();
+  if (dateTimeStart < 0)
+  {
+    const QByteArray emptyDateTimeElement = '<' + Message::GEOMESSAGE_DATETIME_VALID_NAME.toUtf8() + "/>";
+    dateTimeStart = serialized.indexOf(emptyDateTimeElement, middleStart);
+    dateTimeLength = emptyDateTimeElement.size();
   }
 
-  emit messageChanged();
+  if (headEnd < 0 || middleStart < 0 || dateTimeStart < 0)
+    return false;
+
+  const QByteArray dateTimeStartTag = '<' + Message::GEOMESSAGE_DATETIME_VALID_NAME.toUtf8() + '>';
+  const QByteArray dateTimeEndTag = "</" + Message::GEOMESSAGE_DATETIME_VALID_NAME.toUtf8() + '>';
+
+  m_templateHead = serialized.left(headEnd + controlPointsStart.size());
+  m_templateMiddle = serialized.mid(middleStart, dateTimeStart - middleStart) + dateTimeStartTag;
+  m_templateTail = dateTimeEndTag + serialized.mid(dateTimeStart + dateTimeLength);
 
-  m_dataSender->sendData(m_message.toGeoMessage());
+  return true;
+}
+
+/*!
+   \internal
+   \brief Returns the message template with the current position and time stamp written into it.
+ */
+QByteArray LocationBroadcast::templateMessage() const
+{
+  // written as Message::toGeoMessage writes them
+  const QByteArray x = QByteArray::number(m_location.x(), 'g', 9);
+  const QByteArray y = QByteArray::number(m_location.y(), 'g', 9);
+  const QByteArray dateTime = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs).toLatin1();
+
+  QByteArray message;
+  message.reserve(m_templateHead.size() + x.size() + 1 + y.size() + m_templateMiddle.size() + dateTime.size() + m_templateTail.size());
+  message.append(m_templateHead).append(x).append(',').append(y);
+  message.append(m_templateMiddle).append(dateTime).append(m_templateTail);
+
+  return message;
 }
 
 /*!
@@ -415,12 +549,23 @@ void LocationBroadcast::setUserName(const QString& userName)
 
   m_userName = userName;
 
-  if (!m_message.isEmpty())
-  {
-    QVariantMap attribs = m_message.attributes();
-    attribs.insert(Message::GEOMESSAGE_UNIQUE_DESIGNATION_NAME, m_userName);
-    m_message.setAttributes(attribs);
-  }
+  updateAttribute(Message::GEOMESSAGE_UNIQUE_DESIGNATION_NAME, m_userName);
+}
+
+/*!
+   \internal
+   \brief Sets the attribute \a name of the message to \a value, and marks the message
+   template for rebuilding.
+ */
+void LocationBroadcast::updateAttribute(const QString& name, const QVariant& value)
+{
+  if (m_message.isEmpty())
+    return;
+
+  QVariantMap attribs = m_message.attributes();
+  attribs.insert(name, value);
+  m_message.setAttributes(attribs);
+  m_templateChanged = true;
 }
 
 // Signal Documentation
@@ -18,6 +18,7 @@
 #define LOCATIONBROADCAST_H
 
 // Qt headers
+#include <QElapsedTimer>
 #include <QObject>
 
 // C++ API headers
@@ -60,6 +61,12 @@ public:
   int frequency() const;
   void setFrequency(int frequency);
 
+  double distanceThreshold() const;
+  void setDistanceThreshold(double distanceThreshold);
+
+  int heartbeatInterval() const;
+  void setHeartbeatInterval(int heartbeatInterval);
+
   bool isInDistress() const;
   void setInDistress(bool inDistress);
 
@@ -75,8 +82,11 @@ private:
   Q_DISABLE_COPY(LocationBroadcast)
 
   void update();
-  void broadcastLocation();
+  void broadcastLocation(bool force = false);
   void removeBroadcast();
+  void updateAttribute(const QString& name, const QVariant& value);
+  bool buildTemplate();
+  QByteArray templateMessage() const;
 
   QString m_userName;
   bool m_enabled = true;
@@ -86,11 +96,23 @@ private:
   int m_udpPort = -1;
   int m_frequency = 3000;
   bool m_inDistress = false;
+  double m_distanceThreshold = 10.0;
+  int m_heartbeatInterval = 30000;
 
   DataSender* m_dataSender = nullptr;
   Message m_message;
   QTimer* m_timer = nullptr;
 
+  // the serialized message, split around the position and time stamp patched into it on each send
+  QByteArray m_templateHead;
+  QByteArray m_templateMiddle;
+  QByteArray m_templateTail;
+  bool m_templateChanged = true;
+
+  // what receivers show until the next message
+  Esri::ArcGISRuntime::Point m_sentLocation;
+  QElapsedTimer m_sinceSent;
+
   QMetaObject::Connection m_locationChangedConn;
 };
 
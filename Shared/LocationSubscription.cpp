@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "LocationSubscription.h"
+
+// DSA headers
+#include "Geodesy.h"
+
+// Qt headers
+#include <QTimer>
+
+// STL headers
+#include <algorithm>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+/*!
+  \class Dsa::LocationSubscription
+  \inmodule Dsa
+  \inherits QObject
+  \brief A subscription to the device location at a limited rate.
+
+  Each location received by \l onLocationChanged is passed on by
+  \l locationChanged only when it is at least \l minimumDistance metres from the
+  last location passed on, and no sooner than \l minimumInterval milliseconds after
+  it. Locations which arrive sooner are coalesced: the latest of them is passed on
+  once the interval has passed, so the subscriber always ends up with the most
+  recent location without doing its work for every one.
+
+  Subscriptions are created with ToolResourceProvider::subscribeToLocation.
+ */
+
+/*!
+  \brief Constructor taking the \a minimumInterval in milliseconds, the \a minimumDistance
+  in metres and an optional \a parent.
+ */
+LocationSubscription::LocationSubscription(int minimumInterval, double minimumDistance, QObject* parent) :
+  QObject(parent),
+  m_minimumInterval(std::max(minimumInterval, 0)),
+  m_minimumDistance(std::max(minimumDistance, 0.0)),
+  m_timer(new QTimer(this))
+{
+  m_timer->setSingleShot(true);
+  connect(m_timer, &QTimer::timeout, this, [this]
+  {
+    if (hasMoved(m_pendingLocation))
+      deliver();
+  });
+}
+
+/*!
+  \brief Destructor.
+ */
+LocationSubscription::~LocationSubscription()
+{
+}
+
+/*!
+  \brief Returns the shortest time in milliseconds between two locations passed on.
+ */
+int LocationSubscription::minimumInterval() const
+{
+  return m_minimumInterval;
+}
+
+/*!
+  \brief Sets the shortest time in milliseconds between two locations passed on to \a msecs.
+
+  0 passes on every location which has moved far enough.
+ */
+void LocationSubscription::setMinimumInterval(int msecs)
+{
+  m_minimumInterval = std::max(msecs, 0);
+}
+
+/*!
+  \brief Returns the shortest distance in metres between two locations passed on.
+ */
+double LocationSubscription::minimumDistance() const
+{
+  return m_minimumDistance;
+}
+
+/*!
+  \brief Sets the shortest distance in metres between two locations passed on to \a meters.
+
+  0 passes on every location which differs from the last.
+ */
+void LocationSubscription::setMinimumDistance(double meters)
+{
+  m_minimumDistance = std::max(meters, 0.0);
+}
+
+/*!
+  \brief Returns the last location passed on.
+ */
+Point LocationSubscription::location() const
+{
+  return m_location;
+}
+
+/*!
+  \brief Slot for ToolResourceProvider::locationChanged.
+
+  Passes \a location on at once, later, or not at all.
+ */
+void LocationSubscription::onLocationChanged(const Point& location)
+{
+  m_pendingLocation = location;
+
+  // a location arriving while one is waiting replaces it
+  if (m_timer->isActive())
+    return;
+
+  if (!hasMoved(location))
+    return;
+
+  const qint64 remaining = m_sinceDelivery.isValid() ? m_minimumInterval - m_sinceDelivery.elapsed() : 0;
+  if (remaining <= 0)
+    deliver();
+  else
+    m_timer->start(static_cast<int>(remaining));
+}
+
+/*!
+  \internal
+
+  Returns whether \a location is far enough from the last location passed on.
+ */
+bool LocationSubscription::hasMoved(const Point& location) const
+{
+  if (m_location.isEmpty())
+    return true;
+
+  if (m_minimumDistance <= 0.0)
+    return !(m_location == location);
+
+  return Geodesy::distanceBetween(m_location.x(), m_location.y(), location.x(), location.y()) >= m_minimumDistance;
+}
+
+/*!
+  \internal
+ */
+void LocationSubscription::deliver()
+{
+  m_location = m_pendingLocation;
+  m_sinceDelivery.start();
+  emit locationChanged(m_location);
+}
+
+} // Dsa
+
+// Signal Documentation
+
+/*!
+  \fn void LocationSubscription::locationChanged(const Esri::ArcGISRuntime::Point& location);
+
+  \brief Signal emitted when the \a location is passed on to the subscriber.
+ */
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef LOCATIONSUBSCRIPTION_H
+#define LOCATIONSUBSCRIPTION_H
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QObject>
+
+class QTimer;
+
+namespace Dsa {
+
+class LocationSubscription : public QObject
+{
+  Q_OBJECT
+
+public:
+  LocationSubscription(int minimumInterval, double minimumDistance, QObject* parent = nullptr);
+  ~LocationSubscription() override;
+
+  int minimumInterval() const;
+  void setMinimumInterval(int msecs);
+
+  double minimumDistance() const;
+  void setMinimumDistance(double meters);
+
+  Esri::ArcGISRuntime::Point location() const;
+
+public slots:
+  void onLocationChanged(const Esri::ArcGISRuntime::Point& location);
+
+signals:
+  void locationChanged(const Esri::ArcGISRuntime::Point& location);
+
+private:
+  bool hasMoved(const Esri::ArcGISRuntime::Point& location) const;
+  void deliver();
+
+  int m_minimumInterval = 0;
+  double m_minimumDistance = 0.0;
+  QTimer* m_timer = nullptr;
+  QElapsedTimer m_sinceDelivery;
+  Esri::ArcGISRuntime::Point m_location;
+  Esri::ArcGISRuntime::Point m_pendingLocation;
+};
+
+} // Dsa
+
+#endif // LOCATIONSUBSCRIPTION_H
@@ -28,6 +28,8 @@
 #include <QFuture>
 
 // DSA headers
+#include "ElevationCache.h"
+#include "LocationSubscription.h"
 #include "ToolManager.h"
 #include "ToolResourceProvider.h"
 
@@ -39,6 +41,7 @@ namespace Dsa {
 const QString LocationTextController::COORDINATE_FORMAT_PROPERTYNAME = QStringLiteral("CoordinateFormat");
 const QString LocationTextController::USE_GPS_PROPERTYNAME = QStringLiteral("UseGpsForElevation");
 const QString LocationTextController::UNIT_OF_MEASUREMENT_PROPERTYNAME = QStringLiteral("UnitOfMeasurement");
+const QString LocationTextController::ELEVATION_CACHE_RESOLUTION_PROPERTYNAME = QStringLiteral("ElevationCacheResolution");
 
 // constant strings for formats/units
 const QString LocationTextController::DMS = QStringLiteral("DMS");
@@ -52,6 +55,13 @@ const QString LocationTextController::Gars = QStringLiteral("GARS");
 const QString LocationTextController::Meters = QStringLiteral("meters");
 const QString LocationTextController::Feet = QStringLiteral("feet");
 
+namespace
+{
+// the text is read by people, so it need not follow every update of the receiver
+constexpr int c_locationUpdateInterval = 250;
+constexpr double c_locationUpdateDistance = 1.0;
+} // namespace
+
 /*!
   \class Dsa::LocationTextController
   \inmodule Dsa
@@ -65,12 +75,14 @@ const QString LocationTextController::Feet = QStringLiteral("feet");
 LocationTextController::LocationTextController(QObject* parent) :
   AbstractTool(parent),
   m_coordinateFormat(DMS),
-  m_unitOfMeasurement(Meters)
+  m_unitOfMeasurement(Meters),
+  m_elevationCache(new ElevationCache(this))
 {
   connect(ToolResourceProvider::instance(), &ToolResourceProvider::geoViewChanged,
           this, &LocationTextController::onGeoViewChanged);
 
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::locationChanged,
+  auto* locationSubscription = ToolResourceProvider::instance()->subscribeToLocation(this, c_locationUpdateInterval, c_locationUpdateDistance);
+  connect(locationSubscription, &LocationSubscription::locationChanged,
           this, &LocationTextController::onLocationChanged);
 
   ToolManager::instance().addTool(this);
@@ -110,7 +122,7 @@ QString LocationTextController::currentElevationText() const
 }
 
 /*!
- \brief Slot for ToolResourceProvider::locationChanged.
+ \brief Slot for the location, at most every 250 milliseconds and after moving at least 1 metre.
 
  Uses the provided \a pt to update the location and elevation text.
  */
@@ -142,10 +154,12 @@ void LocationTextController::onLocationChanged(const Point& pt)
     if (!surface)
       return;
 
-    // set the elevation text in the continuation block
-    surface->elevationAsync(pt).then(this, [this](double elevation)
+    // nearby locations share a cached elevation, so a stationary or hovering location queries the surface once
+    const quint64 request = ++m_elevationRequest;
+    m_elevationCache->requestElevation(surface, pt, [this, request](double elevation)
     {
-      formatElevationText(elevation);
+      if (request == m_elevationRequest)
+        formatElevationText(elevation);
     });
   }
 }
@@ -170,6 +184,10 @@ void LocationTextController::setProperties(const QVariantMap& properties)
   setCoordinateFormat(properties[COORDINATE_FORMAT_PROPERTYNAME].toString());
   setUseGpsForElevation(properties[USE_GPS_PROPERTYNAME].toBool());
   setUnitOfMeasurement(properties[UNIT_OF_MEASUREMENT_PROPERTYNAME].toString());
+
+  const auto resolutionIt = properties.find(ELEVATION_CACHE_RESOLUTION_PROPERTYNAME);
+  if (resolutionIt != properties.end())
+    m_elevationCache->setResolution(resolutionIt.value().toDouble());
 }
 
 /*!
@@ -283,6 +301,16 @@ void LocationTextController::setUseGpsForElevation(bool useGps)
   emit useGpsForElevationChanged();
 }
 
+/*!
+ \brief Returns the cache of surface elevations shown by the controller.
+
+ The cache counts its hits and misses; see ElevationCache::statistics.
+ */
+ElevationCache* LocationTextController::elevationCache() const
+{
+  return m_elevationCache;
+}
+
 /*!
  \brief Formats the \a elevation text for display in QML.
 */
@@ -27,6 +27,8 @@ namespace Esri::ArcGISRuntime {
 
 namespace Dsa {
 
+class ElevationCache;
+
 class LocationTextController : public AbstractTool
 {
   Q_OBJECT
@@ -46,6 +48,7 @@ public:
   QString unitOfMeasurement() const;
   bool useGpsForElevation() const;
   void setUseGpsForElevation(bool useGps);
+  ElevationCache* elevationCache() const;
 
 signals:
   void currentLocationTextChanged();
@@ -68,6 +71,7 @@ private:
   static const QString COORDINATE_FORMAT_PROPERTYNAME;
   static const QString USE_GPS_PROPERTYNAME;
   static const QString UNIT_OF_MEASUREMENT_PROPERTYNAME;
+  static const QString ELEVATION_CACHE_RESOLUTION_PROPERTYNAME;
   static const QString DMS;
   static const QString DD;
   static const QString DDM;
@@ -80,6 +84,9 @@ private:
   static const QString Feet;
 
   Esri::ArcGISRuntime::Surface* m_surface = nullptr;
+  ElevationCache* m_elevationCache = nullptr;
+  // only the answer to the latest elevation request is shown
+  quint64 m_elevationRequest = 0;
   QString m_currentLocationText = "Location Unavailable";
   QString m_currentElevationText = "Elevation Unavailable";
   QString m_coordinateFormat;
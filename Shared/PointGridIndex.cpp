@@ -0,0 +1,635 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "PointGridIndex.h"
+
+// C++ API headers
+#include "Envelope.h"
+#include "GeoElement.h"
+#include "Point.h"
+#include "SpatialReference.h"
+
+// DSA headers
+#include "GeoElementUtils.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+namespace
+{
+
+constexpr double c_minimumCellSize = 1e-6; // degrees
+
+// cell keys pack the signed column and row into the high and low 32 bits
+quint64 packCell(qint32 column, qint32 row)
+{
+  return (static_cast<quint64>(static_cast<quint32>(column)) << 32) | static_cast<quint32>(row);
+}
+
+qint32 cellColumn(quint64 cell)
+{
+  return static_cast<qint32>(static_cast<quint32>(cell >> 32));
+}
+
+qint32 cellRow(quint64 cell)
+{
+  return static_cast<qint32>(static_cast<quint32>(cell & 0xffffffffu));
+}
+
+} // namespace
+
+/*!
+  \class Dsa::PointGridIndex
+  \inmodule Dsa
+  \inherits GeometryIndex
+  \brief A uniform grid of fixed-size WGS84 cells covering a set of
+  \l Esri::ArcGISRuntime::GeoElement objects with point geometry.
+
+  Each point is stored in exactly one cell, so adding, moving or removing a
+  point is O(1) regardless of how many points are indexed. This suits targets
+  such as tracks from a message feed, which are all points and move constantly.
+
+  Only the cells covered by a query extent are visited, and the points in them
+  are tested against the extent before being returned. Cells are only allocated
+  once they hold a point, so a query covering a very large area visits the
+  occupied cells instead.
+
+  Elements which are not points can still be added. They are kept in a separate
+  list which is checked in full for every query, so use a \l GeometryQuadtree
+  (see \l GeometryIndex::createIndex) when most elements are not points.
+
+  The index must only be modified and queried on the thread it lives on.
+ */
+
+/*!
+  \brief Constructor taking the list of \a geoElements which the index should include,
+  the \a cellSize of the grid in degrees and an optional \a parent.
+ */
+PointGridIndex::PointGridIndex(const QList<GeoElement*>& geoElements,
+                               double cellSize,
+                               QObject* parent):
+  GeometryIndex(parent),
+  m_cellSize(std::max(cellSize, c_minimumCellSize))
+{
+  m_entries.reserve(geoElements.size());
+  m_elementKeys.reserve(geoElements.size());
+
+  for (const auto& element : geoElements)
+  {
+    const int key = handleNewGeoElement(element);
+    if (key != -1)
+      handleGeometryChange(key);
+  }
+}
+
+/*!
+  \brief Destructor.
+ */
+PointGridIndex::~PointGridIndex()
+{
+}
+
+/*!
+  \brief Returns \c true.
+ */
+bool PointGridIndex::isPointIndex() const
+{
+  return true;
+}
+
+/*!
+  \brief Returns the width and height of each grid cell in degrees.
+ */
+double PointGridIndex::cellSize() const
+{
+  return m_cellSize;
+}
+
+/*!
+  \brief Sets the width and height of each grid cell in degrees to \a cellSize.
+
+  Cells should be roughly the size of a typical query. Much smaller cells mean
+  more cells are visited per query, much larger ones mean more points are tested.
+
+  \note The grid will be re-built.
+ */
+void PointGridIndex::setCellSize(double cellSize)
+{
+  cellSize = std::max(cellSize, c_minimumCellSize);
+  if (m_cellSize == cellSize)
+    return;
+
+  m_cellSize = cellSize;
+  rebuildCells();
+}
+
+/*!
+  \brief Returns statistics describing the grid and the queries made against it.
+
+  The map contains:
+  \list
+    \li \c elementCount - the number of elements in the index.
+    \li \c nonPointCount - the number of elements which are not points.
+    \li \c cellSize - the current setting.
+    \li \c occupiedCellCount - the number of cells holding at least one point.
+    \li \c averageCellOccupancy and \c maxCellOccupancy - the number of points held by occupied cells.
+    \li \c queryCount - the number of queries since the statistics were last reset.
+    \li \c averageCandidatesPerQuery - the mean number of candidates returned per query.
+    \li \c averageCellsVisitedPerQuery - the mean number of cells visited per query.
+  \endlist
+ */
+QVariantMap PointGridIndex::statistics() const
+{
+  qint64 occupancy = 0;
+  int maxOccupancy = 0;
+  for (const QVector<int>& cell : m_cells)
+  {
+    occupancy += cell.size();
+    maxOccupancy = std::max(maxOccupancy, static_cast<int>(cell.size()));
+  }
+
+  const qint64 queryCount = m_queryCount.load(std::memory_order_relaxed);
+  const qint64 candidateCount = m_candidateCount.load(std::memory_order_relaxed);
+  const qint64 cellVisitCount = m_cellVisitCount.load(std::memory_order_relaxed);
+
+  QVariantMap result;
+  result.insert(QStringLiteral("elementCount"), m_entries.size());
+  result.insert(QStringLiteral("nonPointCount"), m_nonPointKeys.size());
+  result.insert(QStringLiteral("cellSize"), m_cellSize);
+  result.insert(QStringLiteral("occupiedCellCount"), m_cells.size());
+  result.insert(QStringLiteral("averageCellOccupancy"),
+                m_cells.isEmpty() ? 0.0 : static_cast<double>(occupancy) / m_cells.size());
+  result.insert(QStringLiteral("maxCellOccupancy"), maxOccupancy);
+  result.insert(QStringLiteral("queryCount"), queryCount);
+  result.insert(QStringLiteral("averageCandidatesPerQuery"),
+                queryCount > 0 ? static_cast<double>(candidateCount) / queryCount : 0.0);
+  result.insert(QStringLiteral("averageCellsVisitedPerQuery"),
+                queryCount > 0 ? static_cast<double>(cellVisitCount) / queryCount : 0.0);
+
+  return result;
+}
+
+/*!
+  \brief Resets the query counters reported by \l statistics.
+ */
+void PointGridIndex::resetQueryStatistics()
+{
+  m_queryCount.store(0, std::memory_order_relaxed);
+  m_candidateCount.store(0, std::memory_order_relaxed);
+  m_cellVisitCount.store(0, std::memory_order_relaxed);
+}
+
+/*!
+  \brief Adds the \a newGeoElement into the grid.
+
+  If the element is already in the grid, its location is updated instead.
+ */
+void PointGridIndex::appendGeoElement(GeoElement* newGeoElement)
+{
+  if (!newGeoElement)
+    return;
+
+  auto findIt = m_elementKeys.constFind(newGeoElement);
+  const int key = findIt != m_elementKeys.constEnd() ? findIt.value() : handleNewGeoElement(newGeoElement);
+  handleGeometryChange(key);
+}
+
+/*!
+  \brief Updates the location of \a geoElement in the grid.
+
+  A point which stays within its cell only has its coordinates updated. Otherwise it is
+  moved to its new cell, which is also O(1).
+ */
+void PointGridIndex::updateGeoElement(GeoElement* geoElement)
+{
+  auto findIt = m_elementKeys.constFind(geoElement);
+  if (findIt == m_elementKeys.constEnd())
+    return;
+
+  handleGeometryChange(findIt.value());
+}
+
+/*!
+  \brief Removes \a geoElement from the grid.
+ */
+void PointGridIndex::removeGeoElement(GeoElement* geoElement)
+{
+  auto findIt = m_elementKeys.constFind(geoElement);
+  if (findIt == m_elementKeys.constEnd())
+    return;
+
+  const int key = findIt.value();
+  GeoElementSignaler* signaler = m_entries.value(key).signaler;
+  removeKey(key, geoElement);
+
+  // the signaler is owned by the element so it must be deleted explicitly
+  if (signaler)
+  {
+    signaler->disconnect(this);
+    delete signaler;
+  }
+}
+
+/*!
+  \brief Returns the list of \l Geometry objects which intersect \a extent.
+
+  Points are tested against \a extent exactly. Elements which are not points are
+  returned when their extent intersects \a extent, so for those an exact geometry
+  test is still required.
+ */
+QList<Geometry> PointGridIndex::candidateIntersections(const Envelope& extent) const
+{
+  // ensure the extent is in WGS84
+  const Envelope wgs84 = geometry_cast<Envelope>(toWgs84(extent));
+
+  QList<Geometry> results;
+  int cellsVisited = 0;
+
+  for (const Envelope& query : wrappedQueries(wgs84, m_xMin, m_xMax))
+    collectCandidates(query, results, cellsVisited);
+
+  recordQuery(static_cast<int>(results.size()), cellsVisited);
+
+  return results;
+}
+
+/*!
+  \brief Returns the list of \l Geometry objects in the grid cell containing \a location.
+
+  \note No intersection test is carried out between the supplied point and the results. For exact results,
+  you should perform the desired geometry tests on the list of \l Geometry objects returned.
+ */
+QList<Geometry> PointGridIndex::candidateIntersections(const Point& location) const
+{
+  // ensure the location is in WGS84
+  const Point wgs84 = geometry_cast<Point>(toWgs84(location));
+
+  QList<Geometry> results;
+  int cellsVisited = 0;
+
+  if (wgs84.isEmpty())
+  {
+    recordQuery(0, cellsVisited);
+    return results;
+  }
+
+  for (const Point& query : wrappedQueries(wgs84, m_xMin, m_xMax))
+  {
+    ++cellsVisited;
+    auto cellIt = m_cells.constFind(cellKey(query.x(), query.y()));
+    if (cellIt != m_cells.constEnd())
+    {
+      for (const int key : cellIt.value())
+      {
+        const GeoElementSignaler* signaler = m_entries.value(key).signaler;
+        if (signaler)
+          results.append(signaler->geoElement()->geometry());
+      }
+    }
+
+    // any element which is not a point may cover the location or one of its wrapped copies
+    for (const int key : m_nonPointKeys)
+    {
+      const Entry entry = m_entries.value(key);
+      if (entry.signaler &&
+          query.x() >= entry.xMin && query.x() <= entry.xMax &&
+          query.y() >= entry.yMin && query.y() <= entry.yMax)
+        results.append(entry.signaler->geoElement()->geometry());
+    }
+  }
+
+  recordQuery(static_cast<int>(results.size()), cellsVisited);
+
+  return results;
+}
+
+/*!
+  \internal
+ */
+int PointGridIndex::handleNewGeoElement(GeoElement* geoElement)
+{
+  if (!geoElement)
+    return -1;
+
+  GeoElementSignaler* signaler = new GeoElementSignaler(geoElement, GeoElementUtils::toQObject(geoElement));
+
+  const int insertedKey = m_nextKey;
+  m_nextKey++;
+
+  Entry entry;
+  entry.signaler = signaler;
+  m_entries.insert(insertedKey, entry);
+  m_elementKeys.insert(geoElement, insertedKey);
+
+  connect(signaler, &GeoElementSignaler::geometryChanged, this, [this, insertedKey]()
+  {
+    handleGeometryChange(insertedKey);
+  });
+
+  // the element pointer is only used as a lookup key since it is being destroyed
+  connect(signaler, &GeoElementSignaler::destroyed, this, [this, insertedKey, geoElement]()
+  {
+    removeKey(insertedKey, geoElement);
+  });
+
+  return insertedKey;
+}
+
+/*!
+  \internal
+
+  Moves the element stored with \a key to the cell matching its current geometry.
+ */
+void PointGridIndex::handleGeometryChange(int key)
+{
+  auto entryIt = m_entries.find(key);
+  if (entryIt == m_entries.end() || !entryIt->signaler)
+    return;
+
+  Entry& entry = entryIt.value();
+  const Geometry wgs84 = toWgs84(entry.signaler->geoElement()->geometry());
+
+  // an element without a location is kept in the lookup but not in the grid
+  if (wgs84.isEmpty())
+  {
+    removeFromCell(key, entry);
+    removeFromNonPoints(key, entry);
+    return;
+  }
+
+  if (wgs84.geometryType() == GeometryType::Point)
+  {
+    const Point point = geometry_cast<Point>(wgs84);
+    removeFromNonPoints(key, entry);
+
+    entry.xMin = entry.xMax = point.x();
+    entry.yMin = entry.yMax = point.y();
+    expandBounds(entry);
+
+    // a point moving within its cell only needs its coordinates updating
+    const quint64 cell = cellKey(point.x(), point.y());
+    if (entry.slot != -1 && entry.cell == cell)
+      return;
+
+    removeFromCell(key, entry);
+    entry.cell = cell;
+    insertIntoCell(key, entry);
+    return;
+  }
+
+  const Envelope extent = wgs84.extent();
+  removeFromCell(key, entry);
+  if (!entry.isNonPoint)
+    m_nonPointKeys.append(key);
+
+  entry.isNonPoint = true;
+  entry.xMin = extent.xMin();
+  entry.xMax = extent.xMax();
+  entry.yMin = extent.yMin();
+  entry.yMax = extent.yMax();
+  expandBounds(entry);
+}
+
+/*!
+  \internal
+
+  Removes the \a geoElement stored with \a key from the grid and the lookups.
+ */
+void PointGridIndex::removeKey(int key, GeoElement* geoElement)
+{
+  auto findIt = m_entries.find(key);
+  if (findIt == m_entries.end())
+    return;
+
+  removeFromCell(key, findIt.value());
+  removeFromNonPoints(key, findIt.value());
+
+  m_entries.erase(findIt);
+  m_elementKeys.remove(geoElement);
+}
+
+/*!
+  \internal
+
+  Appends \a key to the cell of \a entry and records its slot there.
+ */
+void PointGridIndex::insertIntoCell(int key, Entry& entry)
+{
+  QVector<int>& cell = m_cells[entry.cell];
+  entry.slot = static_cast<int>(cell.size());
+  cell.append(key);
+}
+
+/*!
+  \internal
+
+  Removes \a entry, stored with \a key, from its cell by moving the last key in the cell into its slot.
+  Cells which become empty are released.
+ */
+void PointGridIndex::removeFromCell(int key, Entry& entry)
+{
+  if (entry.slot == -1)
+    return;
+
+  auto cellIt = m_cells.find(entry.cell);
+  if (cellIt != m_cells.end())
+  {
+    QVector<int>& cell = cellIt.value();
+    const int lastKey = cell.last();
+    cell[entry.slot] = lastKey;
+    cell.removeLast();
+
+    if (cell.isEmpty())
+      m_cells.erase(cellIt);
+    else if (lastKey != key)
+    {
+      auto lastIt = m_entries.find(lastKey);
+      if (lastIt != m_entries.end())
+        lastIt->slot = entry.slot;
+    }
+  }
+
+  entry.slot = -1;
+}
+
+/*!
+  \internal
+
+  Removes \a entry, stored with \a key, from the list of elements which are not points.
+ */
+void PointGridIndex::removeFromNonPoints(int key, Entry& entry)
+{
+  if (!entry.isNonPoint)
+    return;
+
+  m_nonPointKeys.removeOne(key);
+  entry.isNonPoint = false;
+}
+
+/*!
+  \internal
+
+  Re-assigns every point to a cell, e.g. after the cell size has changed.
+ */
+void PointGridIndex::rebuildCells()
+{
+  m_cells.clear();
+  m_hasBounds = false;
+
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    Entry& entry = it.value();
+    entry.slot = -1;
+    if (!entry.signaler || entry.signaler->geoElement()->geometry().isEmpty())
+      continue;
+
+    expandBounds(entry);
+    if (entry.isNonPoint)
+      continue;
+
+    entry.cell = cellKey(entry.xMin, entry.yMin);
+    insertIntoCell(it.key(), entry);
+  }
+}
+
+/*!
+  \internal
+
+  Grows the x-range used to decide whether queries need to wrap around the
+  antimeridian so that it covers \a entry.
+ */
+void PointGridIndex::expandBounds(const Entry& entry)
+{
+  m_xMin = m_hasBounds ? std::min(m_xMin, entry.xMin) : entry.xMin;
+  m_xMax = m_hasBounds ? std::max(m_xMax, entry.xMax) : entry.xMax;
+  m_hasBounds = true;
+}
+
+/*!
+  \internal
+
+  Appends the geometry of every element intersecting \a extent to \a results and
+  adds the number of cells checked to \a cellsVisited.
+ */
+void PointGridIndex::collectCandidates(const Envelope& extent, QList<Geometry>& results, int& cellsVisited) const
+{
+  if (extent.isEmpty())
+    return;
+
+  const double xMin = extent.xMin();
+  const double xMax = extent.xMax();
+  const double yMin = extent.yMin();
+  const double yMax = extent.yMax();
+
+  auto appendMatches = [this, xMin, xMax, yMin, yMax, &results](const QVector<int>& cell)
+  {
+    for (const int key : cell)
+    {
+      const Entry entry = m_entries.value(key);
+      if (entry.signaler &&
+          entry.xMin >= xMin && entry.xMin <= xMax &&
+          entry.yMin >= yMin && entry.yMin <= yMax)
+        results.append(entry.signaler->geoElement()->geometry());
+    }
+  };
+
+  const qint32 columnMin = cellCoordinate(xMin);
+  const qint32 columnMax = cellCoordinate(xMax);
+  const qint32 rowMin = cellCoordinate(yMin);
+  const qint32 rowMax = cellCoordinate(yMax);
+  const qint64 coveredCells = (static_cast<qint64>(columnMax) - columnMin + 1) * (static_cast<qint64>(rowMax) - rowMin + 1);
+
+  // visit whichever is smaller: the cells covered by the extent or the occupied cells
+  if (coveredCells <= m_cells.size())
+  {
+    for (qint32 column = columnMin; column <= columnMax; ++column)
+    {
+      for (qint32 row = rowMin; row <= rowMax; ++row)
+      {
+        ++cellsVisited;
+        auto cellIt = m_cells.constFind(packCell(column, row));
+        if (cellIt != m_cells.constEnd())
+          appendMatches(cellIt.value());
+      }
+    }
+  }
+  else
+  {
+    for (auto cellIt = m_cells.cbegin(); cellIt != m_cells.cend(); ++cellIt)
+    {
+      ++cellsVisited;
+      const qint32 column = cellColumn(cellIt.key());
+      const qint32 row = cellRow(cellIt.key());
+      if (column >= columnMin && column <= columnMax && row >= rowMin && row <= rowMax)
+        appendMatches(cellIt.value());
+    }
+  }
+
+  // elements which are not points are compared by extent
+  for (const int key : m_nonPointKeys)
+  {
+    const Entry entry = m_entries.value(key);
+    if (entry.signaler &&
+        entry.xMin <= xMax && entry.xMax >= xMin &&
+        entry.yMin <= yMax && entry.yMax >= yMin)
+      results.append(entry.signaler->geoElement()->geometry());
+  }
+}
+
+/*!
+  \internal
+
+  Returns the key of the cell containing the WGS84 coordinate \a x, \a y.
+ */
+quint64 PointGridIndex::cellKey(double x, double y) const
+{
+  return packCell(cellCoordinate(x), cellCoordinate(y));
+}
+
+/*!
+  \internal
+
+  Returns the column or row containing \a value, clamped to the range of the key.
+ */
+qint32 PointGridIndex::cellCoordinate(double value) const
+{
+  constexpr double lowest = std::numeric_limits<qint32>::min();
+  constexpr double highest = std::numeric_limits<qint32>::max();
+
+  return static_cast<qint32>(std::clamp(std::floor(value / m_cellSize), lowest, highest));
+}
+
+/*!
+  \internal
+ */
+void PointGridIndex::recordQuery(int candidateCount, int cellsVisited) const
+{
+  m_queryCount.fetch_add(1, std::memory_order_relaxed);
+  m_candidateCount.fetch_add(candidateCount, std::memory_order_relaxed);
+  m_cellVisitCount.fetch_add(cellsVisited, std::memory_order_relaxed);
+}
+
+} // Dsa
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef POINTGRIDINDEX_H
+#define POINTGRIDINDEX_H
+
+// DSA headers
+#include "GeometryIndex.h"
+
+// Qt headers
+#include <QHash>
+#include <QVector>
+
+// STL headers
+#include <atomic>
+
+namespace Dsa {
+
+class GeoElementSignaler;
+
+class PointGridIndex : public GeometryIndex
+{
+  Q_OBJECT
+
+public:
+  static constexpr double DefaultCellSize = 0.05;
+
+  PointGridIndex(const QList<Esri::ArcGISRuntime::GeoElement*>& geoElements,
+                 double cellSize,
+                 QObject* parent = nullptr);
+  ~PointGridIndex();
+
+  bool isPointIndex() const override;
+
+  double cellSize() const;
+  void setCellSize(double cellSize);
+
+  QVariantMap statistics() const override;
+  void resetQueryStatistics();
+
+  void appendGeoElement(Esri::ArcGISRuntime::GeoElement* newGeoElement) override;
+  void updateGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement) override;
+  void removeGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement) override;
+
+  using GeometryIndex::candidateIntersections;
+  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Envelope& extent) const override;
+  QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Point& location) const override;
+
+private:
+  struct Entry
+  {
+    GeoElementSignaler* signaler = nullptr;
+    double xMin = 0.0;
+    double yMin = 0.0;
+    double xMax = 0.0;
+    double yMax = 0.0;
+    bool isNonPoint = false;
+    quint64 cell = 0;
+    int slot = -1;
+  };
+
+  int handleNewGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement);
+  void handleGeometryChange(int key);
+  void removeKey(int key, Esri::ArcGISRuntime::GeoElement* geoElement);
+  void insertIntoCell(int key, Entry& entry);
+  void removeFromCell(int key, Entry& entry);
+  void removeFromNonPoints(int key, Entry& entry);
+  void rebuildCells();
+  void expandBounds(const Entry& entry);
+  void collectCandidates(const Esri::ArcGISRuntime::Envelope& extent, QList<Esri::ArcGISRuntime::Geometry>& results, int& cellsVisited) const;
+  quint64 cellKey(double x, double y) const;
+  qint32 cellCoordinate(double value) const;
+  void recordQuery(int candidateCount, int cellsVisited) const;
+
+  double m_cellSize;
+  QHash<int, Entry> m_entries;
+  QHash<quint64, QVector<int>> m_cells;
+  QVector<int> m_nonPointKeys;
+  QHash<Esri::ArcGISRuntime::GeoElement*, int> m_elementKeys;
+  int m_nextKey = 0;
+  bool m_hasBounds = false;
+  double m_xMin = 0.0;
+  double m_xMax = 0.0;
+
+  mutable std::atomic<qint64> m_queryCount{0};
+  mutable std::atomic<qint64> m_candidateCount{0};
+  mutable std::atomic<qint64> m_cellVisitCount{0};
+};
+
+} // Dsa
+
+#endif // POINTGRIDINDEX_H
@@ -24,6 +24,7 @@
 #include "SceneView.h"
 #include "SpatialReference.h"
 
+#include "LocationSubscription.h"
 #include "ToolResourceProvider.h"
 
 using namespace Esri::ArcGISRuntime;
@@ -290,6 +291,24 @@ void ToolResourceProvider::onLocationChanged(const Point& location)
   emit locationChanged(location);
 }
 
+/*! \brief Subscribes \a subscriber to the device location, at most once every
+ * \a minimumInterval milliseconds and only after moving \a minimumDistance metres.
+ *
+ * Locations which arrive sooner are coalesced, so a receiver updating many times a
+ * second does not drive the subscriber's work at the same rate. Connect to the
+ * returned subscription's \c locationChanged signal instead of \l locationChanged.
+ * The subscription is owned by \a subscriber; delete it to unsubscribe.
+ *
+ * \sa LocationSubscription
+ */
+LocationSubscription* ToolResourceProvider::subscribeToLocation(QObject* subscriber, int minimumInterval, double minimumDistance)
+{
+  auto* subscription = new LocationSubscription(minimumInterval, minimumDistance, subscriber);
+  connect(this, &ToolResourceProvider::locationChanged, subscription, &LocationSubscription::onLocationChanged);
+
+  return subscription;
+}
+
 void ToolResourceProvider::clear()
 {
   m_map = nullptr;
@@ -40,6 +40,8 @@ Q_MOC_INCLUDE("IdentifyLayerResult.h")
 namespace Dsa
 {
 
+class LocationSubscription;
+
 class ToolResourceProvider : public QObject
 {
   Q_OBJECT
@@ -67,6 +69,8 @@ public:
 
   void setMouseCursor(const QCursor& cursor);
 
+  LocationSubscription* subscribeToLocation(QObject* subscriber, int minimumInterval, double minimumDistance = 0.0);
+
   void clear();
 
 public slots:
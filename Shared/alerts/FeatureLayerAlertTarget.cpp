@@ -33,7 +33,7 @@
 
 // DSA headers
 #include "FeatureQueryResultManager.h"
-#include "GeometryQuadtree.h"
+#include "GeometryIndex.h"
 
 using namespace Esri::ArcGISRuntime;
 
@@ -87,12 +87,12 @@ FeatureLayerAlertTarget::FeatureLayerAlertTarget(FeatureLayer* featureLayer):
       connect(feature, &Feature::geometryChanged, this, [this]()
       {
         m_geomCache.clear();
-        rebuildQuadtree();
+        rebuildSpatialIndex();
         emit dataChanged();
       });
     }
 
-    rebuildQuadtree();
+    rebuildSpatialIndex();
     emit dataChanged();
   });
 }
@@ -112,11 +112,11 @@ FeatureLayerAlertTarget::~FeatureLayerAlertTarget()
  */
 QList<Geometry> FeatureLayerAlertTarget::targetGeometries(const Envelope& targetArea) const
 {
-  // if the quad-tree has been built use it to determine the candidate geometry
-  if (m_quadtree)
-    return m_quadtree->candidateIntersections(targetArea);
+  // if the spatial index has been built use it to determine the candidate geometry
+  if (m_spatialIndex)
+    return m_spatialIndex->candidateIntersections(targetArea);
 
-  // if there is no quad-tree just return the cache of geoemtry
+  // if there is no spatial index just return the cache of geoemtry
   if (!m_geomCache.isEmpty())
     return m_geomCache;
 
@@ -143,14 +143,15 @@ QVariant FeatureLayerAlertTarget::targetValue() const
 /*!
   \brief internal.
 
-  Build the quadtree used to find intersections with feature geometry etc.
+  Build the spatial index used to find intersections with feature geometry etc.
+  A point layer gets a grid index, any other layer a quadtree.
  */
-void FeatureLayerAlertTarget::rebuildQuadtree()
+void FeatureLayerAlertTarget::rebuildSpatialIndex()
 {
-  if (m_quadtree)
+  if (m_spatialIndex)
   {
-    delete m_quadtree;
-    m_quadtree = nullptr;
+    delete m_spatialIndex;
+    m_spatialIndex = nullptr;
   }
 
   QList<GeoElement*> elements;
@@ -158,7 +159,7 @@ void FeatureLayerAlertTarget::rebuildQuadtree()
     elements.append(*it);
 
   if (elements.size() > 1)
-    m_quadtree = new GeometryQuadtree(m_FeatureLayer->fullExtent(), elements, 8, this);
+    m_spatialIndex = GeometryIndex::createIndex(m_FeatureLayer->fullExtent(), elements, this);
 }
 
 } // Dsa
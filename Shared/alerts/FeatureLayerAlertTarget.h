@@ -28,7 +28,7 @@ namespace Esri::ArcGISRuntime {
 
 namespace Dsa {
 
-class GeometryQuadtree;
+class GeometryIndex;
 
 class FeatureLayerAlertTarget : public AlertTarget
 {
@@ -42,10 +42,10 @@ public:
   QVariant targetValue() const override;
 
 private:
-  void rebuildQuadtree();
+  void rebuildSpatialIndex();
 
   Esri::ArcGISRuntime::FeatureLayer* m_FeatureLayer = nullptr;
-  GeometryQuadtree* m_quadtree = nullptr;
+  GeometryIndex* m_spatialIndex = nullptr;
   QList<Esri::ArcGISRuntime::Feature*> m_features;
   mutable QList<Esri::ArcGISRuntime::Geometry> m_geomCache;
 };
@@ -20,7 +20,7 @@
 #include "GraphicsOverlayAlertTarget.h"
 
 // dsa app headers
-#include "GeometryQuadtree.h"
+#include "GeometryIndex.h"
 
 // C++ API headers
 #include "Envelope.h"
@@ -56,7 +56,7 @@ GraphicsOverlayAlertTarget::GraphicsOverlayAlertTarget(GraphicsOverlay* graphics
   // respond to graphics being removed from the overlay
   connect(m_graphicsOverlay->graphics(), &GraphicListModel::itemRemoved, this, [this](int)
   {
-    rebuildQuadtree();
+    rebuildSpatialIndex();
     emit dataChanged();
   });
 
@@ -64,17 +64,23 @@ GraphicsOverlayAlertTarget::GraphicsOverlayAlertTarget(GraphicsOverlay* graphics
   connect(m_graphicsOverlay->graphics(), &GraphicListModel::itemAdded, this, [this](int index)
   {
     Graphic* graphic = m_graphicsOverlay->graphics()->at(index);
-    setupGraphicConnections(graphic);
-    if (m_quadtree)
-      m_quadtree->appendGeoElment(graphic);
+
+    // a grid index only suits points, so switch to a quadtree once other geometry is added
+    if (m_spatialIndex && (!m_spatialIndex->isPointIndex() || GeometryIndex::isPointOnly({graphic})))
+    {
+      setupGraphicConnections(graphic);
+      m_spatialIndex->appendGeoElement(graphic);
+    }
     else
-      rebuildQuadtree();
+    {
+      rebuildSpatialIndex();
+    }
 
     emit dataChanged();
   });
 
-  // build the quadtree for all graphics in the overlay to begin with
-  rebuildQuadtree();
+  // build the spatial index for all graphics in the overlay to begin with
+  rebuildSpatialIndex();
 }
 
 /*!
@@ -92,9 +98,9 @@ GraphicsOverlayAlertTarget::~GraphicsOverlayAlertTarget()
  */
 QList<Geometry> GraphicsOverlayAlertTarget::targetGeometries(const Envelope& targetArea) const
 {
-  // if the quadtree has been built, use  it to return the set of candidate geometries
-  if (m_quadtree)
-    return m_quadtree->candidateIntersections(targetArea);
+  // if the spatial index has been built, use it to return the set of candidate geometries
+  if (m_spatialIndex)
+    return m_spatialIndex->candidateIntersections(targetArea);
 
   // otherwise, return all of the geometry in the overlay
   QList<Geometry> geomList;
@@ -137,14 +143,15 @@ void GraphicsOverlayAlertTarget::setupGraphicConnections(Graphic* graphic)
 /*!
   \internal
 
-  Build the quadtree.
+  Build the spatial index. An overlay containing only points gets a grid index,
+  any other overlay a quadtree.
  */
-void GraphicsOverlayAlertTarget::rebuildQuadtree()
+void GraphicsOverlayAlertTarget::rebuildSpatialIndex()
 {
-  if (m_quadtree)
+  if (m_spatialIndex)
   {
-    delete m_quadtree;
-    m_quadtree = nullptr;
+    delete m_spatialIndex;
+    m_spatialIndex = nullptr;
   }
 
   const GraphicListModel* graphics = m_graphicsOverlay->graphics();
@@ -163,9 +170,9 @@ void GraphicsOverlayAlertTarget::rebuildQuadtree()
     elements.append(g);
   }
 
-  // if there is more than 1 element in the overlay, build a quadtree
+  // if there is more than 1 element in the overlay, build a spatial index
   if (elements.size() > 1)
-    m_quadtree = new GeometryQuadtree(m_graphicsOverlay->extent(), elements, 8, this);
+    m_spatialIndex = GeometryIndex::createIndex(m_graphicsOverlay->extent(), elements, this);
 }
 
 } // Dsa
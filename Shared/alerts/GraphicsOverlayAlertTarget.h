@@ -27,7 +27,7 @@ namespace Esri::ArcGISRuntime {
 
 namespace Dsa {
 
-class GeometryQuadtree;
+class GeometryIndex;
 
 class GraphicsOverlayAlertTarget : public AlertTarget
 {
@@ -42,10 +42,10 @@ public:
 
 private:
   void setupGraphicConnections(Esri::ArcGISRuntime::Graphic* graphic);
-  void rebuildQuadtree();
+  void rebuildSpatialIndex();
 
   Esri::ArcGISRuntime::GraphicsOverlay* m_graphicsOverlay = nullptr;
-  GeometryQuadtree* m_quadtree = nullptr;
+  GeometryIndex* m_spatialIndex = nullptr;
   QList<QMetaObject::Connection> m_graphicConnections;
 };
 
@@ -24,12 +24,21 @@
 #include "SpatialReference.h"
 
 // toolkit headers
+#include "LocationSubscription.h"
 #include "ToolResourceProvider.h"
 
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+namespace
+{
+// every condition with the location is checked again on each change, so the receiver's
+// updates are coalesced to a few a second
+constexpr int c_locationUpdateInterval = 200;
+constexpr double c_locationUpdateDistance = 0.5;
+} // namespace
+
 /*!
   \class Dsa::LocationAlertSource
   \inmodule Dsa
@@ -50,7 +59,8 @@ LocationAlertSource::LocationAlertSource(QObject* parent):
   AlertSource(parent),
   m_location(0., 0., SpatialReference::wgs84())
 {
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::locationChanged, this, [this](const Point& location)
+  auto* locationSubscription = ToolResourceProvider::instance()->subscribeToLocation(this, c_locationUpdateInterval, c_locationUpdateDistance);
+  connect(locationSubscription, &LocationSubscription::locationChanged, this, [this](const Point& location)
   {
     if (m_location == location)
       return;
@@ -20,6 +20,7 @@
 #include "LocationAlertTarget.h"
 
 // toolkit headers
+#include "LocationSubscription.h"
 #include "ToolResourceProvider.h"
 
 // C++ API headers
@@ -32,6 +33,14 @@ using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+namespace
+{
+// every condition with the location is checked again on each change, so the receiver's
+// updates are coalesced to a few a second
+constexpr int c_locationUpdateInterval = 200;
+constexpr double c_locationUpdateDistance = 0.5;
+} // namespace
+
 /*!
   \class Dsa::LocationAlertTarget
   \inmodule Dsa
@@ -48,7 +57,8 @@ namespace Dsa {
 LocationAlertTarget::LocationAlertTarget(QObject* parent):
   AlertTarget(parent)
 {
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::locationChanged, this, [this](const Point& location)
+  auto* locationSubscription = ToolResourceProvider::instance()->subscribeToLocation(this, c_locationUpdateInterval, c_locationUpdateDistance);
+  connect(locationSubscription, &LocationSubscription::locationChanged, this, [this](const Point& location)
   {
     if (m_location == location)
       return;
@@ -28,7 +28,7 @@
 #include "Graphic.h"
 
 // DSA headers
-#include "GeometryQuadtree.h"
+#include "GeometryIndex.h"
 #include "MessageFeed.h"
 #include "MessagesOverlay.h"
 
@@ -52,15 +52,30 @@ namespace Dsa {
   \brief Constructor taking an \l Esri::ArcGISRuntime::DynamicEntityLayer (\a dynamicEntityLayer).
 
   Entities are added/updated/removed by the DynamicEntityDataSource of the DynamicEntityLayer.
+  The spatial index used to answer target queries is kept up to date from the same events.
  */
 MessagesOverlayAlertTarget::MessagesOverlayAlertTarget(MessagesOverlay* messagesOverlay) :
   AlertTarget(messagesOverlay),
   m_messagesOverlay(messagesOverlay)
 {
+  // index any entities which already exist in the overlay
+  QList<GeoElement*> elements;
+  for (auto* dynamicEntity : m_messagesOverlay->dynamicEntities())
+  {
+    if (!dynamicEntity)
+      continue;
+    elements.append(dynamicEntity);
+  }
+
+  // entities are points, so this is normally a grid index which moves each entity in O(1).
+  // An empty extent makes a quadtree cover the entities and grow as they move
+  m_spatialIndex = GeometryIndex::createIndex(Envelope(), elements, this);
+
   // subscribe to the entity received signal from the source of the dynamic layer
   connect(m_messagesOverlay->dataSource(), &DynamicEntityDataSource::dynamicEntityReceived, this, [this](DynamicEntityInfo* info)
   {
-    // check the new entity for a connection and mark the info as delete later
+    // add the new entity to the index and mark the info as delete later
+    m_spatialIndex->appendGeoElement(info->dynamicEntity());
     info->deleteLater();
     emit dataChanged();
   });
@@ -68,16 +83,16 @@ MessagesOverlayAlertTarget::MessagesOverlayAlertTarget(MessagesOverlay* messages
   // subscribe to the observation received signal (this essentially serves as the 'update' signal for the dynamic layer type)
   connect(m_messagesOverlay->dataSource(), &DynamicEntityDataSource::dynamicEntityObservationReceived, this, [this](DynamicEntityObservationInfo* observationInfo)
   {
-    // check the entity for a connection and mark the observation as delete later
+    // move the entity within the index and mark the observation as delete later
+    m_spatialIndex->updateGeoElement(observationInfo->observation()->dynamicEntity());
     observationInfo->deleteLater();
     emit dataChanged();
   });
 
-  // subscribe to the purged signal to remove any graphics from the lookup
+  // subscribe to the purged signal to remove the entity from the index
   connect(m_messagesOverlay->dataSource(), &DynamicEntityDataSource::dynamicEntityPurged, this, [this](DynamicEntityInfo* info)
   {
-    // signal the data has changed and rebuild the quad tree
-    rebuildQuadtree();
+    m_spatialIndex->removeGeoElement(info->dynamicEntity());
     info->deleteLater();
     emit dataChanged();
   });
@@ -95,20 +110,7 @@ MessagesOverlayAlertTarget::~MessagesOverlayAlertTarget() = default;
  */
 QList<Geometry> MessagesOverlayAlertTarget::targetGeometries(const Envelope& targetArea) const
 {
-  // if the quadtree has been built, use  it to return the set of candidate geometries
-  if (m_quadtree)
-    return m_quadtree->candidateIntersections(targetArea);
-
-  // otherwise, return all of the geometry in the overlay
-  QList<Geometry> geometries;
-  for (auto* dynamicEntity : m_messagesOverlay->dynamicEntities())
-  {
-    if (!dynamicEntity)
-      continue;
-    geometries.append(dynamicEntity->geometry());
-  }
-
-  return geometries;
+  return m_spatialIndex->candidateIntersections(targetArea);
 }
 
 /*!
@@ -119,33 +121,4 @@ QVariant MessagesOverlayAlertTarget::targetValue() const
   return QVariant{};
 }
 
-
-/*!
-  \brief internal.
-
-  Build the quadtree used to find intersections with entity geometry etc.
- */
-void MessagesOverlayAlertTarget::rebuildQuadtree()
-{
-  // destroy the quadtree if it already existed
-  if (m_quadtree)
-  {
-    delete m_quadtree;
-    m_quadtree = nullptr;
-  }
-
-  // build a list of pointers to geoelements for every graphic in the lookup
-  QList<GeoElement*> elements;
-  for (auto* dynamicEntity : m_messagesOverlay->dynamicEntities())
-  {
-    if (!dynamicEntity)
-      continue;
-    elements.append(dynamicEntity);
-  }
-
-  // if there is more than 1 element in the overlay, build a quadtree
-  if (elements.size() > 1)
-    m_quadtree = new GeometryQuadtree(m_messagesOverlay->fullExtent(), elements, 8, this);
-}
-
 } // Dsa
@@ -30,7 +30,7 @@ class Envelope;
 namespace Dsa {
 
 class MessagesOverlay;
-class GeometryQuadtree;
+class GeometryIndex;
 
 class MessagesOverlayAlertTarget : public AlertTarget
 {
@@ -45,8 +45,7 @@ public:
 
 private:
   Dsa::MessagesOverlay* m_messagesOverlay = nullptr;
-  GeometryQuadtree* m_quadtree = nullptr;
-  void rebuildQuadtree();
+  GeometryIndex* m_spatialIndex = nullptr;
 };
 
 } // Dsa
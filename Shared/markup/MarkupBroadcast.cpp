@@ -23,19 +23,165 @@
 // dsa app headers
 #include "DataListener.h"
 #include "DataSender.h"
+#include "MarkupLayer.h"
 
 // Qt headers
 #include <QDateTime>
+#include <QDebug>
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QPointer>
+#include <QRandomGenerator>
 #include <QString>
-#include <QUdpSocket>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtEndian>
+
+// STL headers
+#include <algorithm>
+#include <cstring>
+
+// zlib-ng headers
+#include <zlib.h>
 
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+namespace
+{
+// every chunk starts with this marker; anything else is a whole, uncompressed JSON markup
+constexpr char c_chunkMagic[4] = {'D', 'S', 'M', 'K'};
+constexpr quint8 c_chunkVersion = 1;
+constexpr quint8 c_compressedFlag = 0x01;
+constexpr quint8 c_repairFlag = 0x02;
+
+// magic, version, flags, sender id, transfer id, chunk index, chunk count, markup size
+constexpr int c_chunkHeaderSize = 4 + 1 + 1 + 4 + 4 + 2 + 2 + 4;
+
+// keeps each datagram within an Ethernet frame so it is never fragmented
+constexpr int c_maxDatagramSize = 1400;
+constexpr int c_chunkPayloadSize = c_maxDatagramSize - c_chunkHeaderSize;
+
+// limits on what a receiver will buffer for a transfer; 256 chunks is about 350 KB of
+// compressed markup, which takes well under a second to send at the paced rate
+constexpr int c_maxChunkCount = 256;
+constexpr quint32 c_maxMarkupSize = 16 * 1024 * 1024;
+constexpr int c_maxTransfers = 32;
+
+// chunks go out a few at a time so a transfer does not overrun the buffers of
+// switches and receivers, which drop a whole burst rather than queue it
+constexpr int c_chunksPerSend = 8;
+constexpr int c_sendInterval = 10;
+
+// sent transfers are kept for a while so chunks a receiver missed can be sent again
+constexpr int c_maxSentTransfers = 4;
+constexpr qint64 c_sentTransferRetention = 30000;
+
+// a receiver asks for its missing chunks once no chunk has arrived for a while,
+// waiting a little longer before each of its few requests
+constexpr qint64 c_repairDelay = 500;
+constexpr int c_maxRepairRequests = 3;
+
+// incomplete transfers are dropped once no chunk has arrived for this long
+constexpr qint64 c_transferTimeout = 10000;
+constexpr int c_transferCheckInterval = 250;
+
+// completed transfers remembered so late duplicate chunks are ignored
+constexpr int c_completedTransferHistory = 64;
+
+struct ChunkHeader
+{
+  quint8 flags = 0;
+  quint32 senderId = 0;
+  quint32 transferId = 0;
+  quint16 index = 0;
+  quint16 count = 0;
+  quint32 size = 0;
+};
+
+void writeChunkHeader(char* data, const ChunkHeader& header)
+{
+  memcpy(data, c_chunkMagic, sizeof(c_chunkMagic));
+  data[4] = static_cast<char>(c_chunkVersion);
+  data[5] = static_cast<char>(header.flags);
+  qToBigEndian<quint32>(header.senderId, data + 6);
+  qToBigEndian<quint32>(header.transferId, data + 10);
+  qToBigEndian<quint16>(header.index, data + 14);
+  qToBigEndian<quint16>(header.count, data + 16);
+  qToBigEndian<quint32>(header.size, data + 18);
+}
+
+bool readChunkHeader(const QByteArray& datagram, ChunkHeader& header)
+{
+  if (datagram.size() < c_chunkHeaderSize)
+    return false;
+
+  const char* data = datagram.constData();
+  if (memcmp(data, c_chunkMagic, sizeof(c_chunkMagic)) != 0 || static_cast<quint8>(data[4]) != c_chunkVersion)
+    return false;
+
+  header.flags = static_cast<quint8>(data[5]);
+  header.senderId = qFromBigEndian<quint32>(data + 6);
+  header.transferId = qFromBigEndian<quint32>(data + 10);
+  header.index = qFromBigEndian<quint16>(data + 14);
+  header.count = qFromBigEndian<quint16>(data + 16);
+  header.size = qFromBigEndian<quint32>(data + 18);
+
+  return header.count > 0 && header.count <= c_maxChunkCount && header.index < header.count && header.size <= c_maxMarkupSize;
+}
+
+quint64 transferKey(quint32 senderId, quint32 transferId)
+{
+  return (static_cast<quint64>(senderId) << 32) | transferId;
+}
+
+quint64 chunkKey(quint32 transferId, quint16 index)
+{
+  return (static_cast<quint64>(transferId) << 16) | index;
+}
+
+bool deflateMarkup(const QByteArray& data, QByteArray& compressed)
+{
+  z_stream stream{};
+  if (deflateInit(&stream, Z_BEST_COMPRESSION) != Z_OK)
+    return false;
+
+  compressed.resize(static_cast<qsizetype>(deflateBound(&stream, static_cast<unsigned long>(data.size()))));
+  stream.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(data.constData()));
+  stream.avail_in = static_cast<uint32_t>(data.size());
+  stream.next_out = reinterpret_cast<unsigned char*>(compressed.data());
+  stream.avail_out = static_cast<uint32_t>(compressed.size());
+
+  const int result = deflate(&stream, Z_FINISH);
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END)
+    return false;
+
+  compressed.resize(static_cast<qsizetype>(stream.total_out));
+  return true;
+}
+
+bool inflateMarkup(const QByteArray& compressed, quint32 size, QByteArray& data)
+{
+  z_stream stream{};
+  if (inflateInit(&stream) != Z_OK)
+    return false;
+
+  data.resize(static_cast<qsizetype>(size));
+  stream.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(compressed.constData()));
+  stream.avail_in = static_cast<uint32_t>(compressed.size());
+  stream.next_out = reinterpret_cast<unsigned char*>(data.data());
+  stream.avail_out = static_cast<uint32_t>(data.size());
+
+  const int result = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+
+  return result == Z_STREAM_END && stream.total_out == size;
+}
+} // namespace
+
 const QString MarkupBroadcast::MARKUPCONFIG_PROPERTYNAME = QStringLiteral("MarkupConfig");
 const QString MarkupBroadcast::ROOTDATA_PROPERTYNAME = QStringLiteral("RootDataDirectory");
 const QString MarkupBroadcast::UDPPORT_PROPERTYNAME = QStringLiteral("port");
@@ -50,6 +196,23 @@ const QString MarkupBroadcast::SHAREDBYKEY = QStringLiteral("sharedBy");
   \inherits AbstractTool
   \brief Tool controller for broadcasting markups.
 
+  A markup is compressed with zlib and split into numbered chunks, each small
+  enough to be sent as a single unfragmented UDP datagram. Receivers collect the
+  chunks of each transfer, in any order, and process the markup once all of them
+  have arrived. Chunks are sent a few at a time rather than in one burst.
+
+  A receiver which stops getting chunks for a transfer broadcasts a repair request
+  listing the chunks it is missing, and the sender queues those chunks again. A
+  transfer still missing chunks after a few requests is dropped after a timeout.
+  Datagrams without a chunk header are processed as a whole JSON markup, as sent
+  by earlier versions.
+
+  A received markup is parsed once and turned straight into a MarkupLayer. The
+  markup is then written to the \c OperationalData folder on a background thread,
+  and the layer is handed on once its file exists. The receiver takes ownership of
+  the layer by reparenting it; a layer nobody takes is deleted when the next
+  markup arrives.
+
   \sa DataSender
   \sa DataListener
  */
@@ -60,37 +223,22 @@ const QString MarkupBroadcast::SHAREDBYKEY = QStringLiteral("sharedBy");
 MarkupBroadcast::MarkupBroadcast(QObject *parent) :
   AbstractTool(parent),
   m_dataSender(new DataSender(parent)),
-  m_dataListener(new DataListener(parent))
+  m_dataListener(new DataListener(parent)),
+  m_senderId(QRandomGenerator::global()->generate()),
+  m_sendTimer(new QTimer(this)),
+  m_transferTimer(new QTimer(this)),
+  m_writePool(new QThreadPool(this))
 {
-  connect(m_dataListener, &DataListener::dataReceived, this, [this](const QByteArray& data)
-  {
-    QJsonDocument markupJson = QJsonDocument::fromJson(data);
+  // one writer keeps the unique file name check and the write together
+  m_writePool->setMaxThreadCount(1);
 
-    // write the JSON to disk
-    const QJsonObject markupObject = markupJson.object();
-    const QString sharedBy = markupObject.value(SHAREDBYKEY).toString();
+  connect(m_dataListener, &DataListener::dataReceived, this, &MarkupBroadcast::processDatagram);
 
-    const QString markupName = markupObject.value(MARKUPKEY).toObject().value(NAMEKEY).toString();
-    const QString markupFolderName = QString("%1/OperationalData").arg(m_rootDataDirectory);
-    QString markupFileName = QString("%1/%2.markup").arg(markupFolderName, markupName);
-    QFileInfo fileInfo(markupFileName);
-    if (fileInfo.exists())
-      markupFileName = QString("%1/%2_%3.markup").arg(markupFolderName, markupName, QString::number(QDateTime::currentDateTime().currentMSecsSinceEpoch()));
+  m_sendTimer->setInterval(c_sendInterval);
+  connect(m_sendTimer, &QTimer::timeout, this, &MarkupBroadcast::sendQueuedChunks);
 
-    QFile markupFile(markupFileName);
-    if (markupFile.open(QIODevice::ReadWrite))
-    {
-      QTextStream stream(&markupFile);
-      QString strJson(markupJson.toJson(QJsonDocument::Compact));
-      stream << strJson << Qt::endl;
-
-      // process the markup differently if it is the one that you sent
-      if (m_username == sharedBy)
-        emit this->markupSent(markupFileName);
-      else
-        emit this->markupReceived(markupFileName, sharedBy);
-    }
-  });
+  m_transferTimer->setInterval(c_transferCheckInterval);
+  connect(m_transferTimer, &QTimer::timeout, this, &MarkupBroadcast::checkTransfers);
 
   ToolManager::instance().addTool(this);
 }
@@ -100,6 +248,8 @@ MarkupBroadcast::MarkupBroadcast(QObject *parent) :
  */
 MarkupBroadcast::~MarkupBroadcast()
 {
+  // pending writes call back into this object
+  m_writePool->waitForDone();
 }
 
 /*!
@@ -134,53 +284,418 @@ void MarkupBroadcast::setProperties(const QVariantMap& properties)
 
 /*!
    \brief Broadcasts the markup JSON (\a json) over a UDP port.
+
+   The markup is compressed and queued as one or more chunks of a single transfer,
+   which are sent at a limited rate.
  */
 void MarkupBroadcast::broadcastMarkup(const QString& json)
 {
   if (!m_dataSender)
     return;
 
-  m_dataSender->sendData(json.toUtf8());
+  const QByteArray data = json.toUtf8();
+  if (static_cast<quint64>(data.size()) > c_maxMarkupSize)
+  {
+    qWarning() << "Markup is too large to broadcast:" << data.size() << "bytes";
+    return;
+  }
+
+  ChunkHeader header;
+  header.senderId = m_senderId;
+  header.transferId = m_nextTransferId++;
+  header.size = static_cast<quint32>(data.size());
+
+  // only send the compressed form when it is actually smaller
+  QByteArray payload;
+  if (deflateMarkup(data, payload) && payload.size() < data.size())
+    header.flags |= c_compressedFlag;
+  else
+    payload = data;
+
+  const qsizetype chunkCount = qMax<qsizetype>(1, (payload.size() + c_chunkPayloadSize - 1) / c_chunkPayloadSize);
+  if (chunkCount > c_maxChunkCount)
+  {
+    qWarning() << "Markup is too large to broadcast:" << payload.size() << "bytes after compression";
+    return;
+  }
+
+  header.count = static_cast<quint16>(chunkCount);
+
+  // keep only recent transfers, whose receivers may still ask for repairs
+  for (auto it = m_sentTransfers.begin(); it != m_sentTransfers.end();)
+  {
+    if (it->age.hasExpired(c_sentTransferRetention))
+      it = m_sentTransfers.erase(it);
+    else
+      ++it;
+  }
+
+  if (m_sentTransfers.size() >= c_maxSentTransfers)
+  {
+    auto oldest = std::max_element(m_sentTransfers.begin(), m_sentTransfers.end(), [](const SentTransfer& a, const SentTransfer& b)
+    {
+      return a.age.elapsed() < b.age.elapsed();
+    });
+    m_sentTransfers.erase(oldest);
+  }
+
+  SentTransfer& sentTransfer = m_sentTransfers[header.transferId];
+  sentTransfer.age.start();
+
+  QList<QByteArray>& chunks = sentTransfer.chunks;
+  chunks.reserve(chunkCount);
+  for (qsizetype i = 0; i < chunkCount; ++i)
+  {
+    const qsizetype offset = i * c_chunkPayloadSize;
+    const qsizetype length = qMin<qsizetype>(c_chunkPayloadSize, payload.size() - offset);
+
+    header.index = static_cast<quint16>(i);
+    QByteArray chunk(c_chunkHeaderSize + length, Qt::Uninitialized);
+    writeChunkHeader(chunk.data(), header);
+    memcpy(chunk.data() + c_chunkHeaderSize, payload.constData() + offset, static_cast<size_t>(length));
+    chunks.append(chunk);
+
+    queueChunk(header.transferId, header.index);
+  }
+
+  sendQueuedChunks();
+}
+
+/*!
+  \internal
+  \brief Queues chunk \a index of the sent transfer \a transferId, unless it is already waiting to be sent.
+ */
+void MarkupBroadcast::queueChunk(quint32 transferId, quint16 index)
+{
+  const quint64 key = chunkKey(transferId, index);
+  if (m_queuedChunks.contains(key))
+    return;
+
+  m_queuedChunks.insert(key);
+  m_sendQueue.append(key);
+
+  if (!m_sendTimer->isActive())
+    m_sendTimer->start();
+}
+
+/*!
+  \internal
+  \brief Sends the next few queued chunks, and stops the send timer once the queue is empty.
+ */
+void MarkupBroadcast::sendQueuedChunks()
+{
+  QList<QByteArray> chunks;
+  while (chunks.size() < c_chunksPerSend && !m_sendQueue.isEmpty())
+  {
+    const quint64 key = m_sendQueue.takeFirst();
+    m_queuedChunks.remove(key);
+
+    const auto it = m_sentTransfers.constFind(static_cast<quint32>(key >> 16));
+    const qsizetype index = static_cast<qsizetype>(key & 0xFFFF);
+    if (it != m_sentTransfers.cend() && index < it->chunks.size())
+      chunks.append(it->chunks.at(index));
+  }
+
+  if (!chunks.isEmpty())
+    m_dataSender->sendBatch(chunks);
+
+  if (m_sendQueue.isEmpty())
+    m_sendTimer->stop();
 }
 
 /*!
- \brief Updates the UDP Socket used for the DataSender.
+ \brief Updates the UDP target of the DataSender.
  */
 void MarkupBroadcast::updateDataSender()
 {
   if (!m_dataSender)
     return;
 
-  QUdpSocket* udpSocket = new QUdpSocket(m_dataSender);
-  udpSocket->connectToHost(QHostAddress::Broadcast, m_udpPort, QIODevice::WriteOnly);
-  m_dataSender->setDevice(udpSocket);
+  m_dataSender->setUdpTarget(QHostAddress::Broadcast, m_udpPort > 0 ? static_cast<quint16>(m_udpPort) : 0);
 }
 
 /*!
- \brief Updates the UDP Socket used for the DataListener.
+ \brief Updates the UDP port of the DataListener.
  */
 void MarkupBroadcast::updateDataListener()
 {
   if (!m_dataListener)
     return;
 
-  QUdpSocket* udpSocket = new QUdpSocket(this);
-  udpSocket->bind(m_udpPort, QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint);
-  m_dataListener->setDevice(udpSocket);
+  m_dataListener->setUdpPort(m_udpPort > 0 ? static_cast<quint16>(m_udpPort) : 0);
+}
+
+/*!
+  \internal
+  \brief Adds the chunk in \a datagram to its transfer and processes the markup once the transfer is complete.
+
+  Repair requests are passed on to processRepairRequest.
+ */
+void MarkupBroadcast::processDatagram(const QByteArray& datagram)
+{
+  ChunkHeader header;
+  if (!readChunkHeader(datagram, header))
+  {
+    processMarkup(datagram);
+    return;
+  }
+
+  if (header.flags & c_repairFlag)
+  {
+    processRepairRequest(header.senderId, header.transferId, header.count, datagram.mid(c_chunkHeaderSize));
+    return;
+  }
+
+  const quint64 key = transferKey(header.senderId, header.transferId);
+  if (m_completedTransfers.contains(key))
+    return;
+
+  auto it = m_transfers.find(key);
+  if (it == m_transfers.end())
+  {
+    // make room by dropping the transfer which has waited longest for a chunk
+    if (m_transfers.size() >= c_maxTransfers)
+    {
+      auto oldest = std::max_element(m_transfers.begin(), m_transfers.end(), [](const Transfer& a, const Transfer& b)
+      {
+        return a.age.elapsed() < b.age.elapsed();
+      });
+      m_transfers.erase(oldest);
+    }
+
+    Transfer transfer;
+    transfer.chunks.resize(header.count);
+    transfer.size = header.size;
+    transfer.compressed = header.flags & c_compressedFlag;
+    it = m_transfers.insert(key, transfer);
+  }
+
+  Transfer& transfer = it.value();
+  if (transfer.chunks.size() != header.count || transfer.size != header.size)
+    return;
+
+  transfer.age.start();
+
+  QByteArray& chunk = transfer.chunks[header.index];
+  if (chunk.isNull())
+  {
+    chunk = datagram.mid(c_chunkHeaderSize);
+    transfer.chunksReceived++;
+  }
+
+  if (transfer.chunksReceived < transfer.chunks.size())
+  {
+    if (!m_transferTimer->isActive())
+      m_transferTimer->start();
+
+    return;
+  }
+
+  const Transfer completed = m_transfers.take(key);
+  m_completedTransfers.append(key);
+  if (m_completedTransfers.size() > c_completedTransferHistory)
+    m_completedTransfers.removeFirst();
+
+  if (m_transfers.isEmpty())
+    m_transferTimer->stop();
+
+  const QByteArray payload = completed.chunks.join();
+  if (!completed.compressed)
+  {
+    processMarkup(payload);
+    return;
+  }
+
+  QByteArray data;
+  if (!inflateMarkup(payload, completed.size, data))
+  {
+    qWarning() << "Received markup could not be decompressed";
+    return;
+  }
+
+  processMarkup(data);
+}
+
+/*!
+  \internal
+  \brief Queues the chunks listed in \a indices again, if the repair request is for the
+  transfer \a transferId of \a chunkCount chunks sent by this tool with \a senderId.
+
+  Requests for other senders' transfers, or for transfers which are no longer kept, are ignored.
+ */
+void MarkupBroadcast::processRepairRequest(quint32 senderId, quint32 transferId, quint16 chunkCount, const QByteArray& indices)
+{
+  if (senderId != m_senderId)
+    return;
+
+  const auto it = m_sentTransfers.constFind(transferId);
+  if (it == m_sentTransfers.cend() || it->chunks.size() != chunkCount)
+    return;
+
+  for (qsizetype offset = 0; offset + 2 <= indices.size(); offset += 2)
+  {
+    const quint16 index = qFromBigEndian<quint16>(indices.constData() + offset);
+    if (index < chunkCount)
+      queueChunk(transferId, index);
+  }
+}
+
+/*!
+  \internal
+  \brief Broadcasts a request for the chunks still missing from the transfer \a transferId of \a senderId.
+ */
+void MarkupBroadcast::requestRepair(quint32 senderId, quint32 transferId, Transfer& transfer)
+{
+  ChunkHeader header;
+  header.flags = c_repairFlag;
+  header.senderId = senderId;
+  header.transferId = transferId;
+  header.count = static_cast<quint16>(transfer.chunks.size());
+  header.size = transfer.size;
+
+  // every index of the largest transfer fits in one request
+  QByteArray request(c_chunkHeaderSize + (transfer.chunks.size() - transfer.chunksReceived) * 2, Qt::Uninitialized);
+  writeChunkHeader(request.data(), header);
+
+  char* data = request.data() + c_chunkHeaderSize;
+  for (qsizetype i = 0; i < transfer.chunks.size(); ++i)
+  {
+    if (!transfer.chunks.at(i).isNull())
+      continue;
+
+    qToBigEndian<quint16>(static_cast<quint16>(i), data);
+    data += 2;
+  }
+
+  transfer.repairRequests++;
+  m_dataSender->sendData(request);
+}
+
+/*!
+  \internal
+  \brief Creates a MarkupLayer from the markup JSON in \a data and notifies whether it was sent or received.
+
+  The markup is also written to disk in the background.
+ */
+void MarkupBroadcast::processMarkup(const QByteArray& data)
+{
+  QJsonParseError parseError;
+  const QJsonDocument markupJson = QJsonDocument::fromJson(data, &parseError);
+  if (!markupJson.isObject())
+  {
+    qWarning() << "Received markup is not valid JSON:" << parseError.errorString();
+    return;
+  }
+
+  const QJsonObject markupObject = markupJson.object();
+  const QString sharedBy = markupObject.value(SHAREDBYKEY).toString();
+  const QString markupName = markupObject.value(MARKUPKEY).toObject().value(NAMEKEY).toString();
+
+  MarkupLayer* markupLayer = MarkupLayer::fromJsonObject(markupObject, QString::fromUtf8(data), this);
+  writeMarkup(markupLayer, markupName, sharedBy, data);
+}
+
+/*!
+  \internal
+  \brief Writes the markup JSON in \a data to a new \c .markup file named after \a markupName on the write thread.
+
+  Once the file has been written, the path of \a markupLayer is set and the layer is
+  handed on with markupReceived or markupSent, so a layer is never added to the map
+  before it can be saved in the layer cache.
+ */
+void MarkupBroadcast::writeMarkup(MarkupLayer* markupLayer, const QString& markupName, const QString& sharedBy, const QByteArray& data)
+{
+  const QString markupFolderName = QString("%1/OperationalData").arg(m_rootDataDirectory);
+  QPointer<MarkupLayer> layer(markupLayer);
+
+  m_writePool->start([this, layer, markupFolderName, markupName, sharedBy, data]
+  {
+    QString markupFileName = QString("%1/%2.markup").arg(markupFolderName, markupName);
+    if (QFileInfo::exists(markupFileName))
+      markupFileName = QString("%1/%2_%3.markup").arg(markupFolderName, markupName, QString::number(QDateTime::currentMSecsSinceEpoch()));
+
+    QFile markupFile(markupFileName);
+    if (!markupFile.open(QIODevice::WriteOnly) || markupFile.write(data) != data.size() || !markupFile.putChar('\n'))
+    {
+      qWarning() << "Received markup could not be written to" << markupFileName << markupFile.errorString();
+      markupFileName.clear();
+    }
+
+    markupFile.close();
+
+    QMetaObject::invokeMethod(this, [this, layer, markupFileName, sharedBy]
+    {
+      deliverMarkup(layer, markupFileName, sharedBy);
+    }, Qt::QueuedConnection);
+  });
+}
+
+/*!
+  \internal
+  \brief Sets the \a filePath of \a markupLayer and notifies whether the markup, \a sharedBy its author, was sent or received.
+
+  An empty \a filePath means the markup could not be written; the layer is still
+  shown, but is not restored on the next start. A previous layer which no receiver
+  took ownership of is deleted, as its markup is available from disk.
+ */
+void MarkupBroadcast::deliverMarkup(MarkupLayer* markupLayer, const QString& filePath, const QString& sharedBy)
+{
+  if (!markupLayer)
+    return;
+
+  if (!filePath.isEmpty())
+    markupLayer->setPath(filePath);
+
+  if (m_unclaimedLayer && m_unclaimedLayer->parent() == this)
+    m_unclaimedLayer->deleteLater();
+
+  m_unclaimedLayer = markupLayer;
+
+  // process the markup differently if it is the one that you sent
+  if (m_username == sharedBy)
+    emit this->markupSent(markupLayer);
+  else
+    emit this->markupReceived(markupLayer, sharedBy);
+}
+
+/*!
+  \internal
+  \brief Requests the missing chunks of transfers which have stopped receiving them, and
+  drops the transfers which have not received a chunk within the timeout.
+ */
+void MarkupBroadcast::checkTransfers()
+{
+  for (auto it = m_transfers.begin(); it != m_transfers.end();)
+  {
+    if (it->age.hasExpired(c_transferTimeout))
+    {
+      qWarning() << "Dropped incomplete markup transfer with" << it->chunksReceived << "of" << it->chunks.size() << "chunks";
+      it = m_transfers.erase(it);
+      continue;
+    }
+
+    if (it->repairRequests < c_maxRepairRequests && it->age.hasExpired(c_repairDelay * (it->repairRequests + 1)))
+      requestRepair(static_cast<quint32>(it.key() >> 32), static_cast<quint32>(it.key()), it.value());
+
+    ++it;
+  }
+
+  if (m_transfers.isEmpty())
+    m_transferTimer->stop();
 }
 
 } // Dsa
 
 // Signal Documentation
 /*!
-  \fn void MarkupBroadcast::markupReceived(const QString& filePath, const QString& sharedBy);
+  \fn void MarkupBroadcast::markupReceived(Dsa::MarkupLayer* markupLayer, const QString& sharedBy);
   \brief Signal emitted when a markup is received.
 
-  The \a filePath to the JSON and the author that the markup was \a sharedBy are passed through
+  The \a markupLayer created from the markup and the author that the markup was \a sharedBy are passed through
   as parameters.
  */
 
 /*!
-  \fn void MarkupBroadcast::markupSent(const QString& filePath);
-  \brief Signal emitted when a markup is sent with the specified \a filePath.
+  \fn void MarkupBroadcast::markupSent(Dsa::MarkupLayer* markupLayer);
+  \brief Signal emitted when a markup is sent, with the \a markupLayer created from it.
  */
@@ -19,9 +19,19 @@
 
 // dsa headers
 #include "AbstractTool.h"
+#include "MarkupLayer.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QSet>
 
 class QJsonObject;
 class QJsonDocument;
+class QThreadPool;
+class QTimer;
 
 namespace Dsa
 {
@@ -43,13 +53,39 @@ public:
   void broadcastMarkup(const QString& json);
 
 signals:
-  void markupReceived(const QString& filePath, const QString& sharedBy);
-  void markupSent(const QString& filePath);
+  void markupReceived(Dsa::MarkupLayer* markupLayer, const QString& sharedBy);
+  void markupSent(Dsa::MarkupLayer* markupLayer);
 
 private:
+  struct Transfer
+  {
+    QList<QByteArray> chunks;
+    int chunksReceived = 0;
+    quint32 size = 0;
+    bool compressed = false;
+    int repairRequests = 0;
+    QElapsedTimer age;
+  };
+
+  struct SentTransfer
+  {
+    QList<QByteArray> chunks;
+    QElapsedTimer age;
+  };
+
   void updateDataSender();
   void updateDataListener();
 
+  void queueChunk(quint32 transferId, quint16 index);
+  void sendQueuedChunks();
+  void processDatagram(const QByteArray& datagram);
+  void processRepairRequest(quint32 senderId, quint32 transferId, quint16 chunkCount, const QByteArray& indices);
+  void requestRepair(quint32 senderId, quint32 transferId, Transfer& transfer);
+  void processMarkup(const QByteArray& data);
+  void checkTransfers();
+  void writeMarkup(MarkupLayer* markupLayer, const QString& markupName, const QString& sharedBy, const QByteArray& data);
+  void deliverMarkup(MarkupLayer* markupLayer, const QString& filePath, const QString& sharedBy);
+
   static const QString MARKUPCONFIG_PROPERTYNAME;
   static const QString ROOTDATA_PROPERTYNAME;
   static const QString UDPPORT_PROPERTYNAME;
@@ -62,6 +98,17 @@ private:
   DataSender* m_dataSender;
   DataListener* m_dataListener;
   int m_udpPort = -1;
+  quint32 m_senderId = 0;
+  quint32 m_nextTransferId = 0;
+  QHash<quint64, Transfer> m_transfers;
+  QList<quint64> m_completedTransfers;
+  QHash<quint32, SentTransfer> m_sentTransfers;
+  QList<quint64> m_sendQueue;
+  QSet<quint64> m_queuedChunks;
+  QTimer* m_sendTimer = nullptr;
+  QTimer* m_transferTimer = nullptr;
+  QThreadPool* m_writePool = nullptr;
+  QPointer<MarkupLayer> m_unclaimedLayer;
 };
 
 } // Dsa
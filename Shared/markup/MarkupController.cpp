@@ -72,14 +72,14 @@ MarkupController::MarkupController(QObject* parent):
   updateGeoView();
   updatedSymbol();
 
-  connect(m_markupBroadcast, &MarkupBroadcast::markupReceived, this, [this](const QString& fileName, const QString& sharedBy)
+  connect(m_markupBroadcast, &MarkupBroadcast::markupReceived, this, [this](MarkupLayer* markupLayer, const QString& sharedBy)
   {
-    emit this->markupReceived(fileName, sharedBy);
+    emit this->markupReceived(markupLayer, sharedBy);
   });
 
-  connect(m_markupBroadcast, &MarkupBroadcast::markupSent, this, [this](const QString& fileName)
+  connect(m_markupBroadcast, &MarkupBroadcast::markupSent, this, [this](MarkupLayer* markupLayer)
   {
-    emit this->markupSent(fileName);
+    emit this->markupSent(markupLayer);
   });
 
   ToolManager::instance().addTool(this);
@@ -460,15 +460,15 @@ QColor MarkupController::currentColor() const
 
 // Signal Documentation
 /*!
-  \fn void MarkupController::markupSent(const QString& filePath);
-  \brief Signal emitted when a markup is sent with the specified \a filePath.
+  \fn void MarkupController::markupSent(Dsa::MarkupLayer* markupLayer);
+  \brief Signal emitted when a markup is sent, with the \a markupLayer created from it.
  */
 
 /*!
-  \fn void MarkupController::markupReceived(const QString& filePath, const QString& sharedBy);
+  \fn void MarkupController::markupReceived(Dsa::MarkupLayer* markupLayer, const QString& sharedBy);
   \brief Signal emitted when a markup is received.
 
-  The \a filePath to the JSON and the author that the markup was \a sharedBy are passed through
+  The \a markupLayer created from the markup and the author that the markup was \a sharedBy are passed through
   as parameters.
  */
 
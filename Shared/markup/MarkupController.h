@@ -19,6 +19,7 @@
 
 // dsa app headers
 #include "AbstractSketchTool.h"
+#include "MarkupLayer.h"
 
 // Qt headers
 #include <QColor>
@@ -73,8 +74,8 @@ signals:
   void drawingAltitudeChanged();
   void sketchCompleted();
   void sketchingChanged();
-  void markupReceived(const QString& filePath, const QString& sharedBy);
-  void markupSent(const QString& filePath);
+  void markupReceived(Dsa::MarkupLayer* markupLayer, const QString& sharedBy);
+  void markupSent(Dsa::MarkupLayer* markupLayer);
 
 private:
   void updateGeoView();
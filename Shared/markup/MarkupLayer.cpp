@@ -61,16 +61,13 @@ namespace Dsa {
 
 /*!
  \internal
- \brief Constructor that takes a \a featureCollection and an optional \a parent.
+ \brief Constructor that takes the \a json text, its parsed \a markupJson, a \a featureCollection and an optional \a parent.
  */
-MarkupLayer::MarkupLayer(const QString& json, FeatureCollection* featureCollection, QObject* parent) :
+MarkupLayer::MarkupLayer(const QString& json, const QJsonObject& markupJson, FeatureCollection* featureCollection, QObject* parent) :
   FeatureCollectionLayer(featureCollection, parent),
   m_json(json),
   m_featureCollection(featureCollection)
 {
-  const QJsonDocument markupDoc = QJsonDocument::fromJson(json.toUtf8());
-  const QJsonObject markupJson = markupDoc.object();
-
   // Clear Hash to keep track of features/symbols added to the table
   m_featureHash.clear();
 
@@ -87,9 +84,9 @@ MarkupLayer::MarkupLayer(const QString& json, FeatureCollection* featureCollecti
     auto* feature = table->createFeature(table);
     const auto geomString = QString(QJsonDocument(element.value(MarkupConstants::GEOMETRY).toObject()).toJson(QJsonDocument::Compact));
     feature->setGeometry(Geometry::fromJson(geomString));
-    table->addFeatureAsync(feature).then(this, [parent, table, elementColor, feature]()
+    table->addFeatureAsync(feature).then(this, [table, elementColor, feature]()
     {
-      auto* sls = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, elementColor, 12.0f, parent);
+      auto* sls = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, elementColor, 12.0f, table);
       table->setSymbolOverride(feature, sls);
     });
   }
@@ -190,21 +187,33 @@ MarkupLayer* MarkupLayer::createFromGraphics(GraphicsOverlay* graphicsOverlay, c
  \brief Returns a MarkupLayer for the input \a json.
 */
 MarkupLayer* MarkupLayer::fromJson(const QString& json, QObject* parent)
+{
+  return fromJsonObject(QJsonDocument::fromJson(json.toUtf8()).object(), json, parent);
+}
+
+/*!
+ \brief Returns a MarkupLayer for \a markupJson, which has already been parsed from \a json.
+
+ Use this when the document is already at hand, to avoid parsing the JSON a second time.
+*/
+MarkupLayer* MarkupLayer::fromJsonObject(const QJsonObject& markupJson, const QString& json, QObject* parent)
 {
   bool useZ = json.contains(R"("hasZ":true)");
   bool useM = json.contains(R"("hasM":true)");
 
   // Create the FeatureCollectionTable
   FeatureCollectionTable* table = new FeatureCollectionTable(QList<Field>{}, GeometryType::Polyline, SpatialReference(4326), useZ, useM, parent);
-  SimpleRenderer* defaultRenderer = new SimpleRenderer(parent);
-  defaultRenderer->setSymbol(new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, QColor("red"), 12.0f, parent));
+  SimpleRenderer* defaultRenderer = new SimpleRenderer(table);
+  defaultRenderer->setSymbol(new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, QColor("red"), 12.0f, defaultRenderer));
   table->setRenderer(defaultRenderer);
 
   // Add the table to a Collection
   FeatureCollection* featureCollection = new FeatureCollection(QList<FeatureCollectionTable*>{table}, parent);
 
-  // Create a MarkupLayer
-  MarkupLayer* markupLayer = new MarkupLayer(json, featureCollection, parent);
+  // Create a MarkupLayer, which owns the collection so they are deleted together
+  MarkupLayer* markupLayer = new MarkupLayer(json, markupJson, featureCollection, parent);
+  featureCollection->setParent(markupLayer);
+  table->setParent(featureCollection);
 
   return markupLayer;
 }
@@ -54,12 +54,13 @@ public:
 
   // JSON Serializable
   static MarkupLayer* fromJson(const QString& json, QObject* parent = nullptr);
+  static MarkupLayer* fromJsonObject(const QJsonObject& markupJson, const QString& json, QObject* parent = nullptr);
   QString toJson() const override;
   QJsonObject unknownJson() const override;
   QJsonObject unsupportedJson() const override;
 
 private:
-  MarkupLayer(const QString& json, Esri::ArcGISRuntime::FeatureCollection* featureCollection, QObject* parent = nullptr);
+  MarkupLayer(const QString& json, const QJsonObject& markupJson, Esri::ArcGISRuntime::FeatureCollection* featureCollection, QObject* parent = nullptr);
 
   QString m_path;
   QString m_json;
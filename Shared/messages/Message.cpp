@@ -53,6 +53,7 @@ const QString Message::GEOMESSAGE_CONTROL_POINTS_NAME{QStringLiteral("_control_p
 const QString Message::GEOMESSAGE_UNIQUE_DESIGNATION_NAME{QStringLiteral("uniquedesignation")};
 const QString Message::GEOMESSAGE_STATUS_911_NAME{QStringLiteral("status911")};
 const QString Message::GEOMESSAGE_ENVIRONMENT_NAME{QStringLiteral("environment")};
+const QString Message::GEOMESSAGE_DATETIME_VALID_NAME{QStringLiteral("datetimevalid")};
 
 const QString Message::SIDC_NAME{QStringLiteral("sidc")};
 
@@ -51,6 +51,7 @@ public:
   static const QString GEOMESSAGE_UNIQUE_DESIGNATION_NAME;
   static const QString GEOMESSAGE_STATUS_911_NAME;
   static const QString GEOMESSAGE_ENVIRONMENT_NAME;
+  static const QString GEOMESSAGE_DATETIME_VALID_NAME;
 
   static const QString SIDC_NAME;
 
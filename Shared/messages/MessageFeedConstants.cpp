@@ -26,6 +26,8 @@ const QString MessageFeedConstants::OBSERVATION_REPORT_CONFIG_PORT = QStringLite
 const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PROPERTYNAME = QStringLiteral("LocationBroadcastConfig");
 const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MESSAGE_TYPE = QStringLiteral("messageType");
 const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PORT = QStringLiteral("port");
+const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD = QStringLiteral("distanceThreshold");
+const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_HEARTBEAT_INTERVAL = QStringLiteral("heartbeatInterval");
 const QString MessageFeedConstants::MESSAGE_FEEDS_PROPERTYNAME = QStringLiteral("MessageFeeds");
 const QString MessageFeedConstants::MESSAGE_FEEDS_NAME = QStringLiteral("name");
 const QString MessageFeedConstants::MESSAGE_FEEDS_TYPE= QStringLiteral("type");
@@ -33,5 +35,6 @@ const QString MessageFeedConstants::MESSAGE_FEEDS_RENDERER = QStringLiteral("ren
 const QString MessageFeedConstants::MESSAGE_FEEDS_THUMBNAIL = QStringLiteral("thumbnail");
 const QString MessageFeedConstants::MESSAGE_FEEDS_PLACEMENT = QStringLiteral("placement");
 const QString MessageFeedConstants::MESSAGE_FEED_UDP_PORTS_PROPERTYNAME = QStringLiteral("MessageFeedUdpPorts");
+const QString MessageFeedConstants::TRACK_SIMULATION_PROPERTYNAME = QStringLiteral("TrackSimulation");
 
 } // Dsa
@@ -32,6 +32,8 @@ public:
   static const QString LOCATION_BROADCAST_CONFIG_PROPERTYNAME;
   static const QString LOCATION_BROADCAST_CONFIG_MESSAGE_TYPE;
   static const QString LOCATION_BROADCAST_CONFIG_PORT;
+  static const QString LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD;
+  static const QString LOCATION_BROADCAST_CONFIG_HEARTBEAT_INTERVAL;
   static const QString MESSAGE_FEEDS_PROPERTYNAME;
   static const QString MESSAGE_FEEDS_NAME;
   static const QString MESSAGE_FEEDS_TYPE;
@@ -39,6 +41,7 @@ public:
   static const QString MESSAGE_FEEDS_THUMBNAIL;
   static const QString MESSAGE_FEEDS_PLACEMENT;
   static const QString MESSAGE_FEED_UDP_PORTS_PROPERTYNAME;
+  static const QString TRACK_SIMULATION_PROPERTYNAME;
 };
 
 } // Dsa
@@ -29,10 +29,11 @@
 #include "SimpleRenderer.h"
 
 // Qt headers
+#include <QDebug>
 #include <QFileInfo>
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
-#include <QUdpSocket>
 
 // DSA headers
 #include "AppConstants.h"
@@ -43,8 +44,10 @@
 #include "MessageFeedConstants.h"
 #include "MessageFeedListModel.h"
 #include "MessagesOverlay.h"
+#include "StreamVerifier.h"
 #include "ToolManager.h"
 #include "ToolResourceProvider.h"
+#include "TrackFeedSimulator.h"
 
 using namespace Esri::ArcGISRuntime;
 
@@ -65,8 +68,11 @@ const QString MessageFeedsController::RESOURCE_DIRECTORY_PROPERTYNAME = "Resourc
 MessageFeedsController::MessageFeedsController(QObject* parent) :
   AbstractTool(parent),
   m_messageFeeds(new MessageFeedListModel(this)),
-  m_locationBroadcast(new LocationBroadcast(this))
+  m_locationBroadcast(new LocationBroadcast(this)),
+  m_trackSimulator(new TrackFeedSimulator(m_messageFeeds, this))
 {
+  connect(m_trackSimulator, &TrackFeedSimulator::errorOccurred, this, &MessageFeedsController::toolErrorOccurred);
+
   connect(ToolResourceProvider::instance(), &ToolResourceProvider::geoViewChanged, this, [this]
   {
     setGeoView(ToolResourceProvider::instance()->geoView());
@@ -126,8 +132,30 @@ void MessageFeedsController::addDataListener(DataListener* dataListener)
 
   m_dataListeners.append(dataListener);
 
-  connect(dataListener, &DataListener::dataReceived, this, [this](const QByteArray& data)
+  // checkpoints of a deterministic simulator run are verified per listener and never reach the feeds
+  auto* streamVerifier = new StreamVerifier(dataListener);
+  connect(streamVerifier, &StreamVerifier::checkpointVerified, this, [this](bool matched, const QVariantMap& report)
+  {
+    // later checkpoints of the run fail as well, so only the first mismatch is reported
+    if (!matched && report.value(QStringLiteral("checkpointsMismatched")).toLongLong() == 1)
+    {
+      emit toolErrorOccurred(QStringLiteral("Simulated message stream does not match"),
+                             QString("Run %1 expected %2 messages but %3 were received").arg(report.value(QStringLiteral("run")).toString(),
+                                                                                            report.value(QStringLiteral("messagesExpected")).toString(),
+                                                                                            report.value(QStringLiteral("messagesReceived")).toString()));
+    }
+  });
+  connect(streamVerifier, &StreamVerifier::runFinished, this, [this](const QVariantMap& report)
+  {
+    qDebug() << "Simulated message stream verification:" << QJsonDocument(QJsonObject::fromVariantMap(report)).toJson(QJsonDocument::Compact);
+    emit streamVerified(report);
+  });
+
+  connect(dataListener, &DataListener::dataReceived, this, [this, streamVerifier](const QByteArray& data)
   {
+    if (streamVerifier->processData(data))
+      return;
+
     Message m = Message::create(data);
     if (m.isEmpty())
       return;
@@ -211,6 +239,10 @@ void MessageFeedsController::setupFeeds()
 
   // only needs to be cached until the geoView is ready
   m_messageFeedProperties.clear();
+
+  // simulated tracks need their feeds to exist
+  if (!m_trackSimulationFile.isEmpty())
+    startTrackSimulation(m_trackSimulationFile);
 }
 
 /*!
@@ -223,6 +255,8 @@ void MessageFeedsController::setupFeeds()
     \li \c MessageFeeds - A list of message feed configurations.
     \li \c LocationBroadcastConfig - The location broadcast configuration details.
     \li \c UserName - the name of the user to be broadcast.
+    \li \c TrackSimulation - A track simulation configuration file, replayed into the
+        message feeds once they are set up. See TrackFeedSimulator.
   \endlist
  */
 void MessageFeedsController::setProperties(const QVariantMap& properties)
@@ -241,13 +275,24 @@ void MessageFeedsController::setProperties(const QVariantMap& properties)
     const auto messageFeedUdpPorts = properties[MessageFeedConstants::MESSAGE_FEED_UDP_PORTS_PROPERTYNAME].toStringList();
     for (const auto& udpPort : messageFeedUdpPorts)
     {
-      QUdpSocket* udpSocket = new QUdpSocket(this);
-      udpSocket->bind(udpPort.toInt(), QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint);
+      DataListener* dataListener = new DataListener(this);
+      dataListener->setUdpPort(udpPort.toUShort());
 
-      addDataListener(new DataListener(udpSocket, this));
+      addDataListener(dataListener);
     }
   }
 
+  // the simulation starts once the feeds are set up, or restarts when changed after that
+  const auto trackSimulationFile = properties[MessageFeedConstants::TRACK_SIMULATION_PROPERTYNAME].toString();
+  if (trackSimulationFile != m_trackSimulationFile)
+  {
+    m_trackSimulationFile = trackSimulationFile;
+    if (m_trackSimulationFile.isEmpty())
+      stopTrackSimulation();
+    else if (m_messageFeeds->rowCount() > 0)
+      startTrackSimulation(m_trackSimulationFile);
+  }
+
   // only setup message feeds at startup
   if (m_geoView && m_messageFeeds->rowCount() == 0)
     setupFeeds();
@@ -259,6 +304,12 @@ void MessageFeedsController::setProperties(const QVariantMap& properties)
     m_locationBroadcast->setMessageType(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MESSAGE_TYPE).toString());
     m_locationBroadcast->setUdpPort(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PORT).toInt());
   }
+
+  if (locationBroadcastConfig.contains(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD))
+    m_locationBroadcast->setDistanceThreshold(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD).toDouble());
+
+  if (locationBroadcastConfig.contains(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_HEARTBEAT_INTERVAL))
+    m_locationBroadcast->setHeartbeatInterval(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_HEARTBEAT_INTERVAL).toInt());
 }
 
 /*!
@@ -363,6 +414,43 @@ void MessageFeedsController::setLocationBroadcastInDistress(bool inDistress)
   emit locationBroadcastInDistressChanged();
 }
 
+/*!
+  \brief Returns the simulator which replays GPX tracks straight into the message feeds.
+ */
+TrackFeedSimulator* MessageFeedsController::trackSimulator() const
+{
+  return m_trackSimulator;
+}
+
+/*!
+  \brief Starts replaying the tracks of the simulation configuration \a configFile into
+  the message feeds, replacing any simulation already running.
+
+  Returns \c false if the configuration has no track which could be replayed.
+ */
+bool MessageFeedsController::startTrackSimulation(const QString& configFile)
+{
+  stopTrackSimulation();
+
+  if (!m_trackSimulator->loadConfiguration(configFile))
+    return false;
+
+  m_trackSimulator->start();
+  return true;
+}
+
+/*!
+  \brief Stops the track simulation and logs its statistics.
+ */
+void MessageFeedsController::stopTrackSimulation()
+{
+  if (!m_trackSimulator->isRunning())
+    return;
+
+  m_trackSimulator->stop();
+  qDebug() << "Track simulation:" << QJsonDocument(QJsonObject::fromVariantMap(m_trackSimulator->statistics())).toJson(QJsonDocument::Compact);
+}
+
 SurfacePlacement MessageFeedsController::toSurfacePlacement(const QString& surfacePlacement)
 {
   if (surfacePlacement.compare("relative", Qt::CaseInsensitive) == 0)
@@ -467,6 +555,14 @@ Renderer* MessageFeedsController::createRenderer(const QString& rendererInfo, QO
   \brief Signal emitted when the \l locationBroadcastInDistress property changes.
  */
 
+/*!
+  \fn void MessageFeedsController::streamVerified(const QVariantMap& report);
+  \brief Signal emitted when a deterministic message simulator run has ended on one of the
+  listened ports, with the \a report of its verification and end-to-end latency.
+
+  \sa StreamVerifier::report
+ */
+
 } // Dsa
 
 /*!
@@ -41,6 +41,8 @@ class LocationBroadcast;
 
 class MessageFeedListModel;
 
+class TrackFeedSimulator;
+
 class MessageFeedsController : public AbstractTool
 {
   Q_OBJECT
@@ -81,12 +83,17 @@ public:
   bool isLocationBroadcastInDistress() const;
   void setLocationBroadcastInDistress(bool inDistress);
 
+  TrackFeedSimulator* trackSimulator() const;
+  bool startTrackSimulation(const QString& configFile);
+  void stopTrackSimulation();
+
   static Esri::ArcGISRuntime::SurfacePlacement toSurfacePlacement(const QString& surfacePlacement);
 
 signals:
   void locationBroadcastEnabledChanged();
   void locationBroadcastFrequencyChanged();
   void locationBroadcastInDistressChanged();
+  void streamVerified(const QVariantMap& report);
   void toolErrorOccurred(const QString& errorMessage, const QString& additionalMessage);
 
 private:
@@ -100,6 +107,8 @@ private:
   QString m_resourcePath;
   LocationBroadcast* m_locationBroadcast = nullptr;
   QVariantList m_messageFeedProperties;
+  TrackFeedSimulator* m_trackSimulator = nullptr;
+  QString m_trackSimulationFile;
 };
 
 } // Dsa
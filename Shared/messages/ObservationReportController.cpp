@@ -40,7 +40,6 @@
 // Qt headers
 #include <QDateTime>
 #include <QHostInfo>
-#include <QUdpSocket>
 #include <QUuid>
 
 using namespace Esri::ArcGISRuntime;
@@ -296,10 +295,7 @@ void ObservationReportController::broadcastReport(const QString& size,
   if (!m_dataSender)
   {
     m_dataSender = new DataSender(this);
-
-    QUdpSocket* udpSocket = new QUdpSocket(m_dataSender);
-    udpSocket->connectToHost(QHostAddress::Broadcast, m_udpPort, QIODevice::WriteOnly);
-    m_dataSender->setDevice(udpSocket);
+    m_dataSender->setUdpTarget(QHostAddress::Broadcast, m_udpPort);
   }
 
   m_dataSender->sendData(observationReport.toGeoMessage());
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "StreamVerifier.h"
+
+namespace Dsa {
+
+namespace
+{
+constexpr qint64 c_nanosecondsPerMicrosecond = 1000;
+} // namespace
+
+/*!
+  \class Dsa::StreamVerifier
+  \inmodule Dsa
+  \inherits QObject
+  \brief Verifies that the messages received on a port are identical to those
+  sent by a deterministic message simulator run.
+
+  The simulator sends a checkpoint message at the start of a run, after every
+  so many messages, and at the end. Between checkpoints the verifier adds every
+  received message to its own StreamChecksum; at each checkpoint the count and
+  checksum must match the sender's, otherwise a message was lost, duplicated,
+  reordered or altered. The time each checkpoint took to arrive is recorded as
+  the end-to-end latency, which is only meaningful when the clocks of the sender
+  and the receiver are synchronized, for example when both run on one machine.
+
+  Nothing is computed until the first checkpoint of a run arrives.
+
+  \sa StreamChecksum
+ */
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+StreamVerifier::StreamVerifier(QObject* parent) :
+  QObject(parent)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+StreamVerifier::~StreamVerifier()
+{
+}
+
+/*!
+  \brief Processes a datagram \a data received on the verified port.
+
+  Returns \c true if \a data was a checkpoint, which is not a message and
+  should not be processed further.
+ */
+bool StreamVerifier::processData(const QByteArray& data)
+{
+  if (StreamChecksum::isCheckpointMessage(data))
+  {
+    StreamChecksum::Checkpoint checkpoint;
+    if (StreamChecksum::parseCheckpoint(data, checkpoint))
+      processCheckpoint(checkpoint);
+
+    return true;
+  }
+
+  if (isVerifying())
+    m_checksum.add(data);
+
+  return false;
+}
+
+/*!
+  \brief Returns whether a simulator run is being verified.
+ */
+bool StreamVerifier::isVerifying() const
+{
+  return !m_run.isEmpty() && !m_finished;
+}
+
+/*!
+  \brief Returns the state of the current or last run.
+
+  The report contains the \c run identifier, the number of checkpoints which
+  matched and did not, the messages expected and received, whether the run has
+  \c finished, and the end-to-end \c latency distribution of the checkpoints.
+ */
+QVariantMap StreamVerifier::report() const
+{
+  QVariantMap result;
+  result.insert(QStringLiteral("run"), m_run);
+  result.insert(QStringLiteral("checkpointsMatched"), m_checkpointsMatched);
+  result.insert(QStringLiteral("checkpointsMismatched"), m_checkpointsMismatched);
+  result.insert(QStringLiteral("messagesExpected"), m_expectedMessages);
+  result.insert(QStringLiteral("messagesReceived"), m_checksum.count());
+  result.insert(QStringLiteral("verified"), m_checkpointsMismatched == 0 && m_checksum.count() == m_expectedMessages);
+  result.insert(QStringLiteral("finished"), m_finished);
+  result.insert(QStringLiteral("latency"), m_latency.toVariantMap());
+
+  return result;
+}
+
+/*!
+  \internal
+ */
+void StreamVerifier::processCheckpoint(const StreamChecksum::Checkpoint& checkpoint)
+{
+  // a checkpoint from another run starts verifying that run from scratch
+  if (checkpoint.run != m_run)
+  {
+    m_run = checkpoint.run;
+    m_checksum.reset();
+    m_latency.clear();
+    m_checkpointsMatched = 0;
+    m_checkpointsMismatched = 0;
+    m_finished = false;
+  }
+
+  if (m_finished)
+    return;
+
+  m_latency.record((StreamChecksum::currentTimeUs() - checkpoint.sentUs) * c_nanosecondsPerMicrosecond);
+  m_expectedMessages = checkpoint.count;
+
+  const bool matched = checkpoint.count == m_checksum.count() && checkpoint.checksum == m_checksum.value();
+  if (matched)
+    m_checkpointsMatched++;
+  else
+    m_checkpointsMismatched++;
+
+  m_finished = checkpoint.final;
+
+  const QVariantMap currentReport = report();
+  emit checkpointVerified(matched, currentReport);
+
+  if (m_finished)
+    emit runFinished(currentReport);
+}
+
+} // Dsa
+
+// Signal Documentation
+/*!
+  \fn void StreamVerifier::checkpointVerified(bool matched, const QVariantMap& report);
+  \brief Signal emitted when a checkpoint has been compared, with whether it
+  \a matched and the \a report of the run so far.
+ */
+
+/*!
+  \fn void StreamVerifier::runFinished(const QVariantMap& report);
+  \brief Signal emitted when the final checkpoint of a run arrives, with the
+  \a report of the whole run.
+ */
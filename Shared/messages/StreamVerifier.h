@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef STREAMVERIFIER_H
+#define STREAMVERIFIER_H
+
+// DSA headers
+#include "LatencyHistogram.h"
+#include "StreamChecksum.h"
+
+// Qt headers
+#include <QObject>
+#include <QVariantMap>
+
+namespace Dsa {
+
+class StreamVerifier : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit StreamVerifier(QObject* parent = nullptr);
+  ~StreamVerifier() override;
+
+  bool processData(const QByteArray& data);
+
+  bool isVerifying() const;
+  QVariantMap report() const;
+
+signals:
+  void checkpointVerified(bool matched, const QVariantMap& report);
+  void runFinished(const QVariantMap& report);
+
+private:
+  Q_DISABLE_COPY(StreamVerifier)
+
+  void processCheckpoint(const StreamChecksum::Checkpoint& checkpoint);
+
+  QString m_run;
+  StreamChecksum m_checksum;
+  LatencyHistogram m_latency;
+  qint64 m_checkpointsMatched = 0;
+  qint64 m_checkpointsMismatched = 0;
+  qint64 m_expectedMessages = 0;
+  bool m_finished = false;
+};
+
+} // Dsa
+
+#endif // STREAMVERIFIER_H
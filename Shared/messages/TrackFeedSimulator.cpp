@@ -0,0 +1,391 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "TrackFeedSimulator.h"
+
+// C++ API headers
+#include "Point.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+// DSA headers
+#include "GpxTrack.h"
+#include "MessageFeed.h"
+#include "MessageFeedListModel.h"
+
+// STL headers
+#include <cmath>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+namespace
+{
+const QString c_updateIntervalKey = QStringLiteral("updateInterval");
+const QString c_tracksKey = QStringLiteral("tracks");
+const QString c_fileKey = QStringLiteral("file");
+const QString c_idKey = QStringLiteral("id");
+const QString c_typeKey = QStringLiteral("type");
+const QString c_symbolIdKey = QStringLiteral("symbolId");
+const QString c_cotTypeKey = QStringLiteral("cotType");
+const QString c_offsetKey = QStringLiteral("offset");
+const QString c_offsetStepKey = QStringLiteral("offsetStep");
+const QString c_speedKey = QStringLiteral("speed");
+const QString c_countKey = QStringLiteral("count");
+
+constexpr int c_defaultUpdateInterval = 100;
+constexpr double c_msecsPerSecond = 1000.0;
+} // namespace
+
+/*!
+  \class Dsa::TrackFeedSimulator
+  \inmodule Dsa
+  \inherits QObject
+  \brief Replays GPX tracks as dynamic entities straight into the message feeds.
+
+  Each track of the configuration becomes a separate entity of a MessageFeed, with
+  its own time offset into the track and its own speed multiplier. Messages are
+  built in memory and passed to MessageFeed::addMessage, so no message is
+  serialized, sent or parsed; the cost of each update is that of the feed, the
+  renderer and the alerts alone.
+
+  The configuration is a JSON file:
+
+  \code
+  {
+    "updateInterval": 100,
+    "tracks": [
+      { "file": "MontereyMounted.gpx", "id": "convoy", "type": "cot",
+        "cotType": "a-f-G-U-C", "count": 200, "offset": 0, "offsetStep": 15, "speed": 1.5 }
+    ]
+  }
+  \endcode
+
+  \list
+    \li \c file - The GPX file of the track, relative to the configuration file.
+    \li \c id - The message ID of the entity. Defaults to the name of the GPX file.
+    \li \c type - The message type of the feed the entity is added to, for example
+        \c cot or \c position_report.
+    \li \c symbolId - The symbol ID code of the entity.
+    \li \c cotType - The CoT type of the entity, used for the symbol ID code when
+        \c symbolId is not set.
+    \li \c offset - The time in seconds into the track at which the entity starts.
+    \li \c speed - The multiplier of the track's own speed. Defaults to 1.
+    \li \c count - The number of entities replaying the track. Each has the ID
+        \c{<id>-<n>}, and starts \c offsetStep seconds after the one before it.
+  \endlist
+
+  A GPX file is read once however many entities replay it, and each entity loops
+  back to the start of its track at the end. The cost of every tick is recorded;
+  see \l statistics.
+ */
+
+/*!
+  \brief Constructor taking the \a messageFeeds to add the entities to and an optional \a parent.
+ */
+TrackFeedSimulator::TrackFeedSimulator(MessageFeedListModel* messageFeeds, QObject* parent) :
+  QObject(parent),
+  m_messageFeeds(messageFeeds),
+  m_timer(new QTimer(this))
+{
+  m_timer->setInterval(c_defaultUpdateInterval);
+  connect(m_timer, &QTimer::timeout, this, &TrackFeedSimulator::handleTimerEvent);
+}
+
+/*!
+  \brief Destructor.
+ */
+TrackFeedSimulator::~TrackFeedSimulator()
+{
+}
+
+/*!
+  \brief Reads the tracks and update interval of the simulation from the JSON \a configFile.
+
+  Any entities of an earlier configuration are replaced, and the simulation is stopped.
+  Entries which cannot be used are reported by \l errorOccurred and skipped. Returns
+  \c false if no entity could be created.
+ */
+bool TrackFeedSimulator::loadConfiguration(const QString& configFile)
+{
+  stop();
+  m_entities.clear();
+  m_tracks.clear();
+
+  QFile file(configFile);
+  if (!file.open(QFile::ReadOnly))
+  {
+    emit errorOccurred(QStringLiteral("Failed to open track simulation"), QString("Could not read %1").arg(configFile));
+    return false;
+  }
+
+  QJsonParseError parseError;
+  const auto configuration = QJsonDocument::fromJson(file.readAll(), &parseError).object();
+  if (parseError.error != QJsonParseError::NoError)
+  {
+    emit errorOccurred(QStringLiteral("Invalid track simulation JSON"), QString("%1: %2").arg(configFile, parseError.errorString()));
+    return false;
+  }
+
+  setUpdateInterval(configuration.value(c_updateIntervalKey).toInt(c_defaultUpdateInterval));
+
+  const QString directory = QFileInfo(configFile).absolutePath();
+  const auto tracks = configuration.value(c_tracksKey).toVariant().toList();
+  for (const auto& track : tracks)
+    addEntities(track.toMap(), directory);
+
+  return !m_entities.empty();
+}
+
+/*!
+  \internal
+
+  Adds the entities of one entry of the \c tracks list, \a trackProperties, with the
+  GPX file relative to \a directory.
+ */
+bool TrackFeedSimulator::addEntities(const QVariantMap& trackProperties, const QString& directory)
+{
+  const QString fileName = QDir(directory).absoluteFilePath(trackProperties.value(c_fileKey).toString());
+
+  // entities of the same file share one read of its track
+  std::shared_ptr<const GpxTrack> track = m_tracks.value(fileName);
+  if (!track)
+  {
+    QFile gpxFile(fileName);
+    auto newTrack = std::make_shared<GpxTrack>();
+    if (!gpxFile.open(QFile::ReadOnly) || !newTrack->read(gpxFile.readAll()))
+    {
+      emit errorOccurred(QStringLiteral("Failed to read simulated track"), QString("%1 has no track to replay").arg(fileName));
+      return false;
+    }
+
+    track = std::move(newTrack);
+    m_tracks.insert(fileName, track);
+  }
+
+  const QString messageType = trackProperties.value(c_typeKey, QStringLiteral("cot")).toString();
+  QString symbolId = trackProperties.value(c_symbolIdKey).toString();
+  if (symbolId.isEmpty())
+    symbolId = Message::cotTypeToSidc(trackProperties.value(c_cotTypeKey).toString());
+
+  if (symbolId.isEmpty())
+  {
+    emit errorOccurred(QStringLiteral("Invalid simulated track"), QString("%1 has no symbol ID or CoT type").arg(fileName));
+    return false;
+  }
+
+  const QString id = trackProperties.value(c_idKey, QFileInfo(fileName).completeBaseName()).toString();
+  const double speed = trackProperties.value(c_speedKey, 1.0).toDouble();
+  const int count = std::max(trackProperties.value(c_countKey, 1).toInt(), 1);
+  const double offset = trackProperties.value(c_offsetKey).toDouble();
+  const double offsetStep = trackProperties.value(c_offsetStepKey).toDouble();
+
+  for (int i = 0; i < count; ++i)
+  {
+    Entity entity;
+    entity.track = track;
+    entity.speed = speed > 0.0 ? speed : 1.0;
+    entity.offset = static_cast<qint64>((offset + i * offsetStep) * c_msecsPerSecond);
+
+    const QString messageId = count == 1 ? id : QString("%1-%2").arg(id).arg(i + 1);
+
+    // the attributes match those of a message of the same type read from the network
+    QVariantMap attributes;
+    attributes.insert(Message::SIDC_NAME, symbolId);
+    if (messageType == QStringLiteral("cot"))
+    {
+      attributes.insert(Message::COT_UID_NAME, messageId);
+    }
+    else
+    {
+      attributes.insert(Message::GEOMESSAGE_ACTION_NAME, Message::fromMessageAction(Message::MessageAction::Update));
+      attributes.insert(Message::GEOMESSAGE_ID_NAME, messageId);
+      attributes.insert(Message::GEOMESSAGE_SIC_NAME, symbolId);
+      attributes.insert(Message::GEOMESSAGE_UNIQUE_DESIGNATION_NAME, messageId);
+    }
+
+    entity.message.setMessageAction(Message::MessageAction::Update);
+    entity.message.setMessageId(messageId);
+    entity.message.setMessageType(messageType);
+    entity.message.setSymbolId(symbolId);
+    entity.message.setAttributes(attributes);
+
+    m_entities.push_back(std::move(entity));
+  }
+
+  return true;
+}
+
+/*!
+  \brief Returns the number of entities of the simulation.
+ */
+int TrackFeedSimulator::entityCount() const
+{
+  return static_cast<int>(m_entities.size());
+}
+
+/*!
+  \brief Returns the time in milliseconds between updates of every entity.
+ */
+int TrackFeedSimulator::updateInterval() const
+{
+  return m_timer->interval();
+}
+
+/*!
+  \brief Sets the time in milliseconds between updates of every entity to \a msecs.
+ */
+void TrackFeedSimulator::setUpdateInterval(int msecs)
+{
+  m_timer->setInterval(std::max(msecs, 1));
+}
+
+/*!
+  \brief Returns whether the simulation is running.
+ */
+bool TrackFeedSimulator::isRunning() const
+{
+  return m_timer->isActive();
+}
+
+/*!
+  \brief Starts the simulation, with every entity at its offset into its track.
+
+  The feed of each entity is found by its message type; entities without a feed are
+  reported by \l errorOccurred and not updated.
+ */
+void TrackFeedSimulator::start()
+{
+  if (isRunning() || m_entities.empty() || !m_messageFeeds)
+    return;
+
+  for (auto& entity : m_entities)
+  {
+    entity.feed = m_messageFeeds->messageFeedByType(entity.message.messageType());
+    entity.segment = 0;
+    if (!entity.feed)
+      emit errorOccurred(QStringLiteral("Missing message feed"), QString("No feed of type %1 for simulated track %2").arg(entity.message.messageType(), entity.message.messageId()));
+  }
+
+  m_ticks = 0;
+  m_updates = 0;
+  m_rejectedUpdates = 0;
+  m_tickCost.clear();
+
+  m_clock.start();
+  m_timer->start();
+  handleTimerEvent();
+}
+
+/*!
+  \brief Stops the simulation.
+
+  The entities stay in their feeds at their last positions.
+ */
+void TrackFeedSimulator::stop()
+{
+  m_timer->stop();
+}
+
+/*!
+  \brief Returns the statistics of the current or last run.
+
+  The map holds the number of \c entities, \c ticks, \c updates and \c rejectedUpdates,
+  the \c seconds run, the \c updatesPerSecond, and the cost of each tick in
+  \c tickCost as returned by LatencyHistogram::toVariantMap.
+ */
+QVariantMap TrackFeedSimulator::statistics() const
+{
+  const double seconds = m_clock.isValid() ? m_clock.elapsed() / c_msecsPerSecond : 0.0;
+
+  QVariantMap result;
+  result.insert(QStringLiteral("entities"), entityCount());
+  result.insert(QStringLiteral("ticks"), m_ticks);
+  result.insert(QStringLiteral("updates"), m_updates);
+  result.insert(QStringLiteral("rejectedUpdates"), m_rejectedUpdates);
+  result.insert(QStringLiteral("seconds"), seconds);
+  result.insert(QStringLiteral("updatesPerSecond"), seconds > 0.0 ? m_updates / seconds : 0.0);
+  result.insert(QStringLiteral("tickCost"), m_tickCost.toVariantMap());
+
+  return result;
+}
+
+/*!
+  \internal
+
+  Moves every entity to its position at the current time and adds it to its feed.
+ */
+void TrackFeedSimulator::handleTimerEvent()
+{
+  QElapsedTimer tickTimer;
+  tickTimer.start();
+
+  const qint64 elapsed = m_clock.elapsed();
+  for (auto& entity : m_entities)
+  {
+    if (!entity.feed)
+      continue;
+
+    const GpxTrack& track = *entity.track;
+    const qint64 duration = track.duration();
+    if (duration <= 0)
+      continue;
+
+    // each entity loops over its own track, from its own offset and at its own speed
+    qint64 time = (entity.offset + static_cast<qint64>(elapsed * entity.speed)) % duration;
+    if (time < 0)
+      time += duration;
+
+    entity.segment = track.segmentIndex(time, entity.segment);
+    const GpxTrack::Position position = track.position(time, entity.segment);
+
+    Message message = entity.message;
+    message.setGeometry(Point(position.x, position.y, std::isnan(position.z) ? 0.0 : position.z, SpatialReference::wgs84()));
+
+    if (entity.feed->addMessage(message))
+      ++m_updates;
+    else
+      ++m_rejectedUpdates;
+  }
+
+  ++m_ticks;
+  m_tickCost.record(tickTimer.nsecsElapsed());
+}
+
+} // Dsa
+
+// Signal Documentation
+
+/*!
+  \fn void TrackFeedSimulator::errorOccurred(const QString& errorMessage, const QString& additionalMessage);
+
+  \brief Signal emitted when an error occurs.
+
+  An \a errorMessage and \a additionalMessage are passed through as parameters, describing
+  the error that occurred.
+ */
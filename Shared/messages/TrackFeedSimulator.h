@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef TRACKFEEDSIMULATOR_H
+#define TRACKFEEDSIMULATOR_H
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QVariantMap>
+
+// DSA headers
+#include "LatencyHistogram.h"
+#include "Message.h"
+
+// STL headers
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+namespace Dsa {
+
+class GpxTrack;
+class MessageFeed;
+class MessageFeedListModel;
+
+class TrackFeedSimulator : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit TrackFeedSimulator(MessageFeedListModel* messageFeeds, QObject* parent = nullptr);
+  ~TrackFeedSimulator() override;
+
+  bool loadConfiguration(const QString& configFile);
+
+  int entityCount() const;
+
+  int updateInterval() const;
+  void setUpdateInterval(int msecs);
+
+  bool isRunning() const;
+  void start();
+  void stop();
+
+  QVariantMap statistics() const;
+
+signals:
+  void errorOccurred(const QString& errorMessage, const QString& additionalMessage);
+
+private slots:
+  void handleTimerEvent();
+
+private:
+  // one track replayed as one dynamic entity
+  struct Entity
+  {
+    std::shared_ptr<const GpxTrack> track;
+    // the message is built once, and only its geometry changes on each update
+    Message message;
+    qint64 offset = 0;
+    double speed = 1.0;
+    MessageFeed* feed = nullptr;
+    // the index of the point which starts the segment of the last update
+    int segment = 0;
+  };
+
+  bool addEntities(const QVariantMap& trackProperties, const QString& directory);
+
+  MessageFeedListModel* m_messageFeeds = nullptr;
+  QTimer* m_timer = nullptr;
+  std::vector<Entity> m_entities;
+  QHash<QString, std::shared_ptr<const GpxTrack>> m_tracks;
+
+  QElapsedTimer m_clock;
+  qint64 m_ticks = 0;
+  qint64 m_updates = 0;
+  qint64 m_rejectedUpdates = 0;
+  LatencyHistogram m_tickCost;
+};
+
+} // Dsa
+
+#endif // TRACKFEEDSIMULATOR_H
@@ -35,8 +35,8 @@ DsaPanel {
 
     Connections {
         target: appRoot
-        function onMarkupLayerReceived(path, overlayVisible) {
-            toolController.createMarkupLayer(path, -1, overlayVisible);
+        function onMarkupLayerReceived(markupLayer, overlayVisible) {
+            toolController.addMarkupLayer(markupLayer, overlayVisible);
         }
     }
 
@@ -74,14 +74,14 @@ Item {
 
         onMarkupReceived: {
             markupDialog.title = "Markup Received";
-            markupDialog.path = filePath;
+            markupDialog.markupLayer = markupLayer;
             markupDialog.informativeText = "%1 has sent you a markup. Would you like to view it now?".arg(sharedBy)
             markupDialog.open();
         }
 
         onMarkupSent: {
             markupDialog.title = "Markup Shared";
-            markupDialog.path = filePath;
+            markupDialog.markupLayer = markupLayer;
             markupDialog.informativeText = "The shared markup has been added as an overlay. Would you like to view it now?";
             markupDialog.open();
         }
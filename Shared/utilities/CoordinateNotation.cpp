@@ -0,0 +1,509 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "CoordinateNotation.h"
+
+// DSA headers
+#include "Geodesy.h"
+
+// C++ API headers
+#include "Point.h"
+#include "SpatialReference.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+namespace
+{
+// WGS 84
+constexpr double c_semiMajorAxis = 6378137.0;
+constexpr double c_flattening = 1.0 / 298.257223563;
+
+// UTM
+constexpr double c_scaleFactor = 0.9996;
+constexpr double c_falseEasting = 500000.0;
+constexpr double c_falseNorthing = 10000000.0;
+
+// MGRS letters, without I and O
+constexpr char c_columnLetters[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+constexpr char c_rowLetters[] = "ABCDEFGHJKLMNPQRSTUV";
+constexpr char c_bandLetters[] = "CDEFGHJKLMNPQRSTUVWX";
+
+// the latitudes covered by UTM zones; the polar regions use UPS
+constexpr double c_minimumUtmLatitude = -80.0;
+constexpr double c_maximumUtmLatitude = 84.0;
+
+constexpr int c_maximumLatitudeLongitudePrecision = 8;
+constexpr int c_maximumGridPrecision = 5;
+
+constexpr qint64 c_powersOfTen[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+/*!
+  \internal
+
+  The constants of the transverse Mercator projection of the WGS 84 ellipsoid, as a
+  series in the third flattening to sixth order (Krüger, as given by Karney 2011),
+  which is accurate to well under a millimetre across a UTM zone.
+ */
+struct TransverseMercator
+{
+  TransverseMercator()
+  {
+    const double n = c_flattening / (2.0 - c_flattening);
+    const double n2 = n * n;
+    const double n3 = n2 * n;
+    const double n4 = n3 * n;
+    const double n5 = n4 * n;
+    const double n6 = n5 * n;
+
+    eccentricity = std::sqrt(c_flattening * (2.0 - c_flattening));
+    rectifyingRadius = c_semiMajorAxis / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0);
+
+    alpha[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0 - 127.0 * n5 / 288.0 + 7891.0 * n6 / 37800.0;
+    alpha[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0 + 281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0;
+    alpha[2] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 + 15061.0 * n5 / 26880.0 + 167603.0 * n6 / 181440.0;
+    alpha[3] = 49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 + 6601661.0 * n6 / 7257600.0;
+    alpha[4] = 34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0;
+    alpha[5] = 212378941.0 * n6 / 319334400.0;
+  }
+
+  double eccentricity = 0.0;
+  double rectifyingRadius = 0.0;
+  double alpha[6] = {};
+};
+
+const TransverseMercator& transverseMercator()
+{
+  static const TransverseMercator s_transverseMercator;
+  return s_transverseMercator;
+}
+
+/*!
+  \internal
+
+  Returns the UTM zone of a point, including the exceptions for south west Norway and
+  Svalbard.
+ */
+int utmZone(double longitude, double latitude)
+{
+  int zone = static_cast<int>(std::floor((longitude + 180.0) / 6.0)) + 1;
+  if (zone > 60)
+    zone = 1;
+
+  if (latitude >= 56.0 && latitude < 64.0 && longitude >= 3.0 && longitude < 12.0)
+    return 32;
+
+  if (latitude >= 72.0 && latitude < 84.0 && longitude >= 0.0 && longitude < 42.0)
+  {
+    if (longitude < 9.0)
+      return 31;
+    if (longitude < 21.0)
+      return 33;
+    if (longitude < 33.0)
+      return 35;
+    return 37;
+  }
+
+  return zone;
+}
+
+/*!
+  \internal
+
+  Projects a point to its UTM \a zone, and returns the \a easting and \a northing in
+  metres, with the false northing added in the southern hemisphere. Returns \c false for
+  the polar regions, which are not covered by UTM.
+ */
+bool toUtm(double longitude, double latitude, int& zone, double& easting, double& northing)
+{
+  if (!(latitude >= c_minimumUtmLatitude && latitude < c_maximumUtmLatitude))
+    return false;
+
+  const TransverseMercator& tm = transverseMercator();
+
+  zone = utmZone(longitude, latitude);
+  double lambda = longitude - (zone * 6.0 - 183.0);
+  if (lambda < -180.0)
+    lambda += 360.0;
+  else if (lambda >= 180.0)
+    lambda -= 360.0;
+  lambda = Geodesy::toRadians(lambda);
+
+  // the conformal latitude, as its tangent
+  const double tau = std::tan(Geodesy::toRadians(latitude));
+  const double sigma = std::sinh(tm.eccentricity * std::atanh(tm.eccentricity * tau / std::sqrt(1.0 + tau * tau)));
+  const double conformalTau = tau * std::sqrt(1.0 + sigma * sigma) - sigma * std::sqrt(1.0 + tau * tau);
+
+  const double cosLambda = std::cos(lambda);
+  const double xiPrime = std::atan2(conformalTau, cosLambda);
+  const double etaPrime = std::asinh(std::sin(lambda) / std::sqrt(conformalTau * conformalTau + cosLambda * cosLambda));
+
+  double xi = xiPrime;
+  double eta = etaPrime;
+  for (int j = 1; j <= 6; ++j)
+  {
+    xi += tm.alpha[j - 1] * std::sin(2.0 * j * xiPrime) * std::cosh(2.0 * j * etaPrime);
+    eta += tm.alpha[j - 1] * std::cos(2.0 * j * xiPrime) * std::sinh(2.0 * j * etaPrime);
+  }
+
+  easting = c_falseEasting + c_scaleFactor * tm.rectifyingRadius * eta;
+  northing = c_scaleFactor * tm.rectifyingRadius * xi;
+  if (latitude < 0.0)
+    northing += c_falseNorthing;
+
+  return true;
+}
+
+/*!
+  \internal
+
+  Writes \a value in decimal, padded with zeros to \a minimumDigits, and returns the
+  end of the text.
+ */
+char* writeUnsigned(char* out, quint64 value, int minimumDigits = 1)
+{
+  char digits[20];
+  int count = 0;
+  do
+  {
+    digits[count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  while (value > 0);
+
+  for (int i = count; i < minimumDigits; ++i)
+    *out++ = '0';
+
+  while (count > 0)
+    *out++ = digits[--count];
+
+  return out;
+}
+
+/*!
+  \internal
+
+  Writes \a value, scaled by 10 to the \a decimals, as a whole part padded to
+  \a integerDigits and a fraction of \a decimals digits.
+ */
+char* writeFixed(char* out, quint64 value, int decimals, int integerDigits)
+{
+  const quint64 scale = static_cast<quint64>(c_powersOfTen[decimals]);
+  out = writeUnsigned(out, value / scale, integerDigits);
+  if (decimals > 0)
+  {
+    *out++ = '.';
+    out = writeUnsigned(out, value % scale, decimals);
+  }
+
+  return out;
+}
+
+/*!
+  \internal
+
+  Writes one angle of a latitude and longitude in the \a notation, followed by its
+  hemisphere letter.
+ */
+char* writeAngle(char* out, double angle, CoordinateNotation::Notation notation, int precision, char positive, char negative)
+{
+  const char hemisphere = angle < 0.0 ? negative : positive;
+  const double magnitude = std::fabs(angle);
+  const qint64 scale = c_powersOfTen[precision];
+
+  // the angle is rounded once in its smallest unit, so a carry reaches the degrees
+  switch (notation)
+  {
+  case CoordinateNotation::Notation::DegreesDecimalMinutes:
+  {
+    const quint64 minutes = static_cast<quint64>(std::llround(magnitude * 60.0 * scale));
+    out = writeUnsigned(out, minutes / (60 * scale));
+    *out++ = ' ';
+    out = writeFixed(out, minutes % (60 * scale), precision, 2);
+    break;
+  }
+  case CoordinateNotation::Notation::DegreesMinutesSeconds:
+  {
+    const quint64 seconds = static_cast<quint64>(std::llround(magnitude * 3600.0 * scale));
+    out = writeUnsigned(out, seconds / (3600 * scale));
+    *out++ = ' ';
+    out = writeUnsigned(out, seconds % (3600 * scale) / (60 * scale), 2);
+    *out++ = ' ';
+    out = writeFixed(out, seconds % (60 * scale), precision, 2);
+    break;
+  }
+  default:
+    out = writeFixed(out, static_cast<quint64>(std::llround(magnitude * scale)), precision, 1);
+    break;
+  }
+
+  *out++ = hemisphere;
+  return out;
+}
+} // namespace
+
+/*!
+  \class Dsa::CoordinateNotation
+  \inmodule Dsa
+  \brief Formats WGS 84 coordinates as text, without calling into the runtime or
+  allocating memory.
+
+  The notations and their text are those of CoordinateFormatter, with the options
+  used for the location readout:
+  \list
+    \li DecimalDegrees, DegreesDecimalMinutes and DegreesMinutesSeconds - as
+        CoordinateFormatter::toLatitudeLongitude, with \l precision decimal places.
+    \li Utm - as CoordinateFormatter::toUtm with north and south indicators and spaces.
+    \li Mgrs - as CoordinateFormatter::toMgrs in automatic mode with \l precision
+        digits and spaces.
+    \li Usng - as CoordinateFormatter::toUsng with \l precision digits and spaces.
+  \endlist
+
+  The UTM based notations cover the latitudes of UTM zones, 80 degrees south to 84
+  degrees north. Points in the polar regions, and points which are not WGS 84, are
+  not formatted; callers fall back to CoordinateFormatter for them.
+
+  The \c tests/coordinatenotation target compares the text with CoordinateFormatter's.
+ */
+
+/*!
+  \enum CoordinateNotation::Notation
+
+  \value DecimalDegrees Decimal degrees, e.g. \c{34.05722N 117.19611W}.
+  \value DegreesDecimalMinutes Degrees and decimal minutes.
+  \value DegreesMinutesSeconds Degrees, minutes and decimal seconds.
+  \value Utm Universal Transverse Mercator.
+  \value Mgrs Military Grid Reference System.
+  \value Usng United States National Grid.
+ */
+
+/*!
+  \brief Constructor for the \a notation with \a precision decimal places, or digits of
+  easting and northing for MGRS and USNG.
+ */
+CoordinateNotation::CoordinateNotation(Notation notation, int precision) :
+  m_notation(notation),
+  m_precision(std::clamp(precision, 0, notation == Notation::Mgrs || notation == Notation::Usng ? c_maximumGridPrecision
+                                                                                                : c_maximumLatitudeLongitudePrecision))
+{
+}
+
+/*!
+  \brief Returns the notation.
+ */
+CoordinateNotation::Notation CoordinateNotation::notation() const
+{
+  return m_notation;
+}
+
+/*!
+  \brief Returns the number of decimal places, or digits of easting and northing for MGRS and USNG.
+ */
+int CoordinateNotation::precision() const
+{
+  return m_precision;
+}
+
+/*!
+  \brief Writes the text of the point at \a longitude and \a latitude to \a buffer,
+  which must hold at least \l MaximumLength characters.
+
+  Returns the length of the text, or 0 if the point cannot be formatted natively. The
+  text is not null terminated.
+ */
+int CoordinateNotation::format(double longitude, double latitude, char* buffer) const
+{
+  if (!std::isfinite(longitude) || !(latitude >= -90.0 && latitude <= 90.0))
+    return 0;
+
+  // longitudes are wrapped into -180 to 180
+  if (longitude < -180.0 || longitude >= 180.0)
+    longitude -= 360.0 * std::floor((longitude + 180.0) / 360.0);
+
+  switch (m_notation)
+  {
+  case Notation::Utm:
+    return formatUtm(longitude, latitude, buffer);
+  case Notation::Mgrs:
+  case Notation::Usng:
+    return formatMgrs(longitude, latitude, buffer);
+  default:
+    return formatLatitudeLongitude(longitude, latitude, buffer);
+  }
+}
+
+/*!
+  \brief Formats \a count points at once.
+
+  \a coordinates holds the longitude and latitude of each point in turn. The text of
+  point \c i is written to \c{buffer + i * stride}, and its length to \c{lengths[i]};
+  a length of 0 marks a point which could not be formatted natively. \a stride must be
+  at least \l MaximumLength.
+
+  Returns the number of points formatted.
+ */
+int CoordinateNotation::format(const double* coordinates, int count, char* buffer, int stride, int* lengths) const
+{
+  if (stride < MaximumLength)
+    return 0;
+
+  int formatted = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    lengths[i] = format(coordinates[2 * i], coordinates[2 * i + 1], buffer + static_cast<qsizetype>(i) * stride);
+    if (lengths[i] > 0)
+      ++formatted;
+  }
+
+  return formatted;
+}
+
+/*!
+  \brief Returns the text of \a point, or an empty string if it cannot be formatted natively.
+ */
+QString CoordinateNotation::toString(const Point& point) const
+{
+  char buffer[MaximumLength];
+  const int length = point.spatialReference() == SpatialReference::wgs84() ? format(point.x(), point.y(), buffer) : 0;
+  return QString::fromLatin1(buffer, length);
+}
+
+/*!
+  \brief Returns the text of each of \a points.
+
+  The points are formatted in one batch. The text of any which cannot be formatted
+  natively is empty.
+ */
+QStringList CoordinateNotation::toStrings(const QList<Point>& points) const
+{
+  const SpatialReference wgs84 = SpatialReference::wgs84();
+
+  std::vector<double> coordinates;
+  coordinates.reserve(2 * points.size());
+  for (const auto& point : points)
+  {
+    // other spatial references get a NaN, which is never formatted natively
+    const bool isWgs84 = point.spatialReference() == wgs84;
+    coordinates.push_back(isWgs84 ? point.x() : NAN);
+    coordinates.push_back(isWgs84 ? point.y() : NAN);
+  }
+
+  const int count = static_cast<int>(points.size());
+  std::vector<char> buffer(static_cast<size_t>(count) * MaximumLength);
+  std::vector<int> lengths(count);
+  format(coordinates.data(), count, buffer.data(), MaximumLength, lengths.data());
+
+  QStringList result;
+  result.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    result.append(QString::fromLatin1(buffer.data() + static_cast<size_t>(i) * MaximumLength, lengths[i]));
+  }
+
+  return result;
+}
+
+/*!
+  \internal
+ */
+int CoordinateNotation::formatLatitudeLongitude(double longitude, double latitude, char* buffer) const
+{
+  char* out = writeAngle(buffer, latitude, m_notation, m_precision, 'N', 'S');
+  *out++ = ' ';
+  out = writeAngle(out, longitude, m_notation, m_precision, 'E', 'W');
+
+  return static_cast<int>(out - buffer);
+}
+
+/*!
+  \internal
+ */
+int CoordinateNotation::formatUtm(double longitude, double latitude, char* buffer) const
+{
+  int zone = 0;
+  double easting = 0.0;
+  double northing = 0.0;
+  if (!toUtm(longitude, latitude, zone, easting, northing))
+    return 0;
+
+  char* out = writeUnsigned(buffer, zone);
+  *out++ = latitude < 0.0 ? 'S' : 'N';
+  *out++ = ' ';
+  out = writeUnsigned(out, static_cast<quint64>(std::llround(easting)), 6);
+  *out++ = ' ';
+  out = writeUnsigned(out, static_cast<quint64>(std::llround(northing)), 7);
+
+  return static_cast<int>(out - buffer);
+}
+
+/*!
+  \internal
+
+  Formats MGRS, which for WGS 84 is also the text of USNG.
+ */
+int CoordinateNotation::formatMgrs(double longitude, double latitude, char* buffer) const
+{
+  int zone = 0;
+  double easting = 0.0;
+  double northing = 0.0;
+  if (!toUtm(longitude, latitude, zone, easting, northing))
+    return 0;
+
+  // grid references are truncated, not rounded, so a reference always names the square containing the point
+  const auto eastingMetres = static_cast<qint64>(std::floor(easting));
+  const auto northingMetres = static_cast<qint64>(std::floor(northing));
+
+  const int band = std::min(static_cast<int>(std::floor((latitude - c_minimumUtmLatitude) / 8.0)), 19);
+
+  // the 100 km column letters repeat every three zones, and the row letters of even zones are offset by five
+  const int column = static_cast<int>(eastingMetres / 100000);
+  if (column < 1 || column > 8)
+    return 0;
+
+  const int row = static_cast<int>(northingMetres / 100000 % 20);
+  const int columnSet = (zone - 1) % 3;
+  const char columnLetter = c_columnLetters[columnSet * 8 + column - 1];
+  const char rowLetter = c_rowLetters[(row + (zone % 2 == 0 ? 5 : 0)) % 20];
+
+  const qint64 divisor = c_powersOfTen[c_maximumGridPrecision - m_precision];
+
+  char* out = writeUnsigned(buffer, zone);
+  *out++ = c_bandLetters[band];
+  *out++ = ' ';
+  *out++ = columnLetter;
+  *out++ = rowLetter;
+  if (m_precision > 0)
+  {
+    *out++ = ' ';
+    out = writeUnsigned(out, static_cast<quint64>(eastingMetres % 100000 / divisor), m_precision);
+    *out++ = ' ';
+    out = writeUnsigned(out, static_cast<quint64>(northingMetres % 100000 / divisor), m_precision);
+  }
+
+  return static_cast<int>(out - buffer);
+}
+
+} // Dsa
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef COORDINATENOTATION_H
+#define COORDINATENOTATION_H
+
+// Qt headers
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace Esri::ArcGISRuntime {
+  class Point;
+}
+
+namespace Dsa {
+
+class CoordinateNotation
+{
+public:
+  enum class Notation
+  {
+    DecimalDegrees = 0,
+    DegreesDecimalMinutes,
+    DegreesMinutesSeconds,
+    Utm,
+    Mgrs,
+    Usng
+  };
+
+  // the longest text of any notation, without a terminating null
+  static constexpr int MaximumLength = 48;
+
+  CoordinateNotation(Notation notation, int precision);
+
+  Notation notation() const;
+  int precision() const;
+
+  int format(double longitude, double latitude, char* buffer) const;
+  int format(const double* coordinates, int count, char* buffer, int stride, int* lengths) const;
+
+  QString toString(const Esri::ArcGISRuntime::Point& point) const;
+  QStringList toStrings(const QList<Esri::ArcGISRuntime::Point>& points) const;
+
+private:
+  int formatLatitudeLongitude(double longitude, double latitude, char* buffer) const;
+  int formatUtm(double longitude, double latitude, char* buffer) const;
+  int formatMgrs(double longitude, double latitude, char* buffer) const;
+
+  Notation m_notation;
+  int m_precision;
+};
+
+} // Dsa
+
+#endif // COORDINATENOTATION_H
@@ -19,6 +19,9 @@
 
 #include "DataListener.h"
 
+// DSA headers
+#include "NetworkService.h"
+
 // Qt headers
 #include <QUdpSocket>
 
@@ -29,6 +32,10 @@ namespace Dsa {
   \inmodule Dsa
   \inherits QObject
   \brief Utility class for listening on a UDP socket.
+
+  The listener either reads from a QIODevice it is given, or subscribes to a UDP
+  port of the shared NetworkService, which receives the datagrams off the GUI
+  thread and delivers them in batches.
  */
 
 /*!
@@ -55,14 +62,18 @@ DataListener::DataListener(QIODevice* device, QObject *parent) :
 DataListener::~DataListener()
 {
   disconnectDevice();
+  setUdpPort(0);
 }
 
 /*!
   \brief Sets the QIODevice to \a device.
+
+  Any subscription to a UDP port of the network service is removed.
  */
 void DataListener::setDevice(QIODevice* device)
 {
   disconnectDevice();
+  setUdpPort(0);
 
   m_device = device;
   connectDevice();
@@ -76,6 +87,46 @@ QIODevice* DataListener::device() const
   return m_device.data();
 }
 
+/*!
+  \brief Listens for datagrams on UDP \a port through the network service.
+
+  Any QIODevice previously set is released. A \a port of \c 0 removes the subscription.
+
+  \sa NetworkService
+ */
+void DataListener::setUdpPort(quint16 port)
+{
+  if (m_udpPort == port)
+    return;
+
+  if (port != 0)
+  {
+    disconnectDevice();
+    m_device.clear();
+  }
+
+  if (m_udpPort != 0)
+    NetworkService::instance()->unsubscribe(m_udpPort, this);
+
+  m_udpPort = port;
+
+  if (m_udpPort != 0)
+  {
+    NetworkService::instance()->subscribe(m_udpPort, this, [this](const QList<QByteArray>& datagrams)
+    {
+      processDatagrams(datagrams);
+    });
+  }
+}
+
+/*!
+  \brief Returns the UDP port listened on through the network service, or \c 0 if there is none.
+ */
+quint16 DataListener::udpPort() const
+{
+  return m_udpPort;
+}
+
 /*!
   \brief Returns whether the data listener is enabled.
  */
@@ -159,6 +210,18 @@ bool DataListener::processUdpDatagrams()
   return false;
 }
 
+/*!
+  \internal
+ */
+void DataListener::processDatagrams(const QList<QByteArray>& datagrams)
+{
+  if (!m_enabled)
+    return;
+
+  for (const QByteArray& datagram : datagrams)
+    emit dataReceived(datagram);
+}
+
 } // Dsa
 
 // Signal Documentation
@@ -36,6 +36,9 @@ public:
   void setDevice(QIODevice* device);
   QIODevice* device() const;
 
+  void setUdpPort(quint16 port);
+  quint16 udpPort() const;
+
   bool isEnabled() const;
   void setEnabled(bool enabled);
 
@@ -49,9 +52,11 @@ private:
   void disconnectDevice();
 
   bool processUdpDatagrams();
+  void processDatagrams(const QList<QByteArray>& datagrams);
 
   QPointer<QIODevice> m_device;
   QMetaObject::Connection m_deviceConn;
+  quint16 m_udpPort = 0;
 
   bool m_enabled = true;
 };
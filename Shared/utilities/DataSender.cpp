@@ -16,16 +16,41 @@
 
 #include "DataSender.h"
 
+// DSA headers
+#include "NetworkService.h"
+
 // Qt headers
 #include <QUdpSocket>
 
+// STL headers
+#include <algorithm>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
 namespace Dsa {
 
+namespace
+{
+// the most datagrams handed to the kernel in one call
+constexpr int c_maxBatchSize = 64;
+
+// multicast stays on the local network unless routed further
+constexpr int c_multicastTtl = 1;
+} // namespace
+
 /*!
   \class Dsa::DataSender
   \inmodule Dsa
   \inherits QObject
   \brief Utility class for sending information over a UDP socket.
+
+  Data is either written to a QIODevice, or, when a UDP target is set, queued on
+  the shared NetworkService which sends it from its own thread.
  */
 
 /*!
@@ -52,32 +77,242 @@ DataSender::~DataSender()
 {
 }
 
+/*!
+  \brief Sets the QIODevice to \a device.
+
+  Any UDP target is cleared.
+ */
 void DataSender::setDevice(QIODevice* device)
 {
   m_device = device;
+  m_udpAddress.clear();
+  m_udpPort = 0;
 }
 
 /*!
-  \brief Sets the QIODevice to \a device.
+  \brief Returns the current QIODevice.
  */
 QIODevice* DataSender::device() const
 {
   return m_device.data();
 }
 
+/*!
+  \brief Sends data to UDP \a address and \a port through the network service.
+
+  Any QIODevice previously set is released. The data is queued and written by
+  the service thread, so sendData does not wait for the socket.
+
+  \sa NetworkService
+ */
+void DataSender::setUdpTarget(const QHostAddress& address, quint16 port)
+{
+  m_device.clear();
+  m_udpAddress = address;
+  m_udpPort = port;
+}
+
+/*!
+  \brief Returns the UDP address sent to through the network service.
+ */
+QHostAddress DataSender::udpAddress() const
+{
+  return m_udpAddress;
+}
+
+/*!
+  \brief Returns the UDP port sent to through the network service, or \c 0 if there is no UDP target.
+ */
+quint16 DataSender::udpPort() const
+{
+  return m_udpPort;
+}
+
 /*!
   \brief Sends the QByteArray \a data with the current QIODevice.
+
+  Returns the number of bytes written, or -1 if the data could not be sent. With a
+  UDP target, returns the number of bytes queued on the network service.
  */
 qint64 DataSender::sendData(const QByteArray& data)
 {
+  if (m_udpPort != 0)
+  {
+    if (!NetworkService::instance()->send(m_udpAddress, m_udpPort, data))
+    {
+      m_sendFailures++;
+      return -1;
+    }
+
+    emit dataSent(data);
+
+    return data.size();
+  }
+
+  if (!m_device)
+  {
+    m_sendFailures++;
+    return -1;
+  }
+
   // write the bytes to be sent to the device
   qint64 bytesWritten = m_device->write(data);
-  if (bytesWritten != -1)
-    emit dataSent(data);
+  if (bytesWritten == -1)
+  {
+    m_sendFailures++;
+    return bytesWritten;
+  }
+
+  if (bytesWritten < data.size())
+    m_partialSends++;
+
+  emit dataSent(data);
 
   return bytesWritten;
 }
 
+/*!
+  \brief Sends each QByteArray in \a data as a separate datagram and returns how many were sent.
+
+  On Linux, when the device is a connected UDP socket, the datagrams are handed to the
+  kernel in batches with \c sendmmsg rather than with one system call each. Elsewhere
+  they are sent one at a time with sendData. If \a bytesSent is given it is set to the
+  number of bytes sent. Datagrams which could not be sent are counted in sendFailures;
+  if the socket's send buffer is full the rest of the batch is not attempted.
+ */
+int DataSender::sendBatch(const QList<QByteArray>& data, qint64* bytesSent)
+{
+  int datagramsSent = 0;
+  qint64 totalBytes = 0;
+
+#ifdef Q_OS_LINUX
+  QUdpSocket* udpSocket = qobject_cast<QUdpSocket*>(m_device.data());
+  const qintptr descriptor = udpSocket && udpSocket->state() == QAbstractSocket::ConnectedState ? udpSocket->socketDescriptor() : -1;
+  if (descriptor != -1)
+  {
+    const int batchSize = std::min(static_cast<int>(data.size()), c_maxBatchSize);
+    std::vector<mmsghdr> headers(batchSize);
+    std::vector<iovec> buffers(batchSize);
+
+    int offset = 0;
+    while (offset < data.size())
+    {
+      const int count = std::min(static_cast<int>(data.size()) - offset, c_maxBatchSize);
+      for (int i = 0; i < count; ++i)
+      {
+        const QByteArray& datagram = data.at(offset + i);
+        buffers[i].iov_base = const_cast<char*>(datagram.constData());
+        buffers[i].iov_len = static_cast<size_t>(datagram.size());
+        headers[i] = mmsghdr();
+        headers[i].msg_hdr.msg_iov = &buffers[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      const int result = ::sendmmsg(static_cast<int>(descriptor), headers.data(), static_cast<unsigned int>(count), 0);
+      if (result < 0)
+      {
+        if (errno == EINTR)
+          continue;
+
+        // a full send buffer rejects the rest of the batch as well
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        {
+          m_sendFailures += data.size() - offset;
+          break;
+        }
+
+        // otherwise only the first datagram failed, for example because it is too large
+        m_sendFailures++;
+        offset++;
+        continue;
+      }
+
+      for (int i = 0; i < result; ++i)
+      {
+        if (headers[i].msg_len < buffers[i].iov_len)
+          m_partialSends++;
+
+        totalBytes += headers[i].msg_len;
+        emit dataSent(data.at(offset + i));
+      }
+
+      datagramsSent += result;
+      offset += result;
+    }
+
+    if (bytesSent)
+      *bytesSent = totalBytes;
+
+    return datagramsSent;
+  }
+#endif
+
+  for (const QByteArray& datagram : data)
+  {
+    const qint64 bytesWritten = sendData(datagram);
+    if (bytesWritten == -1)
+      continue;
+
+    datagramsSent++;
+    totalBytes += bytesWritten;
+  }
+
+  if (bytesSent)
+    *bytesSent = totalBytes;
+
+  return datagramsSent;
+}
+
+/*!
+  \brief Returns the number of datagrams which could not be sent since the counters were last reset.
+ */
+qint64 DataSender::sendFailures() const
+{
+  return m_sendFailures;
+}
+
+/*!
+  \brief Returns the number of datagrams of which only part was sent since the counters were last reset.
+ */
+qint64 DataSender::partialSends() const
+{
+  return m_partialSends;
+}
+
+/*!
+  \brief Resets the failed and partial send counters to zero.
+ */
+void DataSender::resetCounters()
+{
+  m_sendFailures = 0;
+  m_partialSends = 0;
+}
+
+/*!
+  \brief Returns a new UDP socket which sends to \a address and \a port, with an optional \a parent.
+
+  \a address may be a unicast, multicast or broadcast address. Multicast datagrams are
+  also delivered to listeners on this machine. A \a sendBufferSize greater than zero
+  sets the size in bytes of the socket's send buffer, which allows longer bursts to be
+  queued before sends fail.
+ */
+QUdpSocket* DataSender::createUdpSocket(const QHostAddress& address, quint16 port, int sendBufferSize, QObject* parent)
+{
+  QUdpSocket* udpSocket = new QUdpSocket(parent);
+  udpSocket->connectToHost(address, port, QIODevice::WriteOnly);
+
+  if (address.isMulticast())
+  {
+    udpSocket->setSocketOption(QAbstractSocket::MulticastTtlOption, c_multicastTtl);
+    udpSocket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+  }
+
+  if (sendBufferSize > 0)
+    udpSocket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, sendBufferSize);
+
+  return udpSocket;
+}
+
 } // Dsa
 
 // Signal Documentation
@@ -18,10 +18,13 @@
 #define DATASENDER_H
 
 // Qt headers
+#include <QHostAddress>
+#include <QList>
 #include <QObject>
 #include <QPointer>
 
 class QIODevice;
+class QUdpSocket;
 
 namespace Dsa {
 
@@ -37,7 +40,18 @@ public:
   void setDevice(QIODevice* device);
   QIODevice* device() const;
 
+  void setUdpTarget(const QHostAddress& address, quint16 port);
+  QHostAddress udpAddress() const;
+  quint16 udpPort() const;
+
   qint64 sendData(const QByteArray& data);
+  int sendBatch(const QList<QByteArray>& data, qint64* bytesSent = nullptr);
+
+  qint64 sendFailures() const;
+  qint64 partialSends() const;
+  void resetCounters();
+
+  static QUdpSocket* createUdpSocket(const QHostAddress& address, quint16 port, int sendBufferSize = 0, QObject* parent = nullptr);
 
 signals:
   void dataSent(const QByteArray& data);
@@ -46,6 +60,10 @@ private:
   Q_DISABLE_COPY(DataSender)
 
   QPointer<QIODevice> m_device;
+  QHostAddress m_udpAddress;
+  quint16 m_udpPort = 0;
+  qint64 m_sendFailures = 0;
+  qint64 m_partialSends = 0;
 };
 
 } // Dsa
@@ -0,0 +1,289 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "ElevationCache.h"
+
+// DSA headers
+#include "Geodesy.h"
+
+// C++ API headers
+#include "ElevationSourceListModel.h"
+#include "Point.h"
+#include "SpatialReference.h"
+#include "Surface.h"
+
+// Qt headers
+#include <QFuture>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+namespace
+{
+// metres per degree of latitude, near enough for sizing cells
+constexpr double c_metersPerDegree = Geodesy::toRadians(Geodesy::EarthRadius);
+
+constexpr int c_defaultCapacity = 4096;
+} // namespace
+
+/*!
+  \class Dsa::ElevationCache
+  \inmodule Dsa
+  \inherits QObject
+  \brief A least recently used cache of surface elevations, keyed by location
+  quantized to cells of a given \l resolution.
+
+  A location in a cell which has been queried before is answered at once from the
+  cache. A location in a cell whose query has not yet returned waits for that
+  query, so at most one query per cell is ever in flight. Otherwise the surface is
+  queried at the location itself, and the answer is kept for the whole cell.
+
+  The cache is cleared when the surface or its elevation sources change.
+ */
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+ElevationCache::ElevationCache(QObject* parent) :
+  QObject(parent),
+  m_elevations(c_defaultCapacity)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+ElevationCache::~ElevationCache()
+{
+}
+
+/*!
+  \brief Returns the size in metres of the cells which share one elevation.
+ */
+double ElevationCache::resolution() const
+{
+  return m_resolution;
+}
+
+/*!
+  \brief Sets the size in metres of the cells which share one elevation to \a meters,
+  and clears the cache.
+
+  The default is 5 metres.
+ */
+void ElevationCache::setResolution(double meters)
+{
+  if (meters <= 0.0 || meters == m_resolution)
+    return;
+
+  m_resolution = meters;
+  clear();
+}
+
+/*!
+  \brief Returns the number of cells kept in the cache.
+ */
+int ElevationCache::capacity() const
+{
+  return static_cast<int>(m_elevations.maxCost());
+}
+
+/*!
+  \brief Sets the number of cells kept in the cache to \a cells.
+
+  The least recently used cells are dropped first.
+ */
+void ElevationCache::setCapacity(int cells)
+{
+  m_elevations.setMaxCost(std::max(cells, 1));
+}
+
+/*!
+  \brief Calls \a callback with the elevation of \a surface at \a point.
+
+  The \a callback is called before this returns when the elevation of the cell is
+  cached, and otherwise once the surface has answered. It is not called if the query
+  fails.
+ */
+void ElevationCache::requestElevation(Surface* surface, const Point& point, std::function<void(double)> callback)
+{
+  if (!surface || !callback)
+    return;
+
+  setSurface(surface);
+
+  const quint64 key = cellKey(point);
+  if (const double* elevation = m_elevations.object(key))
+  {
+    ++m_hits;
+    callback(*elevation);
+    return;
+  }
+
+  auto pendingIt = m_pendingRequests.find(key);
+  if (pendingIt != m_pendingRequests.end())
+  {
+    ++m_coalescedRequests;
+    pendingIt.value().append(std::move(callback));
+    return;
+  }
+
+  ++m_misses;
+  m_pendingRequests.insert(key, {std::move(callback)});
+
+  const quint64 generation = m_generation;
+  surface->elevationAsync(point).then(this, [this, key, generation](double elevation)
+  {
+    // a cleared cache has dropped its waiting callbacks as well
+    if (generation != m_generation)
+      return;
+
+    m_elevations.insert(key, new double(elevation));
+
+    const auto callbacks = m_pendingRequests.take(key);
+    for (const auto& callback : callbacks)
+      callback(elevation);
+  }).onFailed(this, [this, key, generation]
+  {
+    dropPendingRequests(key, generation);
+  }).onCanceled(this, [this, key, generation]
+  {
+    dropPendingRequests(key, generation);
+  });
+}
+
+/*!
+  \brief Drops every cached elevation, and every request waiting for a query.
+ */
+void ElevationCache::clear()
+{
+  ++m_generation;
+  m_elevations.clear();
+  m_pendingRequests.clear();
+}
+
+/*!
+  \brief Returns the number of requests answered from the cache.
+ */
+qint64 ElevationCache::hits() const
+{
+  return m_hits;
+}
+
+/*!
+  \brief Returns the number of requests which queried the surface.
+ */
+qint64 ElevationCache::misses() const
+{
+  return m_misses;
+}
+
+/*!
+  \brief Returns the number of requests which waited for a query already in flight.
+ */
+qint64 ElevationCache::coalescedRequests() const
+{
+  return m_coalescedRequests;
+}
+
+/*!
+  \brief Returns the counters of the cache, with its size and settings.
+ */
+QVariantMap ElevationCache::statistics() const
+{
+  QVariantMap result;
+  result.insert(QStringLiteral("hits"), m_hits);
+  result.insert(QStringLiteral("misses"), m_misses);
+  result.insert(QStringLiteral("coalescedRequests"), m_coalescedRequests);
+  result.insert(QStringLiteral("cells"), static_cast<int>(m_elevations.size()));
+  result.insert(QStringLiteral("capacity"), capacity());
+  result.insert(QStringLiteral("resolution"), m_resolution);
+
+  return result;
+}
+
+/*!
+  \internal
+
+  Returns the key of the cell containing \a point. Geographic points are quantized to
+  cells of about \l resolution metres a side; projected points to cells of \l resolution
+  map units.
+ */
+quint64 ElevationCache::cellKey(const Point& point) const
+{
+  double rowSize = m_resolution;
+  double columnSize = m_resolution;
+  if (point.spatialReference().isGeographic())
+  {
+    // columns narrow towards the poles, so a cell is about as wide as it is high
+    rowSize = m_resolution / c_metersPerDegree;
+    const double row = std::floor(point.y() / rowSize);
+    const double latitude = std::clamp((row + 0.5) * rowSize, -89.0, 89.0);
+    columnSize = rowSize / std::cos(Geodesy::toRadians(latitude));
+  }
+
+  const auto row = static_cast<qint32>(std::floor(point.y() / rowSize));
+  const auto column = static_cast<qint32>(std::floor(point.x() / columnSize));
+
+  return (static_cast<quint64>(static_cast<quint32>(row)) << 32) | static_cast<quint32>(column);
+}
+
+/*!
+  \internal
+
+  Drops the callbacks waiting for the query of the cell with \a key when the query
+  failed or was canceled, so the next request for the cell queries the surface again.
+  Nothing is cached for the cell.
+ */
+void ElevationCache::dropPendingRequests(quint64 key, quint64 generation)
+{
+  if (generation == m_generation)
+    m_pendingRequests.remove(key);
+}
+
+/*!
+  \internal
+
+  Clears the cache when \a surface is not the surface of the cached elevations, and
+  whenever its elevation sources change.
+ */
+void ElevationCache::setSurface(Surface* surface)
+{
+  if (surface == m_surface)
+    return;
+
+  if (m_surface)
+    disconnect(m_surface->elevationSources(), nullptr, this, nullptr);
+
+  m_surface = surface;
+  clear();
+
+  auto* elevationSources = m_surface->elevationSources();
+  connect(elevationSources, &QAbstractItemModel::rowsInserted, this, &ElevationCache::clear);
+  connect(elevationSources, &QAbstractItemModel::rowsRemoved, this, &ElevationCache::clear);
+  connect(elevationSources, &QAbstractItemModel::modelReset, this, &ElevationCache::clear);
+}
+
+} // Dsa
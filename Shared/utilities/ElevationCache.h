@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef ELEVATIONCACHE_H
+#define ELEVATIONCACHE_H
+
+// Qt headers
+#include <QCache>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QVariantMap>
+
+// STL headers
+#include <functional>
+
+namespace Esri::ArcGISRuntime {
+  class Point;
+  class Surface;
+}
+
+namespace Dsa {
+
+class ElevationCache : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ElevationCache(QObject* parent = nullptr);
+  ~ElevationCache() override;
+
+  double resolution() const;
+  void setResolution(double meters);
+
+  int capacity() const;
+  void setCapacity(int cells);
+
+  void requestElevation(Esri::ArcGISRuntime::Surface* surface, const Esri::ArcGISRuntime::Point& point,
+                        std::function<void(double)> callback);
+
+  void clear();
+
+  qint64 hits() const;
+  qint64 misses() const;
+  qint64 coalescedRequests() const;
+  QVariantMap statistics() const;
+
+private:
+  quint64 cellKey(const Esri::ArcGISRuntime::Point& point) const;
+  void setSurface(Esri::ArcGISRuntime::Surface* surface);
+  void dropPendingRequests(quint64 key, quint64 generation);
+
+  QPointer<Esri::ArcGISRuntime::Surface> m_surface;
+  double m_resolution = 5.0;
+  QCache<quint64, double> m_elevations;
+  // callbacks waiting for a query already made for their cell
+  QHash<quint64, QList<std::function<void(double)>>> m_pendingRequests;
+  // queries of an earlier surface or resolution are answered but not cached
+  quint64 m_generation = 0;
+
+  qint64 m_hits = 0;
+  qint64 m_misses = 0;
+  qint64 m_coalescedRequests = 0;
+};
+
+} // Dsa
+
+#endif // ELEVATIONCACHE_H
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "Geodesy.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+namespace Dsa {
+namespace Geodesy {
+
+/*!
+  \namespace Dsa::Geodesy
+  \inmodule Dsa
+  \brief Great circle calculations on a spherical earth for WGS 84 longitudes and latitudes.
+
+  Distances are in metres on a sphere of the mean earth radius, and bearings are in
+  degrees clockwise from north. The spherical model is within about 0.5% of the
+  ellipsoid, which is enough for thresholds, simulation and interpolation between
+  nearby points.
+ */
+
+/*!
+  \fn double Dsa::Geodesy::toRadians(double degrees)
+  \brief Returns \a degrees in radians.
+ */
+
+/*!
+  \fn double Dsa::Geodesy::toDegrees(double radians)
+  \brief Returns \a radians in degrees.
+ */
+
+/*!
+  \brief Returns \a degrees as a bearing in the range [0, 360).
+ */
+double normalizeBearing(double degrees)
+{
+  degrees = std::fmod(degrees, 360.0);
+  return degrees < 0.0 ? degrees + 360.0 : degrees;
+}
+
+/*!
+  \brief Returns the great circle angle in radians between two points.
+ */
+double angleBetween(double lon1, double lat1, double lon2, double lat2)
+{
+  // the haversine formula stays accurate for short distances
+  const double sinHalfLat = std::sin(toRadians(lat2 - lat1) / 2.0);
+  const double sinHalfLon = std::sin(toRadians(lon2 - lon1) / 2.0);
+  const double a = sinHalfLat * sinHalfLat + std::cos(toRadians(lat1)) * std::cos(toRadians(lat2)) * sinHalfLon * sinHalfLon;
+
+  return 2.0 * std::atan2(std::sqrt(a), std::sqrt(std::max(0.0, 1.0 - a)));
+}
+
+/*!
+  \brief Returns the great circle distance in metres between two points.
+ */
+double distanceBetween(double lon1, double lat1, double lon2, double lat2)
+{
+  return EarthRadius * angleBetween(lon1, lat1, lon2, lat2);
+}
+
+/*!
+  \brief Returns the initial bearing of the great circle from the first point towards the second.
+ */
+double bearingBetween(double lon1, double lat1, double lon2, double lat2)
+{
+  const double phi1 = toRadians(lat1);
+  const double phi2 = toRadians(lat2);
+  const double deltaLambda = toRadians(lon2 - lon1);
+  const double y = std::sin(deltaLambda) * std::cos(phi2);
+  const double x = std::cos(phi1) * std::sin(phi2) - std::sin(phi1) * std::cos(phi2) * std::cos(deltaLambda);
+
+  return normalizeBearing(toDegrees(std::atan2(y, x)));
+}
+
+/*!
+  \brief Sets \a outLon and \a outLat to the point \a distance metres from \a lon, \a lat along \a bearing.
+
+  The longitude is returned in the range [-180, 180).
+ */
+void destination(double lon, double lat, double bearing, double distance, double& outLon, double& outLat)
+{
+  const double delta = distance / EarthRadius;
+  const double theta = toRadians(bearing);
+  const double phi1 = toRadians(lat);
+  const double lambda1 = toRadians(lon);
+  const double phi2 = std::asin(std::sin(phi1) * std::cos(delta) + std::cos(phi1) * std::sin(delta) * std::cos(theta));
+  const double lambda2 = lambda1 + std::atan2(std::sin(theta) * std::sin(delta) * std::cos(phi1),
+                                              std::cos(delta) - std::sin(phi1) * std::sin(phi2));
+  outLat = toDegrees(phi2);
+  outLon = normalizeBearing(toDegrees(lambda2) + 180.0) - 180.0;
+}
+
+/*!
+  \brief Sets \a lon and \a lat to the point at \a fraction of the way along the great circle between
+  two points, which are \a angle radians apart.
+
+  Points too close for the great circle to be computed are not interpolated between; the
+  nearer of the two is returned.
+ */
+void interpolate(double lon1, double lat1, double lon2, double lat2, double angle, double fraction, double& lon, double& lat)
+{
+  const double sinAngle = std::sin(angle);
+  if (sinAngle < 1e-12)
+  {
+    lon = fraction < 0.5 ? lon1 : lon2;
+    lat = fraction < 0.5 ? lat1 : lat2;
+    return;
+  }
+
+  const double a = std::sin((1.0 - fraction) * angle) / sinAngle;
+  const double b = std::sin(fraction * angle) / sinAngle;
+  const double phi1 = toRadians(lat1);
+  const double phi2 = toRadians(lat2);
+  const double lambda1 = toRadians(lon1);
+  const double lambda2 = toRadians(lon2);
+
+  const double x = a * std::cos(phi1) * std::cos(lambda1) + b * std::cos(phi2) * std::cos(lambda2);
+  const double y = a * std::cos(phi1) * std::sin(lambda1) + b * std::cos(phi2) * std::sin(lambda2);
+  const double z = a * std::sin(phi1) + b * std::sin(phi2);
+
+  lat = toDegrees(std::atan2(z, std::sqrt(x * x + y * y)));
+  lon = toDegrees(std::atan2(y, x));
+}
+
+} // Geodesy
+} // Dsa
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef GEODESY_H
+#define GEODESY_H
+
+namespace Dsa {
+namespace Geodesy {
+
+constexpr double Pi = 3.14159265358979323846;
+
+// mean radius of the earth in metres
+constexpr double EarthRadius = 6371008.8;
+
+constexpr double toRadians(double degrees)
+{
+  return degrees * Pi / 180.0;
+}
+
+constexpr double toDegrees(double radians)
+{
+  return radians * 180.0 / Pi;
+}
+
+double normalizeBearing(double degrees);
+
+double angleBetween(double lon1, double lat1, double lon2, double lat2);
+double distanceBetween(double lon1, double lat1, double lon2, double lat2);
+double bearingBetween(double lon1, double lat1, double lon2, double lat2);
+
+void destination(double lon, double lat, double bearing, double distance, double& outLon, double& outLat);
+void interpolate(double lon1, double lat1, double lon2, double lat2, double angle, double fraction, double& lon, double& lat);
+
+} // Geodesy
+} // Dsa
+
+#endif // GEODESY_H
@@ -0,0 +1,192 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "LatencyHistogram.h"
+
+// Qt headers
+#include <QtAlgorithms>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+namespace Dsa {
+
+/*!
+  \class Dsa::LatencyHistogram
+  \inmodule Dsa
+  \brief Records latencies in nanoseconds into logarithmic buckets.
+
+  Recording is constant time and the memory used is fixed, so every sample of a
+  long run can be kept. Percentiles are reported to within 12.5%.
+ */
+
+/*!
+  \brief Constructor for an empty histogram.
+ */
+LatencyHistogram::LatencyHistogram()
+{
+}
+
+/*!
+  \brief Records a latency of \a nanoseconds. Negative values are recorded as zero.
+ */
+void LatencyHistogram::record(qint64 nanoseconds)
+{
+  nanoseconds = std::max<qint64>(nanoseconds, 0);
+
+  m_buckets[bucketIndex(nanoseconds)]++;
+  m_minimum = m_count == 0 ? nanoseconds : std::min(m_minimum, nanoseconds);
+  m_maximum = std::max(m_maximum, nanoseconds);
+  m_total += nanoseconds;
+  m_count++;
+}
+
+/*!
+  \brief Adds the samples of \a other to this histogram.
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  if (other.m_count == 0)
+    return;
+
+  for (int i = 0; i < BucketCount; ++i)
+    m_buckets[i] += other.m_buckets[i];
+
+  m_minimum = m_count == 0 ? other.m_minimum : std::min(m_minimum, other.m_minimum);
+  m_maximum = std::max(m_maximum, other.m_maximum);
+  m_total += other.m_total;
+  m_count += other.m_count;
+}
+
+/*!
+  \brief Removes all samples.
+ */
+void LatencyHistogram::clear()
+{
+  m_buckets.fill(0);
+  m_count = 0;
+  m_minimum = 0;
+  m_maximum = 0;
+  m_total = 0.0;
+}
+
+/*!
+  \brief Returns the number of samples recorded.
+ */
+qint64 LatencyHistogram::count() const
+{
+  return m_count;
+}
+
+/*!
+  \brief Returns the smallest sample in nanoseconds.
+ */
+qint64 LatencyHistogram::minimum() const
+{
+  return m_minimum;
+}
+
+/*!
+  \brief Returns the largest sample in nanoseconds.
+ */
+qint64 LatencyHistogram::maximum() const
+{
+  return m_maximum;
+}
+
+/*!
+  \brief Returns the mean of the samples in nanoseconds.
+ */
+double LatencyHistogram::mean() const
+{
+  return m_count > 0 ? m_total / m_count : 0.0;
+}
+
+/*!
+  \brief Returns the value in nanoseconds below which \a percent of the samples fall.
+ */
+qint64 LatencyHistogram::percentile(double percent) const
+{
+  if (m_count == 0)
+    return 0;
+
+  // the rank of the value below which percent of the samples fall
+  const auto rank = std::max<qint64>(1, static_cast<qint64>(std::ceil(m_count * std::clamp(percent, 0.0, 100.0) / 100.0)));
+
+  qint64 seen = 0;
+  for (int i = 0; i < BucketCount; ++i)
+  {
+    seen += m_buckets[i];
+    if (seen >= rank)
+      return std::clamp(bucketUpperBound(i), m_minimum, m_maximum);
+  }
+
+  return m_maximum;
+}
+
+/*!
+  \brief Returns the count, minimum, mean, maximum and main percentiles in microseconds.
+ */
+QVariantMap LatencyHistogram::toVariantMap() const
+{
+  // reported in microseconds, which is the natural scale for a send
+  constexpr double nanosecondsPerMicrosecond = 1000.0;
+
+  QVariantMap result;
+  result.insert(QStringLiteral("count"), m_count);
+  result.insert(QStringLiteral("minUs"), m_minimum / nanosecondsPerMicrosecond);
+  result.insert(QStringLiteral("meanUs"), mean() / nanosecondsPerMicrosecond);
+  result.insert(QStringLiteral("p50Us"), percentile(50.0) / nanosecondsPerMicrosecond);
+  result.insert(QStringLiteral("p90Us"), percentile(90.0) / nanosecondsPerMicrosecond);
+  result.insert(QStringLiteral("p99Us"), percentile(99.0) / nanosecondsPerMicrosecond);
+  result.insert(QStringLiteral("p999Us"), percentile(99.9) / nanosecondsPerMicrosecond);
+  result.insert(QStringLiteral("maxUs"), m_maximum / nanosecondsPerMicrosecond);
+
+  return result;
+}
+
+/*!
+  \internal
+ */
+int LatencyHistogram::bucketIndex(qint64 value)
+{
+  if (value < SubBucketCount)
+    return static_cast<int>(value);
+
+  // the position of the highest set bit picks the power of two, the next bits pick the sub-bucket
+  const int exponent = 63 - qCountLeadingZeroBits(static_cast<quint64>(value));
+  const int subBucket = static_cast<int>(value >> (exponent - SubBucketBits)) - SubBucketCount;
+
+  return SubBucketCount + (exponent - SubBucketBits) * SubBucketCount + subBucket;
+}
+
+/*!
+  \internal
+ */
+qint64 LatencyHistogram::bucketUpperBound(int index)
+{
+  if (index < SubBucketCount)
+    return index;
+
+  const int exponent = (index - SubBucketCount) / SubBucketCount + SubBucketBits;
+  const int subBucket = (index - SubBucketCount) % SubBucketCount;
+
+  return ((static_cast<qint64>(SubBucketCount + subBucket + 1)) << (exponent - SubBucketBits)) - 1;
+}
+
+} // Dsa
@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+// Qt headers
+#include <QVariantMap>
+
+// STL headers
+#include <array>
+
+namespace Dsa {
+
+class LatencyHistogram
+{
+public:
+  LatencyHistogram();
+
+  void record(qint64 nanoseconds);
+  void merge(const LatencyHistogram& other);
+  void clear();
+
+  qint64 count() const;
+  qint64 minimum() const;
+  qint64 maximum() const;
+  double mean() const;
+  qint64 percentile(double percent) const;
+
+  QVariantMap toVariantMap() const;
+
+private:
+  // 8 buckets per power of two, so values are reported to within 12.5%
+  static constexpr int SubBucketBits = 3;
+  static constexpr int SubBucketCount = 1 << SubBucketBits;
+  static constexpr int BucketCount = SubBucketCount + (63 - SubBucketBits) * SubBucketCount;
+
+  static int bucketIndex(qint64 value);
+  static qint64 bucketUpperBound(int index);
+
+  std::array<qint64, BucketCount> m_buckets{};
+  qint64 m_count = 0;
+  qint64 m_minimum = 0;
+  qint64 m_maximum = 0;
+  double m_total = 0.0;
+};
+
+} // Dsa
+
+#endif // LATENCYHISTOGRAM_H
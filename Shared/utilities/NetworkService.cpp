@@ -0,0 +1,467 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "NetworkService.h"
+
+// Qt headers
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutexLocker>
+#include <QThread>
+#include <QUdpSocket>
+
+namespace Dsa {
+
+namespace
+{
+// each port is bound once and shared by its subscribers within this process; other processes cannot bind it
+constexpr QAbstractSocket::BindMode c_bindMode = QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint;
+
+// multicast stays on the local network unless routed further
+constexpr int c_multicastTtl = 1;
+
+// large enough for any datagram which fits in a single UDP packet
+constexpr int c_receiveBufferSize = 65536;
+} // namespace
+
+/*!
+  \internal
+  \brief Owns every socket of the service and lives on the service thread.
+ */
+class NetworkService::Worker : public QObject
+{
+public:
+  explicit Worker(NetworkService* service) :
+    m_service(service),
+    m_receiveBuffer(c_receiveBufferSize, Qt::Uninitialized)
+  {
+  }
+
+  void bind(quint16 port)
+  {
+    if (m_receivers.contains(port))
+      return;
+
+    QUdpSocket* udpSocket = new QUdpSocket(this);
+    if (!udpSocket->bind(port, c_bindMode))
+    {
+      qWarning() << "NetworkService could not bind to port" << port << udpSocket->errorString();
+      delete udpSocket;
+      return;
+    }
+
+    applyBufferSize(udpSocket, QAbstractSocket::ReceiveBufferSizeSocketOption);
+    connect(udpSocket, &QUdpSocket::readyRead, this, [this, port, udpSocket]
+    {
+      readDatagrams(port, udpSocket);
+    });
+
+    m_receivers.insert(port, udpSocket);
+  }
+
+  void unbind(quint16 port)
+  {
+    delete m_receivers.take(port);
+  }
+
+  void flushSends()
+  {
+    {
+      QMutexLocker locker(&m_service->m_sendMutex);
+      m_sending.swap(m_service->m_pendingSends);
+    }
+
+    for (const PendingDatagram& datagram : m_sending)
+    {
+      const qint64 bytesWritten = sendSocket(datagram.address)->writeDatagram(datagram.data, datagram.address, datagram.port);
+      if (bytesWritten == -1)
+      {
+        m_service->m_sendFailures++;
+        continue;
+      }
+
+      m_service->m_datagramsSent++;
+      m_service->m_bytesSent += bytesWritten;
+    }
+
+    // keep the capacity so the next swap hands an allocated list back to the queue
+    m_sending.clear();
+  }
+
+  void applyBufferSizes()
+  {
+    if (m_sendSocket)
+      applyBufferSize(m_sendSocket, QAbstractSocket::SendBufferSizeSocketOption);
+
+    if (m_sendSocket6)
+      applyBufferSize(m_sendSocket6, QAbstractSocket::SendBufferSizeSocketOption);
+
+    for (QUdpSocket* udpSocket : std::as_const(m_receivers))
+      applyBufferSize(udpSocket, QAbstractSocket::ReceiveBufferSizeSocketOption);
+  }
+
+  int portCount() const
+  {
+    return m_receivers.size();
+  }
+
+private:
+  void readDatagrams(quint16 port, QUdpSocket* udpSocket)
+  {
+    // drain everything queued on the socket so it is delivered as one batch
+    while (udpSocket->hasPendingDatagrams())
+    {
+      const qint64 size = udpSocket->pendingDatagramSize();
+      if (size < 0)
+        break;
+
+      if (size > m_receiveBuffer.size())
+        m_receiveBuffer.resize(size);
+
+      const qint64 bytesRead = udpSocket->readDatagram(m_receiveBuffer.data(), m_receiveBuffer.size());
+      if (bytesRead < 0)
+        break;
+
+      m_batch.append(QByteArray(m_receiveBuffer.constData(), bytesRead));
+      m_service->m_datagramsReceived++;
+      m_service->m_bytesReceived += bytesRead;
+    }
+
+    if (!m_batch.isEmpty())
+      m_service->queueDatagrams(port, m_batch);
+  }
+
+  QUdpSocket* sendSocket(const QHostAddress& address)
+  {
+    const bool isIPv6 = address.protocol() == QAbstractSocket::IPv6Protocol;
+    QUdpSocket*& udpSocket = isIPv6 ? m_sendSocket6 : m_sendSocket;
+    if (udpSocket)
+      return udpSocket;
+
+    // one unconnected socket per protocol sends to every destination, including broadcast
+    udpSocket = new QUdpSocket(this);
+    udpSocket->bind(isIPv6 ? QHostAddress::AnyIPv6 : QHostAddress::AnyIPv4, 0);
+    udpSocket->setSocketOption(QAbstractSocket::MulticastTtlOption, c_multicastTtl);
+    udpSocket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+    applyBufferSize(udpSocket, QAbstractSocket::SendBufferSizeSocketOption);
+
+    return udpSocket;
+  }
+
+  void applyBufferSize(QUdpSocket* udpSocket, QAbstractSocket::SocketOption option)
+  {
+    const int bufferSize = m_service->m_socketBufferSize;
+    if (bufferSize > 0)
+      udpSocket->setSocketOption(option, bufferSize);
+  }
+
+  NetworkService* m_service = nullptr;
+  QUdpSocket* m_sendSocket = nullptr;
+  QUdpSocket* m_sendSocket6 = nullptr;
+  QHash<quint16, QUdpSocket*> m_receivers;
+  std::vector<PendingDatagram> m_sending;
+  QByteArray m_receiveBuffer;
+  QList<QByteArray> m_batch;
+};
+
+/*!
+  \class Dsa::NetworkService
+  \inmodule Dsa
+  \inherits QObject
+  \brief Performs all UDP socket I/O of the application on one dedicated thread.
+
+  The service owns every UDP socket used by the app's feeds and broadcasts. Sends
+  are queued from any thread and written by the service thread in batches, through a
+  single unconnected socket per IP protocol. Each subscribed port is bound once,
+  however many subscribers it has; received datagrams are read into a shared buffer,
+  collected per port and handed to the subscribers in batches on the thread the
+  service was created on, with at most one delivery pending at a time.
+
+  The service thread is stopped when the application is about to quit. Datagrams
+  sent after that are written directly on the calling thread.
+
+  \sa DataListener, DataSender
+ */
+
+/*!
+  \brief Returns the network service, creating it on first use.
+
+  The service must first be used from the application's main thread, which is
+  the thread received datagrams are delivered on.
+ */
+NetworkService* NetworkService::instance()
+{
+  static NetworkService s_instance;
+
+  return &s_instance;
+}
+
+/*!
+  \internal
+ */
+NetworkService::NetworkService(QObject* parent) :
+  QObject(parent),
+  m_thread(new QThread(this)),
+  m_worker(new Worker(this))
+{
+  m_thread->setObjectName(QStringLiteral("NetworkService"));
+  m_worker->moveToThread(m_thread);
+  connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+  m_thread->start();
+  m_isRunning = true;
+
+  if (QCoreApplication* application = QCoreApplication::instance())
+    connect(application, &QCoreApplication::aboutToQuit, this, &NetworkService::shutdown);
+}
+
+/*!
+  \brief Destructor.
+ */
+NetworkService::~NetworkService()
+{
+  shutdown();
+}
+
+/*!
+  \brief Queues \a datagram to be sent to \a address and \a port.
+
+  Returns \c false if the datagram could not be sent. Datagrams queued together
+  are written by the service thread in one pass; failures on that thread are
+  counted in the statistics.
+ */
+bool NetworkService::send(const QHostAddress& address, quint16 port, const QByteArray& datagram)
+{
+  if (address.isNull() || port == 0)
+  {
+    m_sendFailures++;
+    return false;
+  }
+
+  if (!m_isRunning)
+  {
+    // the socket is created by shutdown before the service stops running
+    QMutexLocker locker(&m_sendMutex);
+    const qint64 bytesWritten = m_shutdownSocket->writeDatagram(datagram, address, port);
+    if (bytesWritten == -1)
+    {
+      m_sendFailures++;
+      return false;
+    }
+
+    m_datagramsSent++;
+    m_bytesSent += bytesWritten;
+    return true;
+  }
+
+  bool wasEmpty = false;
+  {
+    QMutexLocker locker(&m_sendMutex);
+    wasEmpty = m_pendingSends.empty();
+    m_pendingSends.push_back(PendingDatagram{address, port, datagram});
+  }
+
+  // a flush is already on its way if the queue had datagrams in it
+  if (wasEmpty)
+  {
+    Worker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker] { worker->flushSends(); }, Qt::QueuedConnection);
+  }
+
+  return true;
+}
+
+/*!
+  \brief Subscribes \a subscriber to the datagrams received on \a port.
+
+  \a handler is called with each batch of datagrams on the main thread the
+  service was created on, for as long as \a subscriber exists. The port is bound
+  when its first subscriber is added.
+ */
+void NetworkService::subscribe(quint16 port, QObject* subscriber, const DatagramHandler& handler)
+{
+  if (!subscriber || !handler || !m_isRunning)
+    return;
+
+  QList<Subscription>& subscriptions = m_subscriptions[port];
+  const bool bind = subscriptions.isEmpty();
+  subscriptions.append(Subscription{subscriber, handler});
+
+  if (bind)
+  {
+    Worker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, port] { worker->bind(port); }, Qt::QueuedConnection);
+  }
+}
+
+/*!
+  \brief Removes the subscription of \a subscriber to \a port.
+
+  The port is closed when its last subscriber is removed.
+ */
+void NetworkService::unsubscribe(quint16 port, QObject* subscriber)
+{
+  auto it = m_subscriptions.find(port);
+  if (it == m_subscriptions.end())
+    return;
+
+  it->removeIf([subscriber](const Subscription& subscription)
+  {
+    return !subscription.subscriber || subscription.subscriber == subscriber;
+  });
+
+  if (!it->isEmpty())
+    return;
+
+  m_subscriptions.erase(it);
+
+  if (m_isRunning)
+  {
+    Worker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, port] { worker->unbind(port); }, Qt::QueuedConnection);
+  }
+}
+
+/*!
+  \brief Returns the size in bytes requested for the send and receive buffers of the sockets.
+
+  \c 0 means the operating system default is used.
+ */
+int NetworkService::socketBufferSize() const
+{
+  return m_socketBufferSize;
+}
+
+/*!
+  \brief Sets the size in bytes of the send and receive buffers of the sockets to \a bytes.
+
+  Larger buffers absorb longer bursts before datagrams are dropped. The size is
+  applied to the open sockets and to those opened later.
+ */
+void NetworkService::setSocketBufferSize(int bytes)
+{
+  if (m_socketBufferSize == bytes)
+    return;
+
+  m_socketBufferSize = bytes;
+
+  if (m_isRunning)
+  {
+    Worker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker] { worker->applyBufferSizes(); }, Qt::QueuedConnection);
+  }
+}
+
+/*!
+  \brief Returns the traffic counters of the service.
+
+  The map contains \c datagramsSent, \c bytesSent, \c sendFailures,
+  \c datagramsReceived, \c bytesReceived, \c deliveries (the number of batches
+  handed to subscribers) and \c ports (the number of subscribed ports).
+ */
+QVariantMap NetworkService::statistics() const
+{
+  return QVariantMap
+  {
+    {QStringLiteral("datagramsSent"), static_cast<qint64>(m_datagramsSent)},
+    {QStringLiteral("bytesSent"), static_cast<qint64>(m_bytesSent)},
+    {QStringLiteral("sendFailures"), static_cast<qint64>(m_sendFailures)},
+    {QStringLiteral("datagramsReceived"), static_cast<qint64>(m_datagramsReceived)},
+    {QStringLiteral("bytesReceived"), static_cast<qint64>(m_bytesReceived)},
+    {QStringLiteral("deliveries"), static_cast<qint64>(m_deliveries)},
+    {QStringLiteral("ports"), static_cast<int>(m_subscriptions.size())}
+  };
+}
+
+/*!
+  \brief Writes any queued datagrams and stops the service thread.
+
+  Called automatically when the application is about to quit.
+ */
+void NetworkService::shutdown()
+{
+  if (!m_isRunning)
+    return;
+
+  Worker* worker = m_worker;
+  QMetaObject::invokeMethod(worker, [worker] { worker->flushSends(); }, Qt::BlockingQueuedConnection);
+
+  // later sends are written directly, so their socket has to exist before they see the service stopped
+  m_shutdownSocket = new QUdpSocket(this);
+  m_isRunning = false;
+  m_thread->quit();
+  m_thread->wait();
+
+  // the worker and its sockets are deleted when the thread finishes
+  m_worker = nullptr;
+}
+
+/*!
+  \internal
+  \brief Adds \a datagrams received on \a port to the next delivery and clears the list.
+
+  Called on the service thread.
+ */
+void NetworkService::queueDatagrams(quint16 port, QList<QByteArray>& datagrams)
+{
+  bool post = false;
+  {
+    QMutexLocker locker(&m_receiveMutex);
+    m_pendingDatagrams[port].append(datagrams);
+    post = !m_deliveryPosted;
+    m_deliveryPosted = true;
+  }
+
+  datagrams.clear();
+
+  if (post)
+    QMetaObject::invokeMethod(this, [this] { deliverDatagrams(); }, Qt::QueuedConnection);
+}
+
+/*!
+  \internal
+  \brief Hands every batch of received datagrams to the subscribers of its port.
+ */
+void NetworkService::deliverDatagrams()
+{
+  {
+    QMutexLocker locker(&m_receiveMutex);
+    m_deliveringDatagrams.swap(m_pendingDatagrams);
+    m_deliveryPosted = false;
+  }
+
+  for (auto it = m_deliveringDatagrams.begin(); it != m_deliveringDatagrams.end(); ++it)
+  {
+    if (it->isEmpty())
+      continue;
+
+    // a handler may subscribe or unsubscribe, so iterate over a copy
+    const QList<Subscription> subscriptions = m_subscriptions.value(it.key());
+    for (const Subscription& subscription : subscriptions)
+    {
+      if (!subscription.subscriber)
+        continue;
+
+      subscription.handler(*it);
+      m_deliveries++;
+    }
+
+    // the emptied lists keep their capacity for the next batch on the port
+    it->clear();
+  }
+}
+
+} // Dsa
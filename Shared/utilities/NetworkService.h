@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef NETWORKSERVICE_H
+#define NETWORKSERVICE_H
+
+// Qt headers
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QVariantMap>
+
+// STL headers
+#include <atomic>
+#include <functional>
+#include <vector>
+
+class QThread;
+class QUdpSocket;
+
+namespace Dsa {
+
+class NetworkService : public QObject
+{
+  Q_OBJECT
+
+public:
+  using DatagramHandler = std::function<void(const QList<QByteArray>& datagrams)>;
+
+  static NetworkService* instance();
+
+  ~NetworkService() override;
+
+  bool send(const QHostAddress& address, quint16 port, const QByteArray& datagram);
+
+  void subscribe(quint16 port, QObject* subscriber, const DatagramHandler& handler);
+  void unsubscribe(quint16 port, QObject* subscriber);
+
+  int socketBufferSize() const;
+  void setSocketBufferSize(int bytes);
+
+  QVariantMap statistics() const;
+
+  void shutdown();
+
+private:
+  Q_DISABLE_COPY(NetworkService)
+
+  class Worker;
+
+  struct Subscription
+  {
+    QPointer<QObject> subscriber;
+    DatagramHandler handler;
+  };
+
+  struct PendingDatagram
+  {
+    QHostAddress address;
+    quint16 port = 0;
+    QByteArray data;
+  };
+
+  explicit NetworkService(QObject* parent = nullptr);
+
+  void queueDatagrams(quint16 port, QList<QByteArray>& datagrams);
+  void deliverDatagrams();
+
+  QThread* m_thread = nullptr;
+  Worker* m_worker = nullptr;
+  std::atomic<bool> m_isRunning{false};
+  std::atomic<int> m_socketBufferSize{0};
+
+  // sends waiting for the service thread; the service thread swaps the list for its own
+  QMutex m_sendMutex;
+  std::vector<PendingDatagram> m_pendingSends;
+
+  // written to directly once the service has stopped, under the send mutex
+  QUdpSocket* m_shutdownSocket = nullptr;
+
+  // datagrams waiting for the main thread; at most one delivery is posted at a time
+  QMutex m_receiveMutex;
+  QHash<quint16, QList<QByteArray>> m_pendingDatagrams;
+  bool m_deliveryPosted = false;
+
+  // only used on the main thread
+  QHash<quint16, QList<Subscription>> m_subscriptions;
+  QHash<quint16, QList<QByteArray>> m_deliveringDatagrams;
+
+  std::atomic<qint64> m_datagramsSent{0};
+  std::atomic<qint64> m_bytesSent{0};
+  std::atomic<qint64> m_sendFailures{0};
+  std::atomic<qint64> m_datagramsReceived{0};
+  std::atomic<qint64> m_bytesReceived{0};
+  std::atomic<qint64> m_deliveries{0};
+};
+
+} // Dsa
+
+#endif // NETWORKSERVICE_H
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "StreamChecksum.h"
+
+// Qt headers
+#include <QXmlStreamReader>
+
+// STL headers
+#include <chrono>
+
+namespace Dsa {
+
+namespace
+{
+// 64 bit FNV-1a
+constexpr quint64 c_offsetBasis = 14695981039346656037ULL;
+constexpr quint64 c_prime = 1099511628211ULL;
+
+const QByteArray c_checkpointElement = QByteArrayLiteral("<simulatorcheckpoint");
+} // namespace
+
+/*!
+  \class Dsa::StreamChecksum
+  \inmodule Dsa
+  \brief A rolling checksum over a stream of messages, and the checkpoint
+  messages used to compare the checksums of a sender and a receiver.
+
+  The message simulator adds every message it sends and periodically sends a
+  checkpoint carrying its message count and checksum. A receiver adds every
+  message it receives between checkpoints; when its count and checksum match
+  the checkpoint it saw the identical stream, in the same order. Each
+  checkpoint also carries the time it was sent, so the receiver can measure
+  end-to-end latency when both clocks are synchronized.
+
+  The checkpoint is a single XML element:
+
+  \code
+  <simulatorcheckpoint run="42-1718000000000" count="1000" checksum="89ab..." sent="1718000000123456" final="false"/>
+  \endcode
+ */
+
+/*!
+  \brief Constructor for an empty checksum.
+ */
+StreamChecksum::StreamChecksum() :
+  m_value(c_offsetBasis)
+{
+}
+
+/*!
+  \brief Adds \a message to the checksum.
+
+  The length of each message is included, so the checksum depends on where
+  the stream is split into messages as well as on its bytes.
+ */
+void StreamChecksum::add(const QByteArray& message)
+{
+  quint64 value = m_value;
+  value ^= static_cast<quint64>(message.size());
+  value *= c_prime;
+
+  const auto* bytes = reinterpret_cast<const unsigned char*>(message.constData());
+  for (qsizetype i = 0; i < message.size(); ++i)
+  {
+    value ^= bytes[i];
+    value *= c_prime;
+  }
+
+  m_value = value;
+  m_count++;
+}
+
+/*!
+  \brief Resets the checksum to its initial state.
+ */
+void StreamChecksum::reset()
+{
+  m_value = c_offsetBasis;
+  m_count = 0;
+}
+
+/*!
+  \brief Returns the checksum of the messages added so far.
+ */
+quint64 StreamChecksum::value() const
+{
+  return m_value;
+}
+
+/*!
+  \brief Returns the number of messages added so far.
+ */
+qint64 StreamChecksum::count() const
+{
+  return m_count;
+}
+
+/*!
+  \brief Returns a checkpoint message for this checksum, identified by \a run.
+
+  \a final marks the last checkpoint of the run.
+ */
+QByteArray StreamChecksum::checkpointMessage(const QString& run, bool final) const
+{
+  QByteArray message = c_checkpointElement;
+  message += " run=\"" + run.toUtf8().toPercentEncoding() + "\" count=\"" + QByteArray::number(m_count) +
+      "\" checksum=\"" + QByteArray::number(m_value, 16) + "\" sent=\"" + QByteArray::number(currentTimeUs()) +
+      "\" final=\"" + (final ? "true" : "false") + "\"/>";
+
+  return message;
+}
+
+/*!
+  \brief Returns whether \a data is a checkpoint message.
+ */
+bool StreamChecksum::isCheckpointMessage(const QByteArray& data)
+{
+  return data.startsWith(c_checkpointElement);
+}
+
+/*!
+  \brief Reads the checkpoint message \a data into \a checkpoint.
+
+  Returns \c false if \a data is not a valid checkpoint message.
+ */
+bool StreamChecksum::parseCheckpoint(const QByteArray& data, Checkpoint& checkpoint)
+{
+  if (!isCheckpointMessage(data))
+    return false;
+
+  QXmlStreamReader reader(data);
+  if (!reader.readNextStartElement())
+    return false;
+
+  const QXmlStreamAttributes attributes = reader.attributes();
+  bool countOk = false;
+  bool checksumOk = false;
+  bool sentOk = false;
+  checkpoint.run = QString::fromUtf8(QByteArray::fromPercentEncoding(attributes.value(QStringLiteral("run")).toUtf8()));
+  checkpoint.count = attributes.value(QStringLiteral("count")).toLongLong(&countOk);
+  checkpoint.checksum = attributes.value(QStringLiteral("checksum")).toULongLong(&checksumOk, 16);
+  checkpoint.sentUs = attributes.value(QStringLiteral("sent")).toLongLong(&sentOk);
+  checkpoint.final = attributes.value(QStringLiteral("final")) == QStringLiteral("true");
+
+  return !checkpoint.run.isEmpty() && countOk && checksumOk && sentOk;
+}
+
+/*!
+  \brief Returns the wall clock time in microseconds since the epoch.
+ */
+qint64 StreamChecksum::currentTimeUs()
+{
+  using namespace std::chrono;
+  return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+} // Dsa
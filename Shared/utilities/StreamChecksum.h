@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef STREAMCHECKSUM_H
+#define STREAMCHECKSUM_H
+
+// Qt headers
+#include <QByteArray>
+#include <QString>
+
+namespace Dsa {
+
+class StreamChecksum
+{
+public:
+  struct Checkpoint
+  {
+    QString run;
+    qint64 count = 0;
+    quint64 checksum = 0;
+    qint64 sentUs = 0;
+    bool final = false;
+  };
+
+  StreamChecksum();
+
+  void add(const QByteArray& message);
+  void reset();
+
+  quint64 value() const;
+  qint64 count() const;
+
+  QByteArray checkpointMessage(const QString& run, bool final) const;
+
+  static bool isCheckpointMessage(const QByteArray& data);
+  static bool parseCheckpoint(const QByteArray& data, Checkpoint& checkpoint);
+  static qint64 currentTimeUs();
+
+private:
+  quint64 m_value;
+  qint64 m_count = 0;
+};
+
+} // Dsa
+
+#endif // STREAMCHECKSUM_H
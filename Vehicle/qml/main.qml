@@ -37,7 +37,7 @@ Vehicle {
     signal clearDialogAccepted();
     signal closeDialogAccepted();
     signal inputDialogAccepted(var input, var index);
-    signal markupLayerReceived(var path, var overlayVisible);
+    signal markupLayerReceived(var markupLayer, var overlayVisible);
     property bool configurationsChanged: false
 
     LocationController {
@@ -591,10 +591,10 @@ Vehicle {
 
     DsaYesNoDialog {
         id: markupDialog
-        property string path
+        property var markupLayer
 
-        onAccepted: markupLayerReceived(path, true);
-        onRejected: markupLayerReceived(path, false);
+        onAccepted: markupLayerReceived(markupLayer, true);
+        onRejected: markupLayerReceived(markupLayer, false);
     }
 
     DsaYesNoDialog {
@@ -0,0 +1,220 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#include "CoordinateNotation.h"
+
+// C++ API headers
+#include "CoordinateFormatter.h"
+#include "Point.h"
+#include "SpatialReference.h"
+
+using namespace Esri::ArcGISRuntime;
+using namespace Dsa;
+
+namespace
+{
+struct NotationCase
+{
+  CoordinateNotation::Notation notation;
+  int precision;
+  const char* name;
+};
+
+// the formats LocationTextController shows, then the other grid precisions
+constexpr NotationCase c_cases[] = {
+  {CoordinateNotation::Notation::DecimalDegrees, 5, "DD"},
+  {CoordinateNotation::Notation::DegreesDecimalMinutes, 5, "DDM"},
+  {CoordinateNotation::Notation::DegreesMinutesSeconds, 3, "DMS"},
+  {CoordinateNotation::Notation::Utm, 0, "UTM"},
+  {CoordinateNotation::Notation::Mgrs, 5, "MGRS"},
+  {CoordinateNotation::Notation::Usng, 5, "USNG"},
+  {CoordinateNotation::Notation::DecimalDegrees, 0, "DD"},
+  {CoordinateNotation::Notation::DegreesMinutesSeconds, 0, "DMS"},
+  {CoordinateNotation::Notation::Mgrs, 1, "MGRS"},
+  {CoordinateNotation::Notation::Mgrs, 3, "MGRS"},
+  {CoordinateNotation::Notation::Usng, 2, "USNG"}
+};
+
+// the grid notations cover the latitudes of UTM zones
+constexpr double c_minimumUtmLatitude = -80.0;
+constexpr double c_maximumUtmLatitude = 84.0;
+
+constexpr int c_maximumExamples = 10;
+
+// the text LocationTextController shows for each notation
+QString toCoordinateFormatterString(const CoordinateNotation& notation, const Point& point)
+{
+  switch (notation.notation())
+  {
+  case CoordinateNotation::Notation::DecimalDegrees:
+    return CoordinateFormatter::toLatitudeLongitude(point, LatitudeLongitudeFormat::DecimalDegrees, notation.precision());
+  case CoordinateNotation::Notation::DegreesDecimalMinutes:
+    return CoordinateFormatter::toLatitudeLongitude(point, LatitudeLongitudeFormat::DegreesDecimalMinutes, notation.precision());
+  case CoordinateNotation::Notation::DegreesMinutesSeconds:
+    return CoordinateFormatter::toLatitudeLongitude(point, LatitudeLongitudeFormat::DegreesMinutesSeconds, notation.precision());
+  case CoordinateNotation::Notation::Utm:
+    return CoordinateFormatter::toUtm(point, UtmConversionMode::NorthSouthIndicators, true);
+  case CoordinateNotation::Notation::Mgrs:
+    return CoordinateFormatter::toMgrs(point, MgrsConversionMode::Automatic, notation.precision(), true);
+  case CoordinateNotation::Notation::Usng:
+    return CoordinateFormatter::toUsng(point, notation.precision(), true);
+  }
+
+  return QString();
+}
+
+// formats sampleCount random points over the whole range of the notation both ways
+QJsonObject compareWithCoordinateFormatter(const CoordinateNotation& notation, int sampleCount, quint32 seed)
+{
+  const bool isGrid = notation.notation() == CoordinateNotation::Notation::Utm ||
+                      notation.notation() == CoordinateNotation::Notation::Mgrs ||
+                      notation.notation() == CoordinateNotation::Notation::Usng;
+  const double minimumLatitude = isGrid ? c_minimumUtmLatitude : -90.0;
+  const double maximumLatitude = isGrid ? c_maximumUtmLatitude : 90.0;
+
+  QRandomGenerator generator(seed);
+  int mismatches = 0;
+  QJsonArray examples;
+  for (int i = 0; i < sampleCount; ++i)
+  {
+    const double longitude = generator.bounded(360.0) - 180.0;
+    const double latitude = minimumLatitude + generator.bounded(maximumLatitude - minimumLatitude);
+    const Point point(longitude, latitude, SpatialReference::wgs84());
+
+    const QString native = notation.toString(point);
+    const QString expected = toCoordinateFormatterString(notation, point);
+    if (native == expected)
+      continue;
+
+    ++mismatches;
+    if (examples.size() < c_maximumExamples)
+      examples.append(QString("%1, %2: %3 | %4").arg(longitude, 0, 'f', 9).arg(latitude, 0, 'f', 9).arg(native, expected));
+  }
+
+  QJsonObject result;
+  result.insert("samples", sampleCount);
+  result.insert("mismatches", mismatches);
+  result.insert("examples", examples);
+
+  return result;
+}
+} // namespace
+
+void printHelp()
+{
+  QTextStream out(stdout);
+  out << "Compares the native coordinate text with CoordinateFormatter's." << Qt::endl;
+  out << "Available command line parameters:" << Qt::endl;
+  out << "  -h                     Print help and exit" << Qt::endl;
+  out << "  -n <samples>           Random points compared per notation; default is 100000" << Qt::endl;
+  out << "  -S <seed>              Random seed; default is 1" << Qt::endl;
+  out << "  -o <filename>          Also write the JSON report to this file" << Qt::endl;
+  out << "The JSON report of mismatches per notation is printed to stdout. The exit" << Qt::endl <<
+         "code is 0 only if every notation matched." << Qt::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  int sampleCount = 100000;
+  quint32 seed = 1;
+  QString reportFile;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "-h"))
+    {
+      printHelp();
+      return 0;
+    }
+    else if (!strcmp(argv[i], "-n"))
+    {
+      if ((i + 1) < argc)
+      {
+        sampleCount = atoi(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-S"))
+    {
+      if ((i + 1) < argc)
+      {
+        seed = static_cast<quint32>(strtoul(argv[++i], nullptr, 10));
+      }
+    }
+    else if (!strcmp(argv[i], "-o"))
+    {
+      if ((i + 1) < argc)
+      {
+        reportFile = QString(argv[++i]);
+      }
+    }
+  }
+
+  if (sampleCount <= 0)
+  {
+    printHelp();
+    return 2;
+  }
+
+  QJsonArray notations;
+  bool passed = true;
+  for (const NotationCase& notationCase : c_cases)
+  {
+    const CoordinateNotation notation(notationCase.notation, notationCase.precision);
+
+    QElapsedTimer timer;
+    timer.start();
+    QJsonObject result = compareWithCoordinateFormatter(notation, sampleCount, seed);
+    result.insert("milliseconds", timer.elapsed());
+    result.insert("notation", QString::fromLatin1(notationCase.name));
+    result.insert("precision", notationCase.precision);
+
+    passed = passed && result.value("mismatches").toInt() == 0;
+    notations.append(result);
+  }
+
+  QJsonObject report;
+  report.insert("seed", static_cast<qint64>(seed));
+  report.insert("samples", sampleCount);
+  report.insert("passed", passed);
+  report.insert("notations", notations);
+
+  const QByteArray json = QJsonDocument(report).toJson();
+
+  QTextStream out(stdout);
+  out << json;
+  out.flush();
+
+  if (!reportFile.isEmpty())
+  {
+    QFile file(reportFile);
+    if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size())
+      QTextStream(stderr) << "Could not write report to: " << reportFile << "\n";
+  }
+
+  return passed ? 0 : 1;
+}
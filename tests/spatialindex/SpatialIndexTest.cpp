@@ -0,0 +1,712 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "SpatialIndexTest.h"
+
+// DSA headers
+#include "GeometryIndex.h"
+#include "GeometryQuadtree.h"
+#include "PointGridIndex.h"
+
+// C++ API headers
+#include "Envelope.h"
+#include "GeoElement.h"
+#include "Graphic.h"
+#include "Point.h"
+#include "PolygonBuilder.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QSet>
+
+// STL headers
+#include <algorithm>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <Windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#endif
+
+using namespace Esri::ArcGISRuntime;
+using namespace Dsa;
+
+namespace
+{
+constexpr double c_fullRevolution = 360.0;
+
+// every dataset stays clear of the poles
+constexpr double c_maxLatitude = 85.0;
+
+constexpr int c_clusterCount = 20;
+constexpr double c_clusterHalfSize = 0.5;
+
+// the antimeridian dataset covers this many degrees either side of 180
+constexpr double c_antimeridianSpan = 10.0;
+constexpr double c_antimeridianLatitude = 60.0;
+
+constexpr double c_minPolygonSize = 0.01;
+constexpr double c_maxPolygonSize = 1.0;
+constexpr double c_minQuerySize = 0.1;
+constexpr double c_maxQuerySize = 5.0;
+
+// share of the elements moved, and of those removed and replaced, between the two rounds of queries
+constexpr double c_moveFraction = 0.1;
+constexpr double c_replaceFraction = 0.05;
+constexpr double c_moveDistance = 0.5;
+
+// failures described per case; the counts always cover every query
+constexpr int c_maxReportedFailures = 10;
+
+double perSecond(qint64 count, qint64 nanoseconds)
+{
+  return nanoseconds > 0 ? count * 1e9 / nanoseconds : 0.0;
+}
+} // namespace
+
+/*!
+  \class SpatialIndexTest
+  \brief Checks the spatial indexes in Shared against a brute-force oracle and
+  measures their throughput.
+
+  For each dataset (uniform, clustered and around the antimeridian), geometry kind
+  (points and polygons) and index (\l Dsa::GeometryQuadtree, \l Dsa::PointGridIndex
+  and whichever \l Dsa::GeometryIndex::createIndex picks), the index is built over
+  the elements and queried with random extents and locations. Every element whose
+  extent the oracle finds intersecting a query, or one of its copies a revolution
+  east or west, must be among the candidates returned, and every candidate must be
+  the current geometry of an element still in the index. Elements are then moved,
+  removed and appended, and the queries are checked again.
+
+  Longitudes in the antimeridian dataset are not normalized: elements may lie either
+  side of 180 in either representation, as tracks crossing it do.
+
+  Timings only include calls into the index. The memory reported is the growth of the
+  resident set while building the index, so it is approximate.
+ */
+
+/*!
+  \brief Constructor taking the number of elements in each dataset (\a elementCount), the
+  number of extent and location queries in each round (\a queryCount) and the random \a seed.
+ */
+SpatialIndexTest::SpatialIndexTest(int elementCount, int queryCount, quint32 seed) :
+  m_elementCount(elementCount),
+  m_queryCount(queryCount),
+  m_seed(seed)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+SpatialIndexTest::~SpatialIndexTest()
+{
+  clearElements();
+}
+
+/*!
+  \brief Runs every combination of dataset, geometry kind and index and returns the report.
+
+  The report's \c passed value is \c true if every case passed.
+ */
+QJsonObject SpatialIndexTest::runAll()
+{
+  QJsonArray cases;
+  bool passed = true;
+
+  for (const Dataset dataset : {Dataset::Uniform, Dataset::Clustered, Dataset::Antimeridian})
+  {
+    for (const GeometryKind geometryKind : {GeometryKind::Points, GeometryKind::Polygons})
+    {
+      for (const IndexKind indexKind : {IndexKind::Quadtree, IndexKind::PointGrid, IndexKind::Automatic})
+      {
+        const QJsonObject result = run(dataset, geometryKind, indexKind);
+        passed = passed && result.value("passed").toBool();
+        cases.append(result);
+      }
+    }
+  }
+
+  QJsonObject report;
+  report.insert("seed", static_cast<qint64>(m_seed));
+  report.insert("elementCount", m_elementCount);
+  report.insert("queryCount", m_queryCount);
+  report.insert("passed", passed);
+  report.insert("cases", cases);
+
+  return report;
+}
+
+/*!
+  \brief Runs a single case and returns its results.
+
+  Every index sees the same elements, updates and queries for a given \a dataset and \a geometryKind.
+ */
+QJsonObject SpatialIndexTest::run(Dataset dataset, GeometryKind geometryKind, IndexKind indexKind)
+{
+  m_failures.clear();
+  m_random.seed(m_seed + static_cast<quint32>(dataset) * 2 + static_cast<quint32>(geometryKind));
+
+  createElements(dataset, geometryKind);
+
+  const qint64 memoryBefore = residentMemory();
+
+  QElapsedTimer timer;
+  timer.start();
+  GeometryIndex* index = createIndex(indexKind);
+  const qint64 buildTime = timer.nsecsElapsed();
+
+  const qint64 memoryAfter = residentMemory();
+
+  QJsonObject build;
+  build.insert("milliseconds", buildTime / 1e6);
+  build.insert("elementsPerSecond", perSecond(m_elementCount, buildTime));
+
+  QJsonObject memory;
+  memory.insert("indexResidentBytes", memoryBefore >= 0 && memoryAfter >= 0 ? memoryAfter - memoryBefore : -1);
+
+  const QJsonObject afterBuild = checkQueries(index, dataset);
+  const QJsonObject update = updateElements(index, dataset, geometryKind);
+  const QJsonObject afterUpdate = checkQueries(index, dataset);
+
+  QJsonObject result;
+  result.insert("dataset", toString(dataset));
+  result.insert("geometry", toString(geometryKind));
+  result.insert("index", toString(indexKind));
+  result.insert("indexType", QString::fromLatin1(index->metaObject()->className()));
+  result.insert("build", build);
+  result.insert("update", update);
+  result.insert("afterBuild", afterBuild);
+  result.insert("afterUpdate", afterUpdate);
+  result.insert("memory", memory);
+  result.insert("statistics", QJsonObject::fromVariantMap(index->statistics()));
+  result.insert("failures", QJsonArray::fromStringList(m_failures));
+  result.insert("passed", m_failures.isEmpty());
+
+  delete index;
+  clearElements();
+
+  return result;
+}
+
+/*!
+  \brief Returns the name of \a dataset used in the report.
+ */
+QString SpatialIndexTest::toString(Dataset dataset)
+{
+  switch (dataset)
+  {
+  case Dataset::Uniform:
+    return QStringLiteral("uniform");
+  case Dataset::Clustered:
+    return QStringLiteral("clustered");
+  case Dataset::Antimeridian:
+    return QStringLiteral("antimeridian");
+  }
+
+  return QString();
+}
+
+/*!
+  \brief Returns the name of \a geometryKind used in the report.
+ */
+QString SpatialIndexTest::toString(GeometryKind geometryKind)
+{
+  return geometryKind == GeometryKind::Points ? QStringLiteral("points") : QStringLiteral("polygons");
+}
+
+/*!
+  \brief Returns the name of \a indexKind used in the report.
+ */
+QString SpatialIndexTest::toString(IndexKind indexKind)
+{
+  switch (indexKind)
+  {
+  case IndexKind::Quadtree:
+    return QStringLiteral("GeometryQuadtree");
+  case IndexKind::PointGrid:
+    return QStringLiteral("PointGridIndex");
+  case IndexKind::Automatic:
+    return QStringLiteral("GeometryIndex::createIndex");
+  }
+
+  return QString();
+}
+
+/*!
+  \internal
+ */
+void SpatialIndexTest::createElements(Dataset dataset, GeometryKind geometryKind)
+{
+  m_clusterCentres.clear();
+  if (dataset == Dataset::Clustered)
+  {
+    for (int i = 0; i < c_clusterCount; ++i)
+      m_clusterCentres.append(qMakePair(uniform(-c_fullRevolution / 2, c_fullRevolution / 2), uniform(-c_maxLatitude, c_maxLatitude)));
+  }
+
+  m_elements.reserve(m_elementCount);
+  for (int i = 0; i < m_elementCount; ++i)
+  {
+    double x = 0.0;
+    double y = 0.0;
+    randomLocation(dataset, x, y);
+    appendElement(x, y, geometryKind);
+  }
+}
+
+/*!
+  \internal
+ */
+void SpatialIndexTest::clearElements()
+{
+  for (const Element& element : std::as_const(m_elements))
+    delete element.graphic;
+
+  m_elements.clear();
+  m_liveKeys.clear();
+}
+
+/*!
+  \internal
+
+  Creates a graphic centred on \a x, \a y and returns its position in the element list.
+ */
+int SpatialIndexTest::appendElement(double x, double y, GeometryKind geometryKind)
+{
+  Element element;
+  element.x = x;
+  element.y = y;
+  if (geometryKind == GeometryKind::Polygons)
+  {
+    element.width = uniform(c_minPolygonSize, c_maxPolygonSize);
+    element.height = uniform(c_minPolygonSize, c_maxPolygonSize);
+  }
+
+  const Geometry geometry = createGeometry(x, y, element.width, element.height, geometryKind);
+  element.graphic = new Graphic(geometry);
+  element.live = true;
+  setElementGeometry(element, geometry);
+
+  m_elements.append(element);
+  m_liveKeys.insert(element.key, static_cast<int>(m_elements.size() - 1));
+
+  return static_cast<int>(m_elements.size() - 1);
+}
+
+/*!
+  \internal
+
+  Moves \a element to be centred on \a x, \a y. The index is notified by the graphic.
+ */
+void SpatialIndexTest::moveElement(Element& element, double x, double y, GeometryKind geometryKind)
+{
+  const int position = m_liveKeys.take(element.key);
+
+  element.x = x;
+  element.y = y;
+
+  const Geometry geometry = createGeometry(x, y, element.width, element.height, geometryKind);
+  element.graphic->setGeometry(geometry);
+  setElementGeometry(element, geometry);
+
+  m_liveKeys.insert(element.key, position);
+}
+
+/*!
+  \internal
+ */
+GeometryIndex* SpatialIndexTest::createIndex(IndexKind indexKind) const
+{
+  QList<GeoElement*> geoElements;
+  geoElements.reserve(m_elements.size());
+  for (const Element& element : m_elements)
+    geoElements.append(element.graphic);
+
+  switch (indexKind)
+  {
+  case IndexKind::Quadtree:
+    return new GeometryQuadtree(Envelope(), geoElements, GeometryQuadtree::DefaultMaxLevels);
+  case IndexKind::PointGrid:
+    return new PointGridIndex(geoElements, PointGridIndex::DefaultCellSize);
+  case IndexKind::Automatic:
+    break;
+  }
+
+  return GeometryIndex::createIndex(Envelope(), geoElements);
+}
+
+/*!
+  \internal
+
+  Moves some of the elements, then removes others from the index and appends as many
+  new ones. Returns the timings of the changes made to \a index.
+ */
+QJsonObject SpatialIndexTest::updateElements(GeometryIndex* index, Dataset dataset, GeometryKind geometryKind)
+{
+  const int elementCount = static_cast<int>(m_elements.size());
+  const int moveCount = static_cast<int>(elementCount * c_moveFraction);
+  const int replaceCount = static_cast<int>(elementCount * c_replaceFraction);
+
+  QElapsedTimer timer;
+  qint64 moveTime = 0;
+  qint64 replaceTime = 0;
+
+  // moves are not normalized, so elements of the antimeridian dataset cross it in either direction
+  for (int i = 0; i < moveCount; ++i)
+  {
+    Element& element = m_elements[m_random.bounded(elementCount)];
+    if (!element.live)
+      continue;
+
+    const double x = element.x + uniform(-c_moveDistance, c_moveDistance);
+    const double y = std::clamp(element.y + uniform(-c_moveDistance, c_moveDistance), -c_maxLatitude, c_maxLatitude);
+
+    timer.start();
+    moveElement(element, x, y, geometryKind);
+    index->updateGeoElement(element.graphic);
+    moveTime += timer.nsecsElapsed();
+  }
+
+  for (int i = 0; i < replaceCount; ++i)
+  {
+    Element& element = m_elements[m_random.bounded(elementCount)];
+    if (!element.live)
+      continue;
+
+    timer.start();
+    index->removeGeoElement(element.graphic);
+    replaceTime += timer.nsecsElapsed();
+
+    element.live = false;
+    m_liveKeys.remove(element.key);
+
+    double x = 0.0;
+    double y = 0.0;
+    randomLocation(dataset, x, y);
+    const int position = appendElement(x, y, geometryKind);
+
+    timer.start();
+    index->appendGeoElement(m_elements.at(position).graphic);
+    replaceTime += timer.nsecsElapsed();
+  }
+
+  QJsonObject update;
+  update.insert("moved", moveCount);
+  update.insert("movesPerSecond", perSecond(moveCount, moveTime));
+  update.insert("replaced", replaceCount);
+  update.insert("replacementsPerSecond", perSecond(replaceCount, replaceTime));
+
+  return update;
+}
+
+/*!
+  \internal
+
+  Queries \a index with random extents and locations, compares the candidates with the
+  oracle and returns the throughput and the number of missed and stale candidates.
+ */
+QJsonObject SpatialIndexTest::checkQueries(const GeometryIndex* index, Dataset dataset)
+{
+  QList<Box> extentQueries;
+  extentQueries.reserve(m_queryCount + 2);
+
+  // a whole world query, and one which crosses the antimeridian
+  extentQueries.append(Box{-c_fullRevolution / 2, -90.0, c_fullRevolution / 2, 90.0});
+  extentQueries.append(Box{c_fullRevolution / 2 - 1.0, -c_maxLatitude, c_fullRevolution / 2 + 1.0, c_maxLatitude});
+
+  for (int i = 0; i < m_queryCount; ++i)
+  {
+    double x = 0.0;
+    double y = 0.0;
+    randomLocation(dataset, x, y);
+    const double width = uniform(c_minQuerySize, c_maxQuerySize);
+    const double height = uniform(c_minQuerySize, c_maxQuerySize);
+    extentQueries.append(Box{x - width / 2, y - height / 2, x + width / 2, y + height / 2});
+  }
+
+  // half of the locations lie on elements, in either representation near the antimeridian
+  QList<QPair<double, double>> locationQueries;
+  locationQueries.reserve(m_queryCount);
+  QList<int> liveElements;
+  for (qsizetype i = 0; i < m_elements.size(); ++i)
+  {
+    if (m_elements.at(i).live)
+      liveElements.append(static_cast<int>(i));
+  }
+
+  for (int i = 0; i < m_queryCount; ++i)
+  {
+    double x = 0.0;
+    double y = 0.0;
+    if (i % 2 == 0 && !liveElements.isEmpty())
+    {
+      const Element& element = m_elements.at(liveElements.at(m_random.bounded(static_cast<int>(liveElements.size()))));
+      x = element.x;
+      y = element.y;
+      if (dataset == Dataset::Antimeridian && m_random.bounded(2) == 0)
+        x += x > 0.0 ? -c_fullRevolution : c_fullRevolution;
+    }
+    else
+    {
+      randomLocation(dataset, x, y);
+    }
+
+    locationQueries.append(qMakePair(x, y));
+  }
+
+  qint64 candidateCount = 0;
+  qint64 matchCount = 0;
+  qint64 missedCount = 0;
+  qint64 staleCount = 0;
+
+  // checks the candidates returned for a query against every live element the oracle finds
+  auto compare = [this, &candidateCount, &matchCount, &missedCount, &staleCount](const QList<Geometry>& candidates,
+                                                                                   const Box& query,
+                                                                                   const QString& description)
+  {
+    QSet<QString> candidateKeys;
+    for (const Geometry& candidate : candidates)
+    {
+      const QString key = geometryKey(candidate);
+      candidateKeys.insert(key);
+      if (!m_liveKeys.contains(key))
+      {
+        ++staleCount;
+        addFailure(QString("%1 returned a geometry which is not in the index: %2").arg(description, key));
+      }
+    }
+
+    candidateCount += candidates.size();
+
+    for (const Element& element : std::as_const(m_elements))
+    {
+      if (!element.live || !wrappedIntersects(element.box, query))
+        continue;
+
+      ++matchCount;
+      if (!candidateKeys.contains(element.key))
+      {
+        ++missedCount;
+        addFailure(QString("%1 missed %2").arg(description, element.key));
+      }
+    }
+  };
+
+  QElapsedTimer timer;
+  qint64 extentTime = 0;
+  for (const Box& query : std::as_const(extentQueries))
+  {
+    const Envelope extent(query.xMin, query.yMin, query.xMax, query.yMax, SpatialReference::wgs84());
+
+    timer.start();
+    const QList<Geometry> candidates = index->candidateIntersections(extent);
+    extentTime += timer.nsecsElapsed();
+
+    compare(candidates, query, QString("Extent %1 %2 %3 %4").arg(query.xMin).arg(query.yMin).arg(query.xMax).arg(query.yMax));
+  }
+
+  qint64 locationTime = 0;
+  for (const auto& query : std::as_const(locationQueries))
+  {
+    const Point location(query.first, query.second, SpatialReference::wgs84());
+
+    timer.start();
+    const QList<Geometry> candidates = index->candidateIntersections(location);
+    locationTime += timer.nsecsElapsed();
+
+    compare(candidates, Box{query.first, query.second, query.first, query.second},
+            QString("Location %1 %2").arg(query.first).arg(query.second));
+  }
+
+  const qint64 queryCount = extentQueries.size() + locationQueries.size();
+
+  QJsonObject result;
+  result.insert("extentQueriesPerSecond", perSecond(extentQueries.size(), extentTime));
+  result.insert("locationQueriesPerSecond", perSecond(locationQueries.size(), locationTime));
+  result.insert("averageCandidates", static_cast<double>(candidateCount) / queryCount);
+  result.insert("averageMatches", static_cast<double>(matchCount) / queryCount);
+  result.insert("missed", missedCount);
+  result.insert("stale", staleCount);
+
+  return result;
+}
+
+/*!
+  \internal
+ */
+void SpatialIndexTest::addFailure(const QString& description)
+{
+  if (m_failures.size() < c_maxReportedFailures)
+    m_failures.append(description);
+}
+
+/*!
+  \internal
+
+  Sets \a x and \a y to a random location in \a dataset.
+ */
+void SpatialIndexTest::randomLocation(Dataset dataset, double& x, double& y)
+{
+  switch (dataset)
+  {
+  case Dataset::Uniform:
+    x = uniform(-c_fullRevolution / 2, c_fullRevolution / 2);
+    y = uniform(-c_maxLatitude, c_maxLatitude);
+    break;
+  case Dataset::Clustered:
+  {
+    // uniformly within a small square around one of the cluster centres
+    const auto& centre = m_clusterCentres.at(m_random.bounded(static_cast<int>(m_clusterCentres.size())));
+    x = centre.first + uniform(-c_clusterHalfSize, c_clusterHalfSize);
+    y = std::clamp(centre.second + uniform(-c_clusterHalfSize, c_clusterHalfSize), -c_maxLatitude, c_maxLatitude);
+    break;
+  }
+  case Dataset::Antimeridian:
+    // half of the locations east of 180 are given as negative longitudes
+    x = uniform(c_fullRevolution / 2 - c_antimeridianSpan, c_fullRevolution / 2 + c_antimeridianSpan);
+    if (x > c_fullRevolution / 2 && m_random.bounded(2) == 0)
+      x -= c_fullRevolution;
+    y = uniform(-c_antimeridianLatitude, c_antimeridianLatitude);
+    break;
+  }
+}
+
+/*!
+  \internal
+ */
+double SpatialIndexTest::uniform(double min, double max)
+{
+  return min + (max - min) * m_random.generateDouble();
+}
+
+/*!
+  \internal
+
+  Returns a point at \a x, \a y, or a rectangular polygon of \a width and \a height centred on it.
+ */
+Geometry SpatialIndexTest::createGeometry(double x, double y, double width, double height, GeometryKind geometryKind) const
+{
+  if (geometryKind == GeometryKind::Points)
+    return Point(x, y, SpatialReference::wgs84());
+
+  PolygonBuilder builder(SpatialReference::wgs84());
+  builder.addPoint(x - width / 2, y - height / 2);
+  builder.addPoint(x - width / 2, y + height / 2);
+  builder.addPoint(x + width / 2, y + height / 2);
+  builder.addPoint(x + width / 2, y - height / 2);
+
+  return builder.toGeometry();
+}
+
+/*!
+  \internal
+
+  Records the extent of \a geometry, as the index sees it, for the oracle.
+ */
+void SpatialIndexTest::setElementGeometry(Element& element, const Geometry& geometry)
+{
+  const Envelope extent = geometry.extent();
+  element.box = Box{extent.xMin(), extent.yMin(), extent.xMax(), extent.yMax()};
+  element.key = geometryKey(geometry);
+}
+
+/*!
+  \internal
+
+  Edges are inclusive, as they are in the indexes.
+ */
+bool SpatialIndexTest::intersects(const Box& box, const Box& query)
+{
+  return box.xMin <= query.xMax && box.xMax >= query.xMin &&
+         box.yMin <= query.yMax && box.yMax >= query.yMin;
+}
+
+/*!
+  \internal
+
+  Returns whether \a box intersects \a query, or a copy of it shifted one revolution east or west.
+ */
+bool SpatialIndexTest::wrappedIntersects(const Box& box, const Box& query)
+{
+  if (box.yMin > query.yMax || box.yMax < query.yMin)
+    return false;
+
+  // a query spanning a full revolution covers every longitude
+  if (query.xMax - query.xMin >= c_fullRevolution)
+    return true;
+
+  for (const double shift : {0.0, -c_fullRevolution, c_fullRevolution})
+  {
+    if (intersects(box, Box{query.xMin + shift, query.yMin, query.xMax + shift, query.yMax}))
+      return true;
+  }
+
+  return false;
+}
+
+/*!
+  \internal
+
+  Identifies an element by the exact extent of its geometry, which is unique in the random datasets.
+ */
+QString SpatialIndexTest::geometryKey(const Geometry& geometry)
+{
+  const Envelope extent = geometry.extent();
+  return QString("%1 %2 %3 %4").arg(extent.xMin(), 0, 'g', 17)
+                               .arg(extent.yMin(), 0, 'g', 17)
+                               .arg(extent.xMax(), 0, 'g', 17)
+                               .arg(extent.yMax(), 0, 'g', 17);
+}
+
+/*!
+  \internal
+
+  Returns the resident set size of the process in bytes, or \c -1 if it is not known.
+ */
+qint64 SpatialIndexTest::residentMemory()
+{
+#if defined(Q_OS_LINUX)
+  QFile statm(QStringLiteral("/proc/self/statm"));
+  if (!statm.open(QIODevice::ReadOnly))
+    return -1;
+
+  const QList<QByteArray> fields = statm.readAll().split(' ');
+  return fields.size() > 1 ? fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE) : -1;
+#elif defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return -1;
+
+  return static_cast<qint64>(counters.WorkingSetSize);
+#elif defined(Q_OS_MACOS)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    return -1;
+
+  return static_cast<qint64>(info.resident_size);
+#else
+  return -1;
+#endif
+}
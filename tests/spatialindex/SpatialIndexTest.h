@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef SPATIALINDEXTEST_H
+#define SPATIALINDEXTEST_H
+
+// Qt headers
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QRandomGenerator>
+#include <QString>
+#include <QStringList>
+
+namespace Esri::ArcGISRuntime {
+  class GeoElement;
+  class Geometry;
+  class Graphic;
+}
+
+namespace Dsa {
+class GeometryIndex;
+}
+
+class SpatialIndexTest
+{
+public:
+  enum class Dataset
+  {
+    Uniform,
+    Clustered,
+    Antimeridian
+  };
+
+  enum class GeometryKind
+  {
+    Points,
+    Polygons
+  };
+
+  enum class IndexKind
+  {
+    Quadtree,
+    PointGrid,
+    Automatic
+  };
+
+  SpatialIndexTest(int elementCount, int queryCount, quint32 seed);
+  ~SpatialIndexTest();
+
+  QJsonObject runAll();
+  QJsonObject run(Dataset dataset, GeometryKind geometryKind, IndexKind indexKind);
+
+  static QString toString(Dataset dataset);
+  static QString toString(GeometryKind geometryKind);
+  static QString toString(IndexKind indexKind);
+
+private:
+  struct Box
+  {
+    double xMin = 0.0;
+    double yMin = 0.0;
+    double xMax = 0.0;
+    double yMax = 0.0;
+  };
+
+  struct Element
+  {
+    Esri::ArcGISRuntime::Graphic* graphic = nullptr;
+    double x = 0.0;
+    double y = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+    Box box;
+    QString key;
+    bool live = false;
+  };
+
+  void createElements(Dataset dataset, GeometryKind geometryKind);
+  void clearElements();
+  int appendElement(double x, double y, GeometryKind geometryKind);
+  void moveElement(Element& element, double x, double y, GeometryKind geometryKind);
+  Dsa::GeometryIndex* createIndex(IndexKind indexKind) const;
+  QJsonObject updateElements(Dsa::GeometryIndex* index, Dataset dataset, GeometryKind geometryKind);
+  QJsonObject checkQueries(const Dsa::GeometryIndex* index, Dataset dataset);
+
+  void addFailure(const QString& description);
+  void randomLocation(Dataset dataset, double& x, double& y);
+  double uniform(double min, double max);
+  Esri::ArcGISRuntime::Geometry createGeometry(double x, double y, double width, double height, GeometryKind geometryKind) const;
+  void setElementGeometry(Element& element, const Esri::ArcGISRuntime::Geometry& geometry);
+
+  static bool intersects(const Box& box, const Box& query);
+  static bool wrappedIntersects(const Box& box, const Box& query);
+  static QString geometryKey(const Esri::ArcGISRuntime::Geometry& geometry);
+  static qint64 residentMemory();
+
+  int m_elementCount = 0;
+  int m_queryCount = 0;
+  quint32 m_seed = 0;
+  QRandomGenerator m_random;
+  QList<Element> m_elements;
+  QHash<QString, int> m_liveKeys;
+  QList<QPair<double, double>> m_clusterCentres;
+  QStringList m_failures;
+};
+
+#endif // SPATIALINDEXTEST_H
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *  Copyright 2012-2025 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include "SpatialIndexTest.h"
+
+void printHelp()
+{
+  QTextStream out(stdout);
+  out << "Checks the spatial indexes against a brute-force oracle and measures them." << Qt::endl;
+  out << "Available command line parameters:" << Qt::endl;
+  out << "  -h                     Print help and exit" << Qt::endl;
+  out << "  -n <elements>          Number of elements in each dataset; default is 20000" << Qt::endl;
+  out << "  -q <queries>           Number of extent and of location queries in each" << Qt::endl <<
+         "                         round; default is 500" << Qt::endl;
+  out << "  -S <seed>              Random seed; default is 1" << Qt::endl;
+  out << "  -o <filename>          Also write the JSON report to this file" << Qt::endl;
+  out << "The JSON report of build, update and query throughput, memory and oracle" << Qt::endl <<
+         "mismatches is printed to stdout. The exit code is 0 only if every case passed." << Qt::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  int elementCount = 20000;
+  int queryCount = 500;
+  quint32 seed = 1;
+  QString reportFile;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "-h"))
+    {
+      printHelp();
+      return 0;
+    }
+    else if (!strcmp(argv[i], "-n"))
+    {
+      if ((i + 1) < argc)
+      {
+        elementCount = atoi(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-q"))
+    {
+      if ((i + 1) < argc)
+      {
+        queryCount = atoi(argv[++i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-S"))
+    {
+      if ((i + 1) < argc)
+      {
+        seed = static_cast<quint32>(strtoul(argv[++i], nullptr, 10));
+      }
+    }
+    else if (!strcmp(argv[i], "-o"))
+    {
+      if ((i + 1) < argc)
+      {
+        reportFile = QString(argv[++i]);
+      }
+    }
+  }
+
+  if (elementCount <= 0 || queryCount <= 0)
+  {
+    printHelp();
+    return 2;
+  }
+
+  SpatialIndexTest test(elementCount, queryCount, seed);
+  const QJsonObject report = test.runAll();
+  const QByteArray json = QJsonDocument(report).toJson();
+
+  QTextStream out(stdout);
+  out << json;
+  out.flush();
+
+  if (!reportFile.isEmpty())
+  {
+    QFile file(reportFile);
+    if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size())
+      QTextStream(stderr) << "Could not write report to: " << reportFile << "\n";
+  }
+
+  return report.value("passed").toBool() ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+################################################################################
+#  Copyright 2012-2025 Esri
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+################################################################################
+
+
+TARGET = DSA_SpatialIndexTest
+TEMPLATE = app
+
+QT += core gui positioning qml quick
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+ARCGIS_RUNTIME_VERSION = 200.6.0
+DEFINES += ARCGIS_MAPS_SDK_VERSION=$$ARCGIS_RUNTIME_VERSION
+include($$PWD/../../Shared/build/arcgisruntime.pri)
+
+INCLUDEPATH += $$PWD/../../Shared/ \
+    $$PWD/../../Shared/alerts \
+    $$PWD/../../Shared/utilities
+
+HEADERS += \
+    $$PWD/../../Shared/GeometryIndex.h \
+    $$PWD/../../Shared/GeometryQuadtree.h \
+    $$PWD/../../Shared/PointGridIndex.h \
+    $$PWD/../../Shared/utilities/GeoElementUtils.h \
+    SpatialIndexTest.h
+
+SOURCES += main.cpp \
+    $$PWD/../../Shared/GeometryIndex.cpp \
+    $$PWD/../../Shared/GeometryQuadtree.cpp \
+    $$PWD/../../Shared/PointGridIndex.cpp \
+    $$PWD/../../Shared/utilities/GeoElementUtils.cpp \
+    SpatialIndexTest.cpp
+
+win32 {
+    LIBS += -lpsapi
+}